@@ -0,0 +1,175 @@
+/**
+ * @file bench_anillo.cpp
+ * @brief Ingesta desde otro proceso: tuberia frente a AnilloCompartido
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Un proceso hijo hace de demonio de captura y escribe la misma captura
+ * generada en una tuberia o en un anillo compartido; el padre la decodifica
+ * con EnsambladorLineas + DecodificadorPRT7 (tuberia) o con
+ * ejecutarAnillo(). Se informan el tiempo real y el tiempo de sistema de
+ * ambos procesos, y el texto debe ser identico en las dos pasadas.
+ *
+ * Una tercera pasada deja que el productor escriba menos que la capacidad
+ * del anillo y termine antes de que el consumidor se conecte: el consumidor
+ * debe encontrar los datos y terminar. Al final de cada pasada el nombre
+ * del segmento ya no debe existir.
+ *
+ * Uso: prt7_bench_anillo [tramas]
+ */
+
+#include "AnilloCompartido.h"
+#include "DecodificadorPRT7.h"
+#include "EnsambladorLineas.h"
+#include "TramaBase.h"
+#include "comun.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const char* NOMBRE_ANILLO = "/prt7_bench_anillo";
+static const int BLOQUE = 1 << 16;
+
+/* Lineas como las de una captura: cargas, rotaciones y algun fin de mensaje */
+static std::vector<char> generarCaptura(long long tramas) {
+    std::vector<char> datos;
+    datos.reserve((size_t)tramas * 5);
+    char linea[32];
+    for (long long t = 0; t < tramas; t++) {
+        unsigned int tipo = aleatorio(100);
+        int n;
+        if (tipo < 80) {
+            n = std::snprintf(linea, sizeof(linea), "L,%c\n", 'A' + aleatorio(26));
+        } else if (tipo < 98) {
+            n = std::snprintf(linea, sizeof(linea), "M,%d\n", (int)aleatorio(11) - 5);
+        } else {
+            n = std::snprintf(linea, sizeof(linea), "F,\n");
+        }
+        datos.insert(datos.end(), linea, linea + n);
+    }
+    return datos;
+}
+
+/* Segundos de sistema del proceso y de los hijos ya esperados */
+static double segundosSistema() {
+    rusage propio;
+    rusage hijos;
+    getrusage(RUSAGE_SELF, &propio);
+    getrusage(RUSAGE_CHILDREN, &hijos);
+    return (double)(propio.ru_stime.tv_sec + hijos.ru_stime.tv_sec) +
+           (double)(propio.ru_stime.tv_usec + hijos.ru_stime.tv_usec) * 1e-6;
+}
+
+/* El segmento ya no tiene nombre */
+static bool segmentoEliminado() {
+    int fd = shm_open(NOMBRE_ANILLO, O_RDWR, 0);
+    if (fd < 0) return true;
+    close(fd);
+    return false;
+}
+
+/* Hijo: escribe la captura en el anillo y cierra, como --anillo-productor */
+static void producirEnAnillo(const std::vector<char>& captura) {
+    AnilloCompartido anillo;
+    if (!anillo.abrir(NOMBRE_ANILLO, 1 << 20)) _exit(2);
+    for (size_t i = 0; i < captura.size(); i += BLOQUE) {
+        size_t n = captura.size() - i;
+        if (n > (size_t)BLOQUE) n = BLOQUE;
+        anillo.escribir(captura.data() + i, (int)n);
+    }
+    anillo.cerrarEscritura();
+    _exit(0);
+}
+
+/**
+ * @brief Decodifica la captura que escribe un proceso hijo
+ * @param anillo true para usar AnilloCompartido, false para una tuberia
+ * @param productorPrimero Esperar a que el hijo termine antes de conectarse (solo anillo)
+ */
+static bool pasada(const char* nombre, const std::vector<char>& captura, bool anillo, bool productorPrimero,
+                   unsigned long long& huella) {
+    SalidaHuella salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 4096, 4096);
+
+    double sistema = segundosSistema();
+    double inicio = segundos();
+    int tuberia[2] = { -1, -1 };
+    if (!anillo && pipe(tuberia) != 0) {
+        std::perror("pipe");
+        return false;
+    }
+    pid_t hijo = fork();
+    if (hijo < 0) {
+        std::perror("fork");
+        return false;
+    }
+    if (hijo == 0) {
+        if (anillo) producirEnAnillo(captura);
+        close(tuberia[0]);
+        for (size_t i = 0; i < captura.size();) {
+            ssize_t n = write(tuberia[1], captura.data() + i, captura.size() - i);
+            if (n <= 0) _exit(2);
+            i += (size_t)n;
+        }
+        _exit(0);
+    }
+
+    int estado = 0;
+    if (anillo) {
+        if (productorPrimero) waitpid(hijo, &estado, 0);
+        decodificador.ejecutarAnillo(NOMBRE_ANILLO);
+    } else {
+        close(tuberia[1]);
+        EnsambladorLineas ensamblador;
+        std::vector<char> bloque(BLOQUE);
+        ssize_t n;
+        while ((n = read(tuberia[0], bloque.data(), bloque.size())) > 0) {
+            ensamblador.alimentar(bloque.data(), (int)n, &decodificador);
+        }
+        ensamblador.terminar(&decodificador);
+        close(tuberia[0]);
+    }
+    decodificador.finalizar();
+    if (!productorPrimero) waitpid(hijo, &estado, 0);
+    double tiempo = segundos() - inicio;
+    sistema = segundosSistema() - sistema;
+
+    bool eliminado = !anillo || segmentoEliminado();
+    bool correcto = WIFEXITED(estado) && WEXITSTATUS(estado) == 0 && eliminado &&
+                    (huella == 0 || salida.hash == huella);
+    if (huella == 0) huella = salida.hash;
+    std::printf("%-28s %7.3f s  (%6.3f s de sistema)  %9lld caracteres %7lld mensajes%s%s\n", nombre, tiempo,
+                sistema, salida.caracteres, salida.mensajes, eliminado ? "" : "  SEGMENTO SIN ELIMINAR",
+                correcto ? "" : "  ERROR");
+    return correcto;
+}
+
+int main(int argc, char* argv[]) {
+    long long tramas = (argc > 1) ? std::atoll(argv[1]) : 20000000;
+    TramaBase::setVerboso(false);
+    // Un consumidor que espera para siempre es el error que se busca: no colgar el bench
+    alarm(300);
+
+    AnilloCompartido::eliminar(NOMBRE_ANILLO);
+    std::vector<char> captura = generarCaptura(tramas);
+    std::printf("%lld tramas, %.1f MB\n", tramas, captura.size() / 1e6);
+
+    unsigned long long huella = 0;
+    bool correcto = pasada("tuberia", captura, false, false, huella);
+    correcto = pasada("anillo", captura, true, false, huella) && correcto;
+
+    // Menos que la capacidad del anillo: el productor puede terminar solo
+    std::vector<char> corta(captura.begin(), captura.begin() + (captura.size() < 100000 ? captura.size() : 100000));
+    unsigned long long huellaCorta = 0;
+    correcto = pasada("tuberia, captura corta", corta, false, false, huellaCorta) && correcto;
+    correcto = pasada("anillo, productor termina", corta, true, true, huellaCorta) && correcto;
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file bench_api.c
+ * @brief Mide el costo por llamada de la API en C de libprt7
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Se compila como C puro contra la biblioteca compartida, asi que tambien
+ * comprueba que prt7.h se puede usar sin C++.
+ *
+ * Uso: prt7_bench_api [iteraciones]
+ */
+
+#include "prt7.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static long long caracteres = 0;
+
+/* Salida que solo cuenta: mide la biblioteca, no la consola */
+static void contar(void* contexto, const char* datos, int longitud, int fin_mensaje) {
+    (void)contexto;
+    (void)datos;
+    if (!fin_mensaje) caracteres += longitud;
+}
+
+static double segundos(void) {
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static void reportar(const char* nombre, long long llamadas, double inicio) {
+    double total = segundos() - inicio;
+    printf("%-34s %12lld llamadas  %8.1f ns/llamada\n", nombre, llamadas, total * 1e9 / (double)llamadas);
+}
+
+int main(int argc, char* argv[]) {
+    long long n = (argc > 1) ? atoll(argv[1]) : 2000000;
+    prt7_decodificador* d = prt7_crear();
+    volatile char sumidero = 0;
+    double inicio;
+    long long i;
+
+    if (d == NULL) {
+        fprintf(stderr, "No se pudo crear el decodificador\n");
+        return 1;
+    }
+    prt7_configurar_salida(d, contar, NULL);
+    printf("libprt7 %s\n", prt7_version());
+
+    /* Una trama ya separada por llamada */
+    inicio = segundos();
+    for (i = 0; i < n; i++) {
+        if (i % 8 == 7) {
+            prt7_procesar_trama(d, "M,1", 3);
+        } else {
+            prt7_procesar_trama(d, "L,A", 3);
+        }
+    }
+    reportar("prt7_procesar_trama", n, inicio);
+
+    /* Bytes crudos, una linea por llamada */
+    prt7_reiniciar(d);
+    inicio = segundos();
+    for (i = 0; i < n; i++) {
+        prt7_alimentar(d, "L,B\n", 4);
+    }
+    reportar("prt7_alimentar (1 trama)", n, inicio);
+
+    /* Bytes crudos en bloques grandes: costo amortizado por trama */
+    {
+        const int tramasPorBloque = 16384;
+        char* bloque = (char*)malloc((size_t)tramasPorBloque * 4);
+        long long bloques = n / tramasPorBloque + 1;
+        for (i = 0; i < tramasPorBloque; i++) {
+            memcpy(bloque + i * 4, (i % 8 == 7) ? "M,3\n" : "L,C\n", 4);
+        }
+        prt7_reiniciar(d);
+        inicio = segundos();
+        for (i = 0; i < bloques; i++) {
+            prt7_alimentar(d, bloque, tramasPorBloque * 4);
+        }
+        reportar("prt7_alimentar (por trama, 64 KiB)", bloques * tramasPorBloque, inicio);
+        free(bloque);
+    }
+
+    /* Consulta pura del rotor */
+    inicio = segundos();
+    for (i = 0; i < n; i++) {
+        sumidero = (char)(sumidero + prt7_decodificar_caracter(d, (char)('A' + i % 26)));
+    }
+    reportar("prt7_decodificar_caracter", n, inicio);
+
+    prt7_cerrar(d);
+    prt7_destruir(d);
+    printf("caracteres entregados: %lld\n", caracteres);
+    return 0;
+}
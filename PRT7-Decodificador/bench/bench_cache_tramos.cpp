@@ -0,0 +1,167 @@
+/**
+ * @file bench_cache_tramos.cpp
+ * @brief Repeticion de una captura con y sin CacheTramos: tiempo, aciertos y texto identico
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Genera una captura de trafico mixto (cargas, lotes, rotaciones, fines
+ * de mensaje, marcas y ruido) y la decodifica con ejecutarArchivo:
+ * sin cache, con la cache vacia, con la cache llena, con otra
+ * configuracion de salida (delimitador), con una linea cambiada a mitad
+ * de la captura y con un limite menor que la cache completa. En cada
+ * pasada el texto y los cierres de mensaje deben coincidir con los de la
+ * pasada sin cache. Ademas, una segunda apertura de la cache mientras la
+ * primera sigue abierta debe fallar con getOcupada().
+ *
+ * Uso: prt7_bench_cache_tramos [lineas]
+ * Termina con codigo 1 si alguna pasada produce otro texto o si el
+ * bloqueo no se respeta.
+ */
+
+#include "CacheTramos.h"
+#include "DecodificadorPRT7.h"
+#include "SalidaCarga.h"
+#include "TramaBase.h"
+#include "TramaLoad.h"
+#include "comun.h"
+#include <cstdio>
+#include <cstdlib>
+
+static const char* RUTA_CAPTURA = "prt7_bench_cache.txt";
+static const char* RUTA_EDITADA = "prt7_bench_cache_editada.txt";
+static const char* RUTA_CACHE = "prt7_bench_cache.cache";
+
+/* Lineas como las de una captura de varios minutos */
+static void escribirCaptura(std::FILE* f, long long lineas) {
+    for (long long l = 0; l < lineas; l++) {
+        unsigned int tipo = aleatorio(1000);
+        if (tipo < 700) {
+            std::fprintf(f, "L,%c\n", 'A' + aleatorio(26));
+        } else if (tipo < 800) {
+            std::fprintf(f, "M,%d\n", (int)aleatorio(11) - 5);
+        } else if (tipo < 830) {
+            int largo = 1 + (int)aleatorio(40);
+            std::fprintf(f, "L*%d,", largo);
+            for (int i = 0; i < largo; i++) std::fputc('A' + aleatorio(26), f);
+            std::fputc('\n', f);
+        } else if (tipo < 835) {
+            std::fprintf(f, "F,\n");
+        } else if (tipo < 900) {
+            std::fprintf(f, "@%lld L,%c\n", 1000 + l, 'A' + aleatorio(26));
+        } else {
+            int largo = (int)aleatorio(30);
+            for (int i = 0; i < largo; i++) std::fputc('a' + aleatorio(26), f);
+            std::fputc('\n', f);
+        }
+    }
+}
+
+/**
+ * @brief Decodifica una captura, con cache si se indica
+ * @param delimitador Delimitador de mensajes ('\0' = ninguno)
+ * @param limite Bytes de la cache, o 0 para no usarla
+ */
+static double pasada(const char* nombre, const char* captura, char delimitador, long long limite,
+                     unsigned long long referencia, bool& igual, unsigned long long* huella = nullptr) {
+    SalidaHuella salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 4096, 4096);
+    decodificador.configurarSegmentacion(delimitador, 0);
+    CacheTramos cache;
+    if (limite > 0) {
+        if (!cache.abrir(RUTA_CACHE, limite)) {
+            std::fprintf(stderr, "No se pudo abrir %s\n", RUTA_CACHE);
+            std::exit(2);
+        }
+        decodificador.configurarCache(&cache);
+    }
+
+    double inicio = segundos();
+    decodificador.ejecutarArchivo(captura, false);
+    decodificador.finalizar();
+    double tiempo = segundos() - inicio;
+    cache.cerrar();
+
+    if (huella != nullptr) *huella = salida.hash;
+    bool coincide = (referencia == 0 || salida.hash == referencia);
+    if (!coincide) igual = false;
+    std::printf("%-22s %6.3f s  %9lld caracteres %6lld mensajes", nombre, tiempo, salida.caracteres,
+                salida.mensajes);
+    if (limite > 0) {
+        long long consultas = cache.getConsultas();
+        std::printf("  aciertos %4lld/%-4lld (%5.1f%% de los bytes)  +%lld -%lld  cache %lld bytes",
+                    cache.getAciertos(), consultas,
+                    cache.getBytesConsultados() > 0 ? 100.0 * cache.getBytesAcertados() / cache.getBytesConsultados() : 0.0,
+                    cache.getAgregadas(), cache.getEliminadas(), cache.getTamanioArchivo());
+    }
+    std::printf("%s\n", coincide ? "" : "  TEXTO DISTINTO");
+    return tiempo;
+}
+
+int main(int argc, char* argv[]) {
+    long long lineas = (argc > 1) ? std::atoll(argv[1]) : 5000000;
+    TramaBase::setVerboso(false);
+
+    std::FILE* f = std::fopen(RUTA_CAPTURA, "wb");
+    std::FILE* g = std::fopen(RUTA_EDITADA, "wb");
+    if (f == nullptr || g == nullptr) {
+        std::perror("fopen");
+        return 2;
+    }
+    unsigned long long semilla = estadoAleatorio;
+    escribirCaptura(f, lineas);
+    // La copia editada cambia una carga por una rotacion a mitad de la captura
+    estadoAleatorio = semilla;
+    escribirCaptura(g, lineas / 2);
+    std::fprintf(g, "M,7\n");
+    escribirCaptura(g, lineas - lineas / 2 - 1);
+    std::fclose(f);
+    std::fclose(g);
+    std::remove(RUTA_CACHE);
+
+    bool igual = true;
+    unsigned long long referencia = 0;
+    unsigned long long referenciaDelimitada = 0;
+    unsigned long long referenciaEditada = 0;
+    std::printf("%lld lineas\n", lineas);
+    double sin = pasada("sin cache", RUTA_CAPTURA, '\0', 0, 0, igual, &referencia);
+    pasada("sin cache, delimitador", RUTA_CAPTURA, 'Q', 0, 0, igual, &referenciaDelimitada);
+    pasada("sin cache, editada", RUTA_EDITADA, '\0', 0, 0, igual, &referenciaEditada);
+    double fria = pasada("cache vacia", RUTA_CAPTURA, '\0', CacheTramos::LIMITE_DEFECTO, referencia, igual);
+    double caliente = pasada("cache llena", RUTA_CAPTURA, '\0', CacheTramos::LIMITE_DEFECTO, referencia, igual);
+    pasada("cache, delimitador", RUTA_CAPTURA, 'Q', CacheTramos::LIMITE_DEFECTO, referenciaDelimitada, igual);
+    pasada("cache, editada", RUTA_EDITADA, '\0', CacheTramos::LIMITE_DEFECTO, referenciaEditada, igual);
+
+    // Limite de un tercio: la pasada desaloja y la siguiente solo acierta en lo que quedo
+    std::FILE* c = std::fopen(RUTA_CACHE, "rb");
+    long long tamanio = 0;
+    if (c != nullptr) {
+        std::fseek(c, 0, SEEK_END);
+        tamanio = std::ftell(c);
+        std::fclose(c);
+    }
+    pasada("limite 1/3", RUTA_CAPTURA, '\0', tamanio / 3, referencia, igual);
+    pasada("limite 1/3, repetida", RUTA_CAPTURA, '\0', tamanio / 3, referencia, igual);
+
+    // Una segunda apertura de la misma cache se rechaza sin tocar el archivo
+    CacheTramos primera;
+    CacheTramos segunda;
+    bool rechazada = primera.abrir(RUTA_CACHE, tamanio) && !segunda.abrir(RUTA_CACHE, tamanio) &&
+                     segunda.getOcupada();
+    primera.cerrar();
+    bool liberada = segunda.abrir(RUTA_CACHE, tamanio) && !segunda.getOcupada();
+    segunda.cerrar();
+    std::printf("segunda apertura simultanea %s; despues de cerrar la primera %s\n",
+                rechazada ? "rechazada" : "ACEPTADA", liberada ? "aceptada" : "RECHAZADA");
+    if (!rechazada || !liberada) igual = false;
+    pasada("tras el bloqueo", RUTA_CAPTURA, '\0', tamanio / 3, referencia, igual);
+
+    std::printf("cache vacia %+.1f%%, cache llena %.2fx mas rapida que sin cache\n", (fria / sin - 1) * 100,
+                sin / caliente);
+    std::remove(RUTA_CAPTURA);
+    std::remove(RUTA_EDITADA);
+    std::remove(RUTA_CACHE);
+    std::remove("prt7_bench_cache.cache.tmp");
+    return igual ? 0 : 1;
+}
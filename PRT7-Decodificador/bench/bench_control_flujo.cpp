@@ -0,0 +1,213 @@
+/**
+ * @file bench_control_flujo.cpp
+ * @brief Demuestra sobre un pseudoterminal que XON/XOFF evita perder bytes con un consumidor lento
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Un hilo emisor escribe tramas en el lado maestro de un pty a ritmo
+ * fijo, como un UART: no espera al receptor, y lo que no puede escribir
+ * se pierde. Solo se detiene si recibe XOFF (y mientras no llegue XON).
+ * El receptor abre el lado esclavo con SerialPort y decodifica con un
+ * consumidor deliberadamente lento. Se ejecuta sin control de flujo y con
+ * XON/XOFF y se comparan las tramas recibidas con las enviadas.
+ *
+ * RTS/CTS no se puede probar aqui: un pty no tiene lineas de modem.
+ *
+ * Uso: prt7_bench_control_flujo [tramas] [bytes_por_segundo]
+ * Termina con codigo 1 si con XON/XOFF se pierde alguna trama.
+ */
+
+#include "SerialPort.h"
+#include "EnsambladorLineas.h"
+#include "DecodificadorPRT7.h"
+#include "SalidaCarga.h"
+#include "TramaBase.h"
+#include "comun.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @brief Consumidor lento: duerme cada cierto numero de lineas y reconoce el fin
+ */
+struct ReceptorLento : public ReceptorLineas {
+    DecodificadorPRT7* decodificador = nullptr;
+    long long lineas = 0;
+    int lineasPorPausa = 100;
+    int pausaUs = 1000;
+    bool fin = false;
+
+    void lineaCompleta(const char* linea, int longitud) override {
+        if (longitud == 3 && std::memcmp(linea, "FIN", 3) == 0) {
+            fin = true;
+            return;
+        }
+        decodificador->lineaCompleta(linea, longitud);
+        if (++lineas % lineasPorPausa == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(pausaUs));
+        }
+    }
+};
+
+/**
+ * @brief Lado emisor: escribe a ritmo fijo y respeta XOFF/XON del receptor
+ */
+struct Emisor {
+    int maestro = -1;
+    const char* datos = nullptr;
+    long long longitud = 0;
+    double bytesPorSegundo = 0;
+    long long perdidos = 0;      ///< Bytes que el pty no acepto
+    long long xoffs = 0;         ///< XOFF recibidos
+    std::atomic<bool> terminado{false};
+
+    void ejecutar() {
+        bool pausado = false;
+        long long enviados = 0;
+        double inicio = segundos();
+        double pausadoDesde = 0;
+        double tiempoPausado = 0;
+        while (enviados < longitud) {
+            // Caracteres de control que el receptor envio
+            char control[64];
+            ssize_t n = ::read(maestro, control, sizeof(control));
+            for (ssize_t i = 0; i < n; i++) {
+                if (control[i] == 0x13 && !pausado) { pausado = true; xoffs++; pausadoDesde = segundos(); }
+                if (control[i] == 0x11 && pausado) { pausado = false; tiempoPausado += segundos() - pausadoDesde; }
+            }
+            if (pausado) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+            }
+
+            // Ritmo de la linea: lo que ya deberia haber salido desde el inicio
+            long long permitidos = (long long)((segundos() - inicio - tiempoPausado) * bytesPorSegundo);
+            long long bloque = permitidos - enviados;
+            if (bloque > 256) bloque = 256;
+            if (bloque > longitud - enviados) bloque = longitud - enviados;
+            if (bloque <= 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                continue;
+            }
+            ssize_t escritos = ::write(maestro, datos + enviados, (size_t)bloque);
+            if (escritos < 0) escritos = 0;
+            // Un UART no espera: lo que no entro en el pty se pierde
+            perdidos += bloque - escritos;
+            enviados += bloque;
+        }
+        const char finLinea[] = "FIN\n";
+        ::write(maestro, finLinea, sizeof(finLinea) - 1);
+        terminado = true;
+    }
+};
+
+/**
+ * @brief Ejecuta una pasada completa con el control de flujo indicado
+ * @return Tramas validas recibidas
+ */
+static long long pasada(const char* nombre, SerialPort::ControlFlujo control, const char* datos,
+                        long long longitud, double ritmo, unsigned long long& huella) {
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        std::perror("posix_openpt");
+        std::exit(2);
+    }
+    fcntl(maestro, F_SETFL, fcntl(maestro, F_GETFL) | O_NONBLOCK);
+
+    SerialPort puerto;
+    if (!puerto.abrir(ptsname(maestro), 115200, control) || !puerto.iniciarRecepcion()) {
+        std::fprintf(stderr, "No se pudo abrir %s\n", ptsname(maestro));
+        std::exit(2);
+    }
+
+    SalidaHuella salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 4096, 4096);
+    ReceptorLento receptor;
+    receptor.decodificador = &decodificador;
+    EnsambladorLineas ensamblador;
+
+    Emisor emisor;
+    emisor.maestro = maestro;
+    emisor.datos = datos;
+    emisor.longitud = longitud;
+    emisor.bytesPorSegundo = ritmo;
+
+    double inicio = segundos();
+    std::thread hilo(&Emisor::ejecutar, &emisor);
+    char bloque[4096];
+    int vacios = 0;
+    while (!receptor.fin) {
+        int n = puerto.leer(bloque, sizeof(bloque));
+        if (n < 0) break;
+        if (n == 0) {
+            // Sin control de flujo el "FIN" puede perderse: esperar 1 s de silencio
+            if (emisor.terminado && ++vacios >= 10) break;
+            continue;
+        }
+        vacios = 0;
+        ensamblador.alimentar(bloque, n, &receptor);
+    }
+    ensamblador.terminar(&receptor);
+    hilo.join();
+    decodificador.finalizar();
+    double total = segundos() - inicio;
+
+    std::printf("%-10s %9lld lineas  %5.2f s  %8lld bytes perdidos (pty %lld, cola %lld)  "
+                "%3lld XOFF  cola max %6d\n",
+                nombre, receptor.lineas, total, emisor.perdidos + puerto.getPerdidos(),
+                emisor.perdidos, puerto.getPerdidos(), emisor.xoffs, puerto.getOcupacionMaxima());
+    puerto.cerrar();
+    ::close(maestro);
+    huella = salida.hash;
+    return receptor.lineas;
+}
+
+int main(int argc, char* argv[]) {
+    long long tramas = (argc > 1) ? std::atoll(argv[1]) : 300000;
+    double ritmo = (argc > 2) ? std::atof(argv[2]) : 2e6;
+    TramaBase::setVerboso(false);
+
+    // Tramas con rotaciones: perder una cambia todo el texto que sigue
+    char* datos = static_cast<char*>(std::malloc((size_t)tramas * 4));
+    long long longitud = 0;
+    for (long long i = 0; i < tramas; i++) {
+        const char* trama = (i % 16 == 15) ? "M,1\n" : nullptr;
+        char carga[4] = { 'L', ',', (char)('A' + i % 26), '\n' };
+        std::memcpy(datos + longitud, trama != nullptr ? trama : carga, 4);
+        longitud += 4;
+    }
+
+    // Referencia: el mismo flujo decodificado sin pasar por el pty
+    SalidaHuella referencia;
+    {
+        DecodificadorPRT7 decodificador;
+        decodificador.inicializar();
+        decodificador.configurarVentana(&referencia, 4096, 4096);
+        EnsambladorLineas ensamblador;
+        ensamblador.alimentar(datos, (int)longitud, &decodificador);
+        decodificador.finalizar();
+    }
+
+    std::printf("%lld tramas (%lld bytes) a %.0f bytes/s; el consumidor duerme 1 ms cada 100 lineas\n",
+                tramas, longitud, ritmo);
+    unsigned long long huellaSin = 0;
+    unsigned long long huellaXon = 0;
+    long long sinControl = pasada("ninguno", SerialPort::SIN_CONTROL, datos, longitud, ritmo, huellaSin);
+    long long conXon = pasada("xonxoff", SerialPort::XON_XOFF, datos, longitud, ritmo, huellaXon);
+    std::free(datos);
+
+    std::printf("ninguno: %lld de %lld tramas, texto %s\n", sinControl, tramas,
+                huellaSin == referencia.hash ? "identico" : "distinto");
+    std::printf("xonxoff: %lld de %lld tramas, texto %s\n", conXon, tramas,
+                huellaXon == referencia.hash ? "identico" : "distinto");
+    return (conXon == tramas && huellaXon == referencia.hash) ? 0 : 1;
+}
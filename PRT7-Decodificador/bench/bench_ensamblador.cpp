@@ -0,0 +1,215 @@
+/**
+ * @file bench_ensamblador.cpp
+ * @brief Prueba diferencial y throughput de EnsambladorLineas con entrada aleatoria
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Genera un flujo con tramas validas, ruido, lineas de hasta 4 KiB, '\r'
+ * sueltos y bytes binarios, lo parte en bloques de tamanio aleatorio y
+ * compara las lineas entregadas con las de un ensamblador de referencia
+ * que copia byte a byte (el algoritmo anterior). Despues mide el costo
+ * por linea de ambos y del decodificador completo.
+ *
+ * Uso: prt7_bench_ensamblador [MiB] [semilla]
+ */
+
+#include "EnsambladorLineas.h"
+#include "DecodificadorPRT7.h"
+#include "SalidaCarga.h"
+#include "TramaBase.h"
+#include "comun.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @brief Resume la secuencia de lineas recibidas (FNV-1a) y las cuenta
+ */
+struct Huella : public ReceptorLineas {
+    unsigned long long hash = HUELLA_INICIAL;
+    long long lineas = 0;
+
+    void lineaCompleta(const char* linea, int longitud) override {
+        hash = mezclarHash(hash, linea, longitud);
+        hash = (hash ^ 0x100) * 1099511628211ULL;
+        lineas++;
+    }
+};
+
+/**
+ * @brief Ensamblador anterior: copia cada byte y entrega lineas terminadas en '\0'
+ */
+struct EnsambladorReferencia {
+    char buffer[EnsambladorLineas::CAPACIDAD + 1];
+    int usados = 0;
+    bool descartando = false;
+
+    void alimentar(const char* datos, int longitud, ReceptorLineas* receptor) {
+        for (int i = 0; i < longitud; i++) {
+            char c = datos[i];
+            if (c == '\n') {
+                if (descartando) {
+                    descartando = false;
+                } else {
+                    if (usados > 0 && buffer[usados - 1] == '\r') usados--;
+                    buffer[usados] = '\0';
+                    receptor->lineaCompleta(buffer, usados);
+                }
+                usados = 0;
+                continue;
+            }
+            if (descartando) continue;
+            if (usados == EnsambladorLineas::CAPACIDAD) {
+                descartando = true;
+                usados = 0;
+                continue;
+            }
+            buffer[usados++] = c;
+        }
+    }
+
+    void terminar(ReceptorLineas* receptor) {
+        if (!descartando && usados > 0) {
+            buffer[usados] = '\0';
+            receptor->lineaCompleta(buffer, usados);
+        }
+        usados = 0;
+        descartando = false;
+    }
+};
+
+/**
+ * @brief Llena el flujo con lineas de distintos tipos
+ * @return Bytes escritos
+ */
+static long long generar(char* datos, long long capacidad) {
+    long long n = 0;
+    while (n < capacidad - 8192) {
+        unsigned int tipo = aleatorio(100);
+        if (tipo < 55) {
+            n += std::sprintf(datos + n, "L,%c", 'A' + aleatorio(26));
+        } else if (tipo < 68) {
+            n += std::sprintf(datos + n, "M,%d", (int)aleatorio(51) - 25);
+        } else if (tipo < 70) {
+            n += std::sprintf(datos + n, "TX: [L,%c]", 'a' + aleatorio(26));
+        } else if (tipo < 71) {
+            n += std::sprintf(datos + n, "F,");
+        } else if (tipo < 85) {
+            // Ruido imprimible corto
+            int largo = (int)aleatorio(60);
+            for (int i = 0; i < largo; i++) datos[n++] = (char)(' ' + aleatorio(95));
+        } else if (tipo < 92) {
+            // Bytes binarios, incluidos '\r' y '\0'
+            int largo = (int)aleatorio(40);
+            for (int i = 0; i < largo; i++) {
+                char c = (char)aleatorio(256);
+                datos[n++] = (c == '\n') ? '\r' : c;
+            }
+        } else if (tipo < 95) {
+            // Alrededor de la capacidad, para probar el limite exacto
+            int largo = EnsambladorLineas::CAPACIDAD - 2 + (int)aleatorio(5);
+            for (int i = 0; i < largo; i++) datos[n++] = 'x';
+        } else if (tipo < 98) {
+            // Linea demasiado larga
+            int largo = EnsambladorLineas::CAPACIDAD + (int)aleatorio(4096);
+            for (int i = 0; i < largo; i++) datos[n++] = (char)('a' + aleatorio(26));
+        }
+        // tipo >= 98: linea vacia
+        if (aleatorio(10) == 0) datos[n++] = '\r';
+        datos[n++] = '\n';
+    }
+    // Ultima linea sin '\n' para ejercitar terminar()
+    n += std::sprintf(datos + n, "L,Z");
+    return n;
+}
+
+template <class Ensamblador>
+static Huella recorrer(Ensamblador& ensamblador, const char* datos, long long longitud, int bloqueMaximo) {
+    Huella huella;
+    long long i = 0;
+    while (i < longitud) {
+        int bloque = (bloqueMaximo > 1) ? 1 + (int)aleatorio((unsigned int)bloqueMaximo) : 1;
+        if (bloque > longitud - i) bloque = (int)(longitud - i);
+        ensamblador.alimentar(datos + i, bloque, &huella);
+        i += bloque;
+    }
+    ensamblador.terminar(&huella);
+    return huella;
+}
+
+template <class Ensamblador>
+static void medir(const char* nombre, const char* datos, long long longitud, int bloque) {
+    Ensamblador* ensamblador = new Ensamblador();
+    Huella huella;
+    double inicio = segundos();
+    for (long long i = 0; i < longitud; i += bloque) {
+        int n = (longitud - i < bloque) ? (int)(longitud - i) : bloque;
+        ensamblador->alimentar(datos + i, n, &huella);
+    }
+    ensamblador->terminar(&huella);
+    double total = segundos() - inicio;
+    std::printf("%-38s %10lld lineas  %6.2f ns/linea  %7.0f MB/s\n", nombre, huella.lineas,
+                total * 1e9 / (double)huella.lineas, (double)longitud / total / 1e6);
+    delete ensamblador;
+}
+
+int main(int argc, char* argv[]) {
+    long long mib = (argc > 1) ? std::atoll(argv[1]) : 64;
+    if (argc > 2) estadoAleatorio = std::strtoull(argv[2], nullptr, 10) | 1;
+    long long capacidad = mib << 20;
+    char* fuzz = static_cast<char*>(std::malloc((size_t)capacidad));
+    char* limpio = static_cast<char*>(std::malloc((size_t)capacidad));
+    if (fuzz == nullptr || limpio == nullptr || capacidad < (1 << 16)) {
+        std::fprintf(stderr, "No se pudo reservar el flujo\n");
+        return 1;
+    }
+    long long bytesFuzz = generar(fuzz, capacidad);
+    long long bytesLimpio = capacidad - capacidad % 4;
+    for (long long i = 0; i < bytesLimpio; i += 4) {
+        std::memcpy(limpio + i, (i % 32 == 28) ? "M,3\n" : "L,C\n", 4);
+    }
+
+    // Prueba diferencial: el resultado no depende de como se corten los bloques
+    EnsambladorReferencia referencia;
+    Huella esperada = recorrer(referencia, fuzz, bytesFuzz, 0);
+    const int cortes[] = { 1, 7, 300, 4096, 65536 };
+    for (int c = 0; c < (int)(sizeof(cortes) / sizeof(cortes[0])); c++) {
+        EnsambladorLineas ensamblador;
+        Huella obtenida = recorrer(ensamblador, fuzz, bytesFuzz, cortes[c]);
+        if (obtenida.hash != esperada.hash || obtenida.lineas != esperada.lineas) {
+            std::printf("DIFERENCIA con bloques de hasta %d bytes: %lld lineas vs %lld\n",
+                        cortes[c], obtenida.lineas, esperada.lineas);
+            return 1;
+        }
+    }
+    std::printf("%lld MiB aleatorios: %lld lineas identicas a la referencia con 5 tamanios de bloque\n",
+                mib, esperada.lineas);
+
+    medir<EnsambladorReferencia>("referencia (copia), tramas limpias", limpio, bytesLimpio, 65536);
+    medir<EnsambladorLineas>("ensamblador, tramas limpias", limpio, bytesLimpio, 65536);
+    medir<EnsambladorReferencia>("referencia (copia), aleatorio", fuzz, bytesFuzz, 65536);
+    medir<EnsambladorLineas>("ensamblador, aleatorio", fuzz, bytesFuzz, 65536);
+
+    // Decodificador completo sobre el flujo aleatorio
+    TramaBase::setVerboso(false);
+    SalidaNula salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 4096, 4096);
+    EnsambladorLineas ensamblador;
+    double inicio = segundos();
+    for (long long i = 0; i < bytesFuzz; i += 65536) {
+        int n = (bytesFuzz - i < 65536) ? (int)(bytesFuzz - i) : 65536;
+        ensamblador.alimentar(fuzz + i, n, &decodificador);
+    }
+    ensamblador.terminar(&decodificador);
+    double total = segundos() - inicio;
+    decodificador.finalizar();
+    std::printf("%-38s %10lld lineas  %6.2f ns/linea  (%lld caracteres, %lld lineas largas)\n",
+                "decodificador, aleatorio", esperada.lineas, total * 1e9 / (double)esperada.lineas,
+                salida.caracteres, ensamblador.getDescartadas());
+
+    std::free(fuzz);
+    std::free(limpio);
+    return 0;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file bench_espejo.cpp
+ * @brief Prueba de estres y costo de EspejoCarga con hilos lectores
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Prepara en memoria tramas LOAD, lotes, MAP y FIN elegidas para que el
+ * caracter decodificado en la posicion absoluta p sea siempre
+ * 'A' + p % 26, sin importar el rotor. Un hilo decodifica mientras N
+ * hilos leen el espejo sin parar y comprueban cada vista: el texto copiado
+ * corresponde a sus posiciones, el tamanio coincide con el ultimo cierre
+ * de mensaje (menos los lotes que PRT7_SIN_HEAP vuelque por desborde) y
+ * los contadores nunca retroceden. Se mide el tiempo de CPU
+ * del hilo escritor por linea sin espejo, con espejo y con espejo y
+ * lectores. Con pocos nucleos los lectores le quitan tiempo de reloj al
+ * escritor; la fila de hilos ociosos separa ademas el costo que no es del
+ * espejo: con hilos vivos, malloc de glibc deja su camino de un solo hilo
+ * y cada new de la lista de carga cuesta mas (no pasa con PRT7_SIN_HEAP).
+ *
+ * Uso: prt7_bench_espejo [lineas] [lectores] [pausa_us]
+ * (pausa_us: espera de cada lector entre lecturas; 0 = leer sin parar)
+ */
+
+#include "DecodificadorPRT7.h"
+#include "EspejoCarga.h"
+#include "SalidaCarga.h"
+#include "TramaBase.h"
+#include "TramaLoad.h"
+#include "comun.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <time.h>
+
+static const int LOTE = 4096; ///< Lote de volcado de la lista de carga
+
+/* Tiempo de CPU del hilo actual, sin contar cuando otro hilo ocupa el nucleo */
+static double segundosCpuHilo() {
+    timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+struct Entrada {
+    std::vector<char> texto;
+    std::vector<int> inicios;
+    std::vector<long long> cierres; ///< Total de caracteres al procesar cada "F,"
+
+    void agregar(const char* linea, int longitud) {
+        inicios.push_back((int)texto.size());
+        texto.insert(texto.end(), linea, linea + longitud);
+    }
+    int cantidad() const { return (int)inicios.size(); }
+    const char* linea(int i) const { return texto.data() + inicios[i]; }
+    int longitud(int i) const {
+        int fin = (i + 1 < cantidad()) ? inicios[i + 1] : (int)texto.size();
+        return fin - inicios[i];
+    }
+};
+
+/* Caracter que hay que enviar para que, con el rotor en r, salga el de la posicion p */
+static char cifrar(long long p, int r) {
+    return (char)('A' + ((int)(p % 26) - r + 26) % 26);
+}
+
+static void generar(Entrada& entrada, int cantidad) {
+    char linea[256];
+    long long posicion = 0;
+    long long ultimoCierre = 0;
+    int rotor = 0;
+    for (int l = 0; l < cantidad; l++) {
+        unsigned int tipo = aleatorio(10000);
+        int n = 0;
+        if (tipo < 3 && posicion > ultimoCierre) {
+            n = std::sprintf(linea, "F,");
+            entrada.cierres.push_back(posicion);
+            ultimoCierre = posicion;
+        } else if (tipo < 1500) {
+            int giro = (int)aleatorio(51) - 25;
+            n = std::sprintf(linea, "M,%d", giro);
+            rotor = ((rotor + giro) % 26 + 26) % 26;
+        } else if (tipo < 2000) {
+            int largo = 1 + (int)aleatorio(TramaLoad::MAX_LOTE);
+            n = std::sprintf(linea, "L*%d,", largo);
+            for (int i = 0; i < largo; i++) linea[n++] = cifrar(posicion++, rotor);
+        } else {
+            n = std::sprintf(linea, "L,%c", cifrar(posicion++, rotor));
+        }
+        entrada.agregar(linea, n);
+    }
+}
+
+struct Resultado {
+    long long lecturas = 0;
+    long long fallidas = 0;
+    long long errores = 0;
+};
+
+/**
+ * @brief Lee el espejo hasta que el escritor termina y valida cada vista
+ */
+static void leer(const EspejoCarga* espejo, const Entrada* entrada, const std::atomic<bool>* terminado,
+                 int pausa, Resultado* resultado) {
+    if (espejo == nullptr) {
+        // Hilo ocioso: solo existe
+        while (!terminado->load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return;
+    }
+    char texto[EspejoCarga::MAX_VISIBLE];
+    long long ultimaVersion = -1;
+    long long ultimoTotal = 0;
+    while (!terminado->load(std::memory_order_acquire)) {
+        InstantaneaCarga foto;
+        if (!espejo->leer(foto, texto, (int)sizeof(texto))) {
+            resultado->fallidas++;
+            continue;
+        }
+        resultado->lecturas++;
+        bool correcta = foto.version >= ultimaVersion && foto.totalInsertados >= ultimoTotal &&
+                        foto.desplazamiento >= 0 && foto.desplazamiento < 26 &&
+                        foto.copiados == std::min(foto.tamanio, (int)EspejoCarga::MAX_VISIBLE);
+        long long m = foto.totalMensajes;
+        long long inicioMensaje = 0;
+        if (m > 0 && m <= (long long)entrada->cierres.size()) inicioMensaje = entrada->cierres[(size_t)m - 1];
+        if (m > (long long)entrada->cierres.size()) inicioMensaje = foto.totalInsertados;
+        long long esperado = foto.totalInsertados - inicioMensaje;
+        if (foto.tamanio > esperado || (esperado - foto.tamanio) % LOTE != 0) correcta = false;
+        long long inicio = foto.totalInsertados - foto.copiados;
+        for (int i = 0; i < foto.copiados && correcta; i++) {
+            if (texto[i] != (char)('A' + (inicio + i) % 26)) correcta = false;
+        }
+        if (!correcta) resultado->errores++;
+        ultimaVersion = foto.version;
+        ultimoTotal = foto.totalInsertados;
+        if (pausa > 0) std::this_thread::sleep_for(std::chrono::microseconds(pausa));
+    }
+}
+
+/**
+ * @brief Decodifica toda la entrada
+ * @param cpu Recibe los nanosegundos de CPU del escritor por linea
+ * @return Nanosegundos de reloj por linea
+ */
+static double ronda(const Entrada& entrada, bool conEspejo, int lectores, int pausa, Resultado& total,
+                    double& cpu) {
+    SalidaNula salida;
+    EspejoCarga espejo;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 0, LOTE);
+    if (conEspejo) decodificador.configurarEspejo(&espejo);
+
+    std::atomic<bool> terminado(false);
+    std::vector<Resultado> resultados((size_t)lectores);
+    std::vector<std::thread> hilos;
+    for (int i = 0; i < lectores; i++) {
+        hilos.emplace_back(leer, conEspejo ? &espejo : nullptr, &entrada, &terminado, pausa,
+                           &resultados[(size_t)i]);
+    }
+
+    double inicio = segundos();
+    double inicioCpu = segundosCpuHilo();
+    for (int i = 0; i < entrada.cantidad(); i++) {
+        decodificador.procesarLinea(entrada.linea(i), entrada.longitud(i));
+    }
+    cpu = (segundosCpuHilo() - inicioCpu) * 1e9 / entrada.cantidad();
+    double tiempo = (segundos() - inicio) * 1e9 / entrada.cantidad();
+    terminado.store(true, std::memory_order_release);
+    for (size_t i = 0; i < hilos.size(); i++) hilos[i].join();
+    decodificador.finalizar();
+
+    for (size_t i = 0; i < resultados.size(); i++) {
+        total.lecturas += resultados[i].lecturas;
+        total.fallidas += resultados[i].fallidas;
+        total.errores += resultados[i].errores;
+    }
+    return tiempo;
+}
+
+int main(int argc, char* argv[]) {
+    int cantidad = (argc > 1) ? std::atoi(argv[1]) : 4000000;
+    int lectores = (argc > 2) ? std::atoi(argv[2]) : 4;
+    int pausa = (argc > 3) ? std::atoi(argv[3]) : 0;
+    TramaBase::setVerboso(false);
+
+    Entrada entrada;
+    generar(entrada, cantidad);
+
+    const int CONFIGURACIONES = 4;
+    const char* nombres[CONFIGURACIONES] = {"sin espejo", "sin espejo, ociosos", "espejo, sin lectores",
+                                            "espejo con lectores"};
+    bool conEspejo[CONFIGURACIONES] = {false, false, true, true};
+    int hilos[CONFIGURACIONES] = {0, lectores, 0, lectores};
+    double reloj[CONFIGURACIONES] = {1e30, 1e30, 1e30, 1e30};
+    double cpu[CONFIGURACIONES] = {1e30, 1e30, 1e30, 1e30};
+    Resultado resultado;
+    // Rondas intercaladas: el mejor de 3 por configuracion reduce el ruido
+    for (int repeticion = 0; repeticion < 3; repeticion++) {
+        for (int c = 0; c < CONFIGURACIONES; c++) {
+            double cpuRonda = 0;
+            double relojRonda = ronda(entrada, conEspejo[c], hilos[c], pausa, resultado, cpuRonda);
+            reloj[c] = std::min(reloj[c], relojRonda);
+            cpu[c] = std::min(cpu[c], cpuRonda);
+        }
+    }
+    std::printf("%u nucleos, %d lineas\n", std::thread::hardware_concurrency(), entrada.cantidad());
+    for (int c = 0; c < CONFIGURACIONES; c++) {
+        std::printf("%-21s escritor: %6.1f ns CPU/linea (%+5.1f%%), %7.1f ns reloj/linea\n", nombres[c],
+                    cpu[c], (cpu[c] / cpu[0] - 1) * 100, reloj[c]);
+    }
+    std::printf("%d lectores (pausa %d us): %lld vistas coherentes, %lld lecturas agotaron sus intentos, %lld vistas incorrectas\n",
+                lectores, pausa, resultado.lecturas, resultado.fallidas, resultado.errores);
+    return resultado.errores == 0 ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file bench_inactividad_serial.cpp
+ * @brief Cierre por inactividad con ejecutarSerial: las tramas que siguen llegando no cortan el mensaje (usa un pty)
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Un hilo emisor escribe en el lado maestro de un pty y el decodificador
+ * lee el lado esclavo con ejecutarSerial y --inactividad. Primero se deja
+ * pasar mas que el limite sin datos, despues llegan tramas separadas por
+ * pausas mayores que el tiempo de espera de SerialPort::leer (100 ms)
+ * pero menores que el limite, luego un silencio largo y otra rafaga. El
+ * texto debe salir en dos mensajes completos: si las tramas del puerto no
+ * renovaran la actividad, cada pausa cerraria un mensaje.
+ *
+ * Al final el emisor cierra el maestro; la lectura del esclavo falla y
+ * ejecutarSerial vuelve.
+ *
+ * Uso: prt7_bench_inactividad_serial [inactividad_ms]
+ */
+
+#include "DecodificadorPRT7.h"
+#include "SalidaCarga.h"
+#include "SerialPort.h"
+#include "TramaBase.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @brief Guarda cada mensaje cerrado por separado
+ */
+struct SalidaMensajes : public SalidaCarga {
+    std::string actual;
+    std::vector<std::string> mensajes;
+    void escribir(const char* datos, int longitud) override { actual.append(datos, (size_t)longitud); }
+    void finMensaje() override {
+        mensajes.push_back(actual);
+        actual.clear();
+    }
+};
+
+static void dormirMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+/**
+ * @brief Lado emisor: silencio inicial, rafaga lenta, silencio largo, rafaga lenta
+ */
+struct Emisor {
+    int maestro = -1;
+    int inactividadMs = 400;
+
+    bool enviar(const char* trama) {
+        int n = 0;
+        while (trama[n] != '\0') n++;
+        return ::write(maestro, trama, (size_t)n) == n;
+    }
+
+    void rafaga(const char* trama, int cantidad, int pausaMs) {
+        for (int i = 0; i < cantidad; i++) {
+            if (!enviar(trama)) return;
+            dormirMs(pausaMs);
+        }
+    }
+
+    void ejecutar() {
+        // Entre tramas: mas que la espera de leer(), menos que el limite
+        int pausa = inactividadMs * 3 / 8;
+        dormirMs(inactividadMs + inactividadMs / 2);
+        rafaga("L,A\n", 8, pausa);
+        dormirMs(inactividadMs * 3);
+        rafaga("L,B\n", 4, pausa);
+        // Ruido del puerto: no es trama y no renueva la actividad
+        enviar("hola\n");
+        dormirMs(inactividadMs * 2);
+        ::close(maestro);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    int inactividad = (argc > 1) ? std::atoi(argv[1]) : 400;
+    TramaBase::setVerboso(false);
+
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        std::perror("posix_openpt");
+        return 2;
+    }
+    std::string esclavo = ptsname(maestro);
+
+    SalidaMensajes salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.configurarVerboso(false);
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 4096, 4096);
+    decodificador.configurarSegmentacion('\0', inactividad);
+
+    Emisor emisor;
+    emisor.maestro = maestro;
+    emisor.inactividadMs = inactividad;
+    std::thread hilo(&Emisor::ejecutar, &emisor);
+
+    // ejecutarSerial muestra cada trama en std::cout: se descarta
+    std::streambuf* consola = std::cout.rdbuf(nullptr);
+    decodificador.ejecutarSerial(esclavo.c_str(), 115200, SerialPort::SIN_CONTROL);
+    decodificador.finalizar();
+    std::cout.rdbuf(consola);
+    std::cout.clear();
+    hilo.join();
+
+    const std::vector<std::string> esperados = {"AAAAAAAA", "BBBB"};
+    std::printf("inactividad %d ms, pausas de %d ms entre tramas: %zu mensajes\n", inactividad,
+                inactividad * 3 / 8, salida.mensajes.size());
+    for (const std::string& m : salida.mensajes) std::printf("  \"%s\"\n", m.c_str());
+    bool correcto = salida.mensajes == esperados;
+    if (!correcto) std::printf("ERROR: se esperaban los mensajes \"AAAAAAAA\" y \"BBBB\"\n");
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file bench_indice.cpp
+ * @brief Tiempo hasta el primer caracter con y sin IndiceCaptura en posiciones aleatorias
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Escribe una captura con tramas LOAD, MAP, lotes, FIN y ruido, la
+ * decodifica completa como referencia y construye su indice. Despues
+ * elige posiciones de caracter al azar y mide cuanto tarda en aparecer
+ * ese caracter repitiendo la captura desde el byte 0 y retomandola desde
+ * el punto del indice; en ambos casos comprueba que el caracter coincide
+ * con la referencia.
+ *
+ * Uso: prt7_bench_indice [MiB] [posiciones] [intervalo] [ruta_captura]
+ */
+
+#include "IndiceCaptura.h"
+#include "DecodificadorPRT7.h"
+#include "EnsambladorLineas.h"
+#include "LectorEntrada.h"
+#include "SalidaCarga.h"
+#include "TramaBase.h"
+#include "TramaLoad.h"
+#include "comun.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/* Guarda todo el texto decodificado: referencia para comparar */
+struct SalidaMemoria : public SalidaCarga {
+    std::vector<char> texto;
+    void escribir(const char* datos, int longitud) override {
+        texto.insert(texto.end(), datos, datos + longitud);
+    }
+};
+
+/**
+ * @brief Salida que cuenta caracteres y se queda con el de una posicion
+ */
+struct SalidaBuscadora : public SalidaCarga {
+    long long posicion = 0;   ///< Caracteres recibidos (absolutos)
+    long long objetivo = 0;   ///< Posicion buscada
+    char encontrado = '\0';
+    bool listo = false;
+
+    void escribir(const char* datos, int longitud) override {
+        if (!listo && objetivo < posicion + longitud) {
+            encontrado = datos[objetivo - posicion];
+            listo = true;
+        }
+        posicion += longitud;
+    }
+};
+
+/* Deja de decodificar en cuanto aparece el caracter buscado */
+struct ReceptorHastaObjetivo : public ReceptorLineas {
+    DecodificadorPRT7* decodificador = nullptr;
+    SalidaBuscadora* salida = nullptr;
+    void lineaCompleta(const char* linea, int longitud) override {
+        if (!salida->listo) decodificador->lineaCompleta(linea, longitud);
+    }
+};
+
+/**
+ * @brief Decodifica desde un byte con el rotor dado hasta encontrar un caracter
+ * @return El caracter en la posicion objetivo, o '\0' si no aparecio
+ */
+static char buscar(const char* ruta, long long desde, int rotor, long long caracteresAntes, long long objetivo) {
+    SalidaBuscadora salida;
+    salida.posicion = caracteresAntes;
+    salida.objetivo = objetivo;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 64, 64);
+    decodificador.posicionarRotor(rotor);
+    ReceptorHastaObjetivo receptor;
+    receptor.decodificador = &decodificador;
+    receptor.salida = &salida;
+
+    LectorEntrada lector;
+    if (!lector.abrir(ruta) || (desde > 0 && !lector.posicionar(desde))) return '\0';
+    EnsambladorLineas ensamblador;
+    const char* bloque = nullptr;
+    int longitud = 0;
+    while (!salida.listo && lector.siguienteBloque(bloque, longitud)) {
+        ensamblador.alimentar(bloque, longitud, &receptor);
+    }
+    if (!salida.listo) {
+        ensamblador.terminar(&receptor);
+        decodificador.finalizar();
+    }
+    return salida.encontrado;
+}
+
+/**
+ * @brief Escribe la captura de prueba
+ * @return Bytes escritos, o -1 si fallo
+ */
+static long long generar(const char* ruta, long long objetivo) {
+    std::FILE* f = std::fopen(ruta, "wb");
+    if (f == nullptr) return -1;
+    char linea[512];
+    long long total = 0;
+    while (total < objetivo) {
+        unsigned int tipo = aleatorio(1000);
+        int n = 0;
+        if (tipo < 600) {
+            n = std::sprintf(linea, "L,%c\n", 'A' + aleatorio(26));
+        } else if (tipo < 780) {
+            n = std::sprintf(linea, "M,%d\n", (int)aleatorio(51) - 25);
+        } else if (tipo < 830) {
+            // Lote de varios caracteres
+            int largo = 1 + (int)aleatorio(TramaLoad::MAX_LOTE);
+            n = std::sprintf(linea, "L*%d,", largo);
+            for (int i = 0; i < largo; i++) linea[n++] = (char)('A' + aleatorio(26));
+            linea[n++] = '\n';
+        } else if (tipo < 835) {
+            n = std::sprintf(linea, "F,\n");
+        } else if (tipo < 850) {
+            n = std::sprintf(linea, "TX: [L,%c]\r\n", 'A' + aleatorio(26));
+        } else if (tipo < 950) {
+            // Ruido que no es trama
+            int largo = (int)aleatorio(40);
+            for (int i = 0; i < largo; i++) linea[n++] = (char)('a' + aleatorio(26));
+            linea[n++] = '\n';
+        } else {
+            n = std::sprintf(linea, "L,%c\r\n", 'a' + aleatorio(26));
+        }
+        std::fwrite(linea, 1, (size_t)n, f);
+        total += n;
+    }
+    std::fclose(f);
+    return total;
+}
+
+int main(int argc, char* argv[]) {
+    long long mib = (argc > 1) ? std::atoll(argv[1]) : 256;
+    int consultas = (argc > 2) ? std::atoi(argv[2]) : 20;
+    int intervalo = (argc > 3) ? std::atoi(argv[3]) : IndiceCaptura::INTERVALO_DEFECTO;
+    const char* ruta = (argc > 4) ? argv[4] : "prt7_bench_indice.captura";
+    char rutaIndice[512];
+    std::snprintf(rutaIndice, sizeof(rutaIndice), "%s.idx", ruta);
+    TramaBase::setVerboso(false);
+
+    long long bytes = generar(ruta, mib << 20);
+    if (bytes < 0) {
+        std::fprintf(stderr, "No se pudo escribir %s\n", ruta);
+        return 1;
+    }
+
+    // Referencia: la captura completa decodificada en memoria
+    SalidaMemoria referencia;
+    double inicio = segundos();
+    {
+        DecodificadorPRT7 decodificador;
+        decodificador.inicializar();
+        decodificador.configurarVentana(&referencia, 4096, 4096);
+        decodificador.ejecutarArchivo(ruta);
+        decodificador.finalizar();
+    }
+    double tiempoCompleto = segundos() - inicio;
+    long long caracteres = (long long)referencia.texto.size();
+
+    IndiceCaptura indice;
+    inicio = segundos();
+    if (!indice.construir(ruta, rutaIndice, intervalo)) {
+        std::fprintf(stderr, "No se pudo construir %s\n", rutaIndice);
+        return 1;
+    }
+    double tiempoIndice = segundos() - inicio;
+    std::printf("Captura: %lld bytes, %lld tramas validas, %lld caracteres\n",
+                bytes, indice.getTramas(), caracteres);
+    std::printf("Decodificacion completa %.2f s; indice en una pasada %.2f s: %lld puntos cada %d tramas, %lld bytes\n",
+                tiempoCompleto, tiempoIndice, indice.getPuntos(), indice.getIntervalo(),
+                IndiceCaptura::TAM_CABECERA + indice.getPuntos() * IndiceCaptura::TAM_PUNTO);
+
+    // Posiciones al azar: cada una se busca desde el byte 0 y desde el indice
+    std::vector<double> sinIndice;
+    std::vector<double> conIndice;
+    int errores = 0;
+    for (int q = 0; q < consultas; q++) {
+        long long objetivo = (long long)(((unsigned long long)aleatorio(1u << 30) << 20 |
+                                          aleatorio(1u << 20)) % (unsigned long long)caracteres);
+        char esperado = referencia.texto[(size_t)objetivo];
+
+        inicio = segundos();
+        char c = buscar(ruta, 0, 0, 0, objetivo);
+        sinIndice.push_back(segundos() - inicio);
+        if (c != esperado) errores++;
+
+        inicio = segundos();
+        IndiceCaptura consulta;
+        PuntoIndice punto;
+        long long numero = consulta.abrir(rutaIndice) ? consulta.buscarCaracter(objetivo) : -1;
+        c = (numero >= 0 && consulta.leerPunto(numero, punto))
+                ? buscar(ruta, punto.entrada, punto.rotor, punto.caracteres, objetivo) : '\0';
+        conIndice.push_back(segundos() - inicio);
+        if (c != esperado) errores++;
+    }
+
+    std::sort(sinIndice.begin(), sinIndice.end());
+    std::sort(conIndice.begin(), conIndice.end());
+    if (consultas > 0) {
+        std::printf("Tiempo al primer caracter (%d posiciones): sin indice mediana %.1f ms, max %.1f ms; "
+                    "con indice mediana %.3f ms, max %.3f ms\n",
+                    consultas, sinIndice[sinIndice.size() / 2] * 1e3, sinIndice.back() * 1e3,
+                    conIndice[conIndice.size() / 2] * 1e3, conIndice.back() * 1e3);
+    }
+    std::printf("%s\n", errores == 0 ? "Todos los caracteres coinciden con la referencia"
+                                     : "ERROR: caracteres distintos de la referencia");
+
+    std::remove(rutaIndice);
+    if (argc <= 4) std::remove(ruta);
+    return errores == 0 ? 0 : 1;
+}
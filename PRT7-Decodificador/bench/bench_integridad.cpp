@@ -0,0 +1,199 @@
+/**
+ * @file bench_integridad.cpp
+ * @brief Costo del sufijo de secuencia y CRC32C: verificar() solo y decodificacion completa
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Genera una captura con sufijo "*secuencia*crc" en cada trama, como
+ * prt7_codificador --integridad, y la misma captura sin sufijo. Mide:
+ *
+ * - verificar() sobre cada linea ya separada (ns por trama);
+ * - la decodificacion completa (EnsambladorLineas + DecodificadorPRT7)
+ *   de la captura sin sufijo, de la captura con sufijo sin verificar y
+ *   de la captura con sufijo verificando.
+ *
+ * Las configuraciones se alternan y de cada una se toma la mejor de
+ * varias repeticiones. Las tres decodificaciones deben dar el mismo texto
+ * y todas las tramas deben ser validas.
+ *
+ * Antes se decodifican lineas sin sufijo cuya carga lleva '*' ("L,*",
+ * "L*3,A*B", "L*5,X*1*2", finales casi de sufijo): con --integridad no
+ * estricto el texto debe ser el mismo que sin verificar y ninguna puede
+ * contarse como corrupta.
+ *
+ * Uso: prt7_bench_integridad [tramas] [repeticiones]
+ */
+
+#include "DecodificadorPRT7.h"
+#include "EnsambladorLineas.h"
+#include "TramaBase.h"
+#include "VerificadorIntegridad.h"
+#include "comun.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static const int BLOQUE = 1 << 16;
+
+/* Captura con y sin sufijo, con las lineas con sufijo tambien separadas */
+struct Capturas {
+    std::vector<char> plana;
+    std::vector<char> conSufijo;
+    std::vector<int> inicios; ///< Inicio de cada linea en conSufijo
+};
+
+static void generar(long long tramas, Capturas& c) {
+    char cuerpo[32];
+    char sufijo[VerificadorIntegridad::MAX_SUFIJO];
+    for (long long t = 0; t < tramas; t++) {
+        unsigned int tipo = aleatorio(100);
+        int n;
+        if (tipo < 85) {
+            n = std::snprintf(cuerpo, sizeof(cuerpo), "L,%c", 'A' + aleatorio(26));
+        } else if (tipo < 99) {
+            n = std::snprintf(cuerpo, sizeof(cuerpo), "M,%d", (int)aleatorio(11) - 5);
+        } else {
+            n = std::snprintf(cuerpo, sizeof(cuerpo), "F,");
+        }
+        int s = VerificadorIntegridad::escribirSufijo(cuerpo, n, (unsigned int)t, sufijo);
+        c.plana.insert(c.plana.end(), cuerpo, cuerpo + n);
+        c.plana.push_back('\n');
+        c.inicios.push_back((int)c.conSufijo.size());
+        c.conSufijo.insert(c.conSufijo.end(), cuerpo, cuerpo + n);
+        c.conSufijo.insert(c.conSufijo.end(), sufijo, sufijo + s);
+        c.conSufijo.push_back('\n');
+    }
+}
+
+/* Tiempo de verificar() sobre todas las lineas, en ns por trama */
+static double medirVerificar(const Capturas& c, long long& validas) {
+    long long tramas = (long long)c.inicios.size();
+    VerificadorIntegridad verificador;
+    double inicio = segundos();
+    for (long long i = 0; i < tramas; i++) {
+        int desde = c.inicios[(size_t)i];
+        int hasta = (i + 1 < tramas) ? c.inicios[(size_t)i + 1] : (int)c.conSufijo.size();
+        int cuerpo = 0;
+        verificador.verificar(c.conSufijo.data() + desde, hasta - desde - 1, cuerpo);
+    }
+    double tiempo = segundos() - inicio;
+    validas = verificador.getValidas();
+    return tiempo * 1e9 / (double)tramas;
+}
+
+/* Tiempo de la decodificacion completa, en ns por trama */
+static double medirDecodificacion(const std::vector<char>& captura, long long tramas, bool verificar,
+                                  unsigned long long& huella, long long& validas) {
+    SalidaHuella salida;
+    VerificadorIntegridad verificador;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 4096, 4096);
+    if (verificar) decodificador.configurarIntegridad(&verificador);
+    EnsambladorLineas ensamblador;
+
+    double inicio = segundos();
+    for (size_t i = 0; i < captura.size(); i += BLOQUE) {
+        size_t n = captura.size() - i;
+        if (n > (size_t)BLOQUE) n = BLOQUE;
+        ensamblador.alimentar(captura.data() + i, (int)n, &decodificador);
+    }
+    ensamblador.terminar(&decodificador);
+    decodificador.finalizar();
+    double tiempo = segundos() - inicio;
+    huella = salida.hash;
+    validas = verificador.getValidas();
+    return tiempo * 1e9 / (double)tramas;
+}
+
+/* Decodifica un flujo de una vez, con o sin verificador */
+static unsigned long long decodificarFlujo(const std::string& flujo, VerificadorIntegridad* verificador) {
+    SalidaHuella salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 4096, 4096);
+    if (verificador != nullptr) decodificador.configurarIntegridad(verificador);
+    EnsambladorLineas ensamblador;
+    ensamblador.alimentar(flujo.data(), (int)flujo.size(), &decodificador);
+    ensamblador.terminar(&decodificador);
+    decodificador.finalizar();
+    return salida.hash;
+}
+
+static bool probarCargaConAsterisco() {
+    const char* lineas[] = {
+        "L,*",
+        "L*3,A*B",
+        "L*5,X*1*2",
+        "L,A",
+        "L*11,A*1*1234567",  // 7 digitos hexadecimales
+        "L*12,A*1*1234567g", // 8 caracteres, uno no hexadecimal
+        "L*12,A**12345678",  // sin digitos de secuencia
+        "L*12,AB*x2345678",  // sin segundo '*'
+    };
+    std::string flujo;
+    for (const char* l : lineas) {
+        flujo += l;
+        flujo += '\n';
+    }
+    flujo += "F,\n";
+    unsigned long long referencia = decodificarFlujo(flujo, nullptr);
+    VerificadorIntegridad verificador;
+    unsigned long long verificada = decodificarFlujo(flujo, &verificador);
+    int total = (int)(sizeof(lineas) / sizeof(lineas[0])) + 1;
+    bool correcto = verificada == referencia && verificador.getCorruptas() == 0 && verificador.getSinSufijo() == total;
+    std::printf("Carga con '*' sin sufijo: %lld corruptas, %lld sin sufijo de %d, texto %s\n",
+                verificador.getCorruptas(), verificador.getSinSufijo(), total,
+                verificada == referencia ? "igual" : "DISTINTO");
+    if (!correcto) std::printf("ERROR: --integridad no estricto altero tramas sin sufijo\n");
+    return correcto;
+}
+
+static void quedarseConMejor(double& mejor, double ns) {
+    if (ns < mejor) mejor = ns;
+}
+
+int main(int argc, char* argv[]) {
+    long long tramas = (argc > 1) ? std::atoll(argv[1]) : 4000000;
+    int repeticiones = (argc > 2) ? std::atoi(argv[2]) : 9;
+    TramaBase::setVerboso(false);
+
+    bool cargaCorrecta = probarCargaConAsterisco();
+
+    Capturas c;
+    generar(tramas, c);
+    std::printf("%lld tramas: %.1f MB sin sufijo, %.1f MB con sufijo; CRC32C %s; mejor de %d\n", tramas,
+                c.plana.size() / 1e6, c.conSufijo.size() / 1e6,
+                VerificadorIntegridad::usaHardware() ? "por hardware" : "por tabla", repeticiones);
+
+    // Las configuraciones se alternan en cada repeticion para que el ruido
+    // de la maquina afecte a todas por igual
+    double solo = 1e30;
+    double plana = 1e30;
+    double sufijo = 1e30;
+    double verificada = 1e30;
+    unsigned long long huellaPlana = 0;
+    unsigned long long huellaSufijo = 0;
+    unsigned long long huellaVerificada = 0;
+    long long validasSolo = 0;
+    long long validas = 0;
+    long long ignoradas = 0;
+    for (int r = 0; r < repeticiones; r++) {
+        quedarseConMejor(solo, medirVerificar(c, validasSolo));
+        quedarseConMejor(plana, medirDecodificacion(c.plana, tramas, false, huellaPlana, ignoradas));
+        quedarseConMejor(sufijo, medirDecodificacion(c.conSufijo, tramas, false, huellaSufijo, ignoradas));
+        quedarseConMejor(verificada, medirDecodificacion(c.conSufijo, tramas, true, huellaVerificada, validas));
+    }
+    std::printf("verificar() solo                      %7.2f ns/trama\n", solo);
+    std::printf("decodificar sin sufijo                %7.2f ns/trama\n", plana);
+    std::printf("decodificar con sufijo                %7.2f ns/trama  (%+.1f%% frente a sin sufijo)\n", sufijo,
+                (sufijo / plana - 1) * 100);
+    std::printf("decodificar con sufijo, --integridad  %7.2f ns/trama  (%+.1f%% frente a sin verificar)\n",
+                verificada, (verificada / sufijo - 1) * 100);
+
+    bool correcto = cargaCorrecta && huellaPlana == huellaSufijo && huellaSufijo == huellaVerificada && validas == tramas &&
+                    validasSolo == tramas;
+    if (!correcto) std::printf("ERROR: texto distinto o tramas rechazadas (%lld validas)\n", validas);
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file bench_latencia_serial.cpp
+ * @brief Latencia de extremo a extremo del puerto serial, con y sin el modo de baja latencia (usa un pty)
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Un hilo emisor escribe tramas "L,x" de una en una en el lado maestro de
+ * un pty; el receptor abre el lado esclavo con SerialPort y decodifica como
+ * ejecutarSerial (hilo lector, EnsambladorLineas, DecodificadorPRT7). La
+ * latencia de cada trama va desde justo antes de escribir su ultimo byte
+ * hasta que lineaCompleta devuelve con el caracter ya en la lista de carga.
+ * El emisor no manda la siguiente hasta que la anterior se decodifico,
+ * asi que se mide la latencia sin colas, y espera un intervalo entre
+ * tramas para que los hilos que esperan lleguen a dormirse.
+ *
+ * Se ejecuta en modo normal y en modo de baja latencia y se informan los
+ * percentiles 50, 99 y 99.9. En una maquina con menos de tres nucleos los
+ * hilos que sondean comparten procesador con el emisor y los resultados
+ * del modo de baja latencia no son representativos.
+ *
+ * Uso: prt7_bench_latencia_serial [tramas] [nucleo_lector] [nucleo_decodificador] [tiempo_real] [intervalo_us]
+ */
+
+#include "SerialPort.h"
+#include "EnsambladorLineas.h"
+#include "DecodificadorPRT7.h"
+#include "SalidaCarga.h"
+#include "TramaBase.h"
+#include "comun.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @brief Decodifica cada linea y anota el instante en que termino
+ */
+struct ReceptorMedido : public ReceptorLineas {
+    DecodificadorPRT7* decodificador = nullptr;
+    std::vector<long long>* llegadas = nullptr;
+    std::atomic<long long> decodificadas{0};
+
+    void lineaCompleta(const char* linea, int longitud) override {
+        decodificador->lineaCompleta(linea, longitud);
+        long long n = decodificadas.load(std::memory_order_relaxed);
+        if (n < (long long)llegadas->size()) (*llegadas)[n] = nanosegundos();
+        decodificadas.store(n + 1, std::memory_order_release);
+    }
+};
+
+/**
+ * @brief Lado emisor: una trama, espera a que se decodifique, pausa, siguiente
+ */
+struct Emisor {
+    int maestro = -1;
+    int intervaloUs = 200;
+    std::vector<long long>* envios = nullptr;
+    ReceptorMedido* receptor = nullptr;
+    std::atomic<bool> terminado{false};
+
+    void ejecutar() {
+        long long tramas = (long long)envios->size();
+        for (long long i = 0; i < tramas; i++) {
+            std::this_thread::sleep_for(std::chrono::microseconds(intervaloUs));
+            char trama[4] = { 'L', ',', (char)('A' + i % 26), '\n' };
+            // Los tres primeros bytes van antes: se mide desde el ultimo
+            if (::write(maestro, trama, 3) != 3) break;
+            (*envios)[i] = nanosegundos();
+            if (::write(maestro, trama + 3, 1) != 1) break;
+            long long limite = nanosegundos() + 1000000000LL;
+            while (receptor->decodificadas.load(std::memory_order_acquire) <= i && nanosegundos() < limite) {
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+            }
+        }
+        terminado = true;
+    }
+};
+
+/**
+ * @brief Mide una pasada completa
+ * @param bajaLatencia Configurar el puerto y el hilo receptor para sondear
+ * @return Tramas decodificadas
+ */
+static long long pasada(const char* nombre, bool bajaLatencia, long long tramas, int nucleoLector,
+                        int nucleoDecodificador, bool tiempoReal, int intervaloUs) {
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        std::perror("posix_openpt");
+        std::exit(2);
+    }
+
+    SerialPort puerto;
+    if (!puerto.abrir(ptsname(maestro), 115200, SerialPort::SIN_CONTROL)) {
+        std::fprintf(stderr, "No se pudo abrir %s\n", ptsname(maestro));
+        std::exit(2);
+    }
+    bool fijado = true;
+    SerialPort::EstadoHilo anterior;
+    anterior.guardado = false;
+    if (bajaLatencia) {
+        if (!puerto.configurarBajaLatencia(nucleoLector, tiempoReal)) {
+            std::fprintf(stderr, "El pty no admite lecturas no bloqueantes\n");
+            std::exit(2);
+        }
+        fijado = SerialPort::fijarHiloActual(nucleoDecodificador, tiempoReal, &anterior);
+    }
+    puerto.iniciarRecepcion();
+
+    std::vector<long long> envios((size_t)tramas, 0);
+    std::vector<long long> llegadas((size_t)tramas, 0);
+    SalidaNula salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 4096, 4096);
+    ReceptorMedido receptor;
+    receptor.decodificador = &decodificador;
+    receptor.llegadas = &llegadas;
+    EnsambladorLineas ensamblador;
+
+    Emisor emisor;
+    emisor.maestro = maestro;
+    emisor.intervaloUs = intervaloUs;
+    emisor.envios = &envios;
+    emisor.receptor = &receptor;
+    std::thread hilo(&Emisor::ejecutar, &emisor);
+
+    char bloque[256];
+    while (receptor.decodificadas.load(std::memory_order_relaxed) < tramas && !emisor.terminado) {
+        int n = puerto.leer(bloque, sizeof(bloque));
+        if (n < 0) break;
+        if (n > 0) ensamblador.alimentar(bloque, n, &receptor);
+    }
+    hilo.join();
+    puerto.cerrar();
+    ::close(maestro);
+    decodificador.finalizar();
+    SerialPort::restaurarHiloActual(anterior);
+
+    long long recibidas = receptor.decodificadas.load();
+    std::vector<double> latencias;
+    for (long long i = 0; i < recibidas && i < tramas; i++) {
+        latencias.push_back((double)(llegadas[(size_t)i] - envios[(size_t)i]) / 1000.0);
+    }
+    std::sort(latencias.begin(), latencias.end());
+    if (latencias.empty()) latencias.push_back(0);
+    size_t ultimo = latencias.size() - 1;
+    std::printf("%-14s %7lld tramas  p50 %8.1f us  p99 %8.1f us  p99.9 %8.1f us  max %9.1f us%s\n", nombre,
+                recibidas, latencias[ultimo * 50 / 100], latencias[ultimo * 99 / 100],
+                latencias[ultimo * 999 / 1000], latencias[ultimo], fijado ? "" : "  (sin fijar: permisos)");
+    return recibidas;
+}
+
+int main(int argc, char* argv[]) {
+    long long tramas = (argc > 1) ? std::atoll(argv[1]) : 20000;
+    int nucleos = (int)std::thread::hardware_concurrency();
+    // Por defecto el nucleo 0 queda para el emisor y el sistema
+    int nucleoLector = (argc > 2) ? std::atoi(argv[2]) : (nucleos >= 3 ? 1 : -1);
+    int nucleoDecodificador = (argc > 3) ? std::atoi(argv[3]) : (nucleos >= 3 ? 2 : -1);
+    bool tiempoReal = (argc > 4) && std::atoi(argv[4]) != 0;
+    int intervaloUs = (argc > 5) ? std::atoi(argv[5]) : 200;
+    TramaBase::setVerboso(false);
+
+    std::printf("%lld tramas de una en una, %d us entre tramas, %d nucleos; baja latencia: lector %d, "
+                "decodificador %d%s\n", tramas, intervaloUs, nucleos, nucleoLector, nucleoDecodificador,
+                tiempoReal ? ", SCHED_FIFO" : "");
+    if (nucleos < 3) {
+        std::printf("Aviso: con menos de 3 nucleos los hilos que sondean compiten con el emisor\n");
+    }
+    long long normal = pasada("normal", false, tramas, -1, -1, false, intervaloUs);
+    long long rapida = pasada("baja latencia", true, tramas, nucleoLector, nucleoDecodificador, tiempoReal,
+                              intervaloUs);
+    return (normal == tramas && rapida == tramas) ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file bench_lote.cpp
+ * @brief Limites de la trama por lotes "L*n," y caracteres por segundo segun baudios y lote
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Primero decodifica una tabla de lineas en los bordes del lote (n = 0,
+ * n > TramaLoad::MAX_LOTE, carga truncada, espacios finales, '\r' de
+ * CRLF, prefijos) y compara el texto con el esperado.
+ *
+ * Despues codifica un texto con CodificadorPRT7 en lotes de 1, 16 y
+ * MAX_LOTE caracteres, con y sin el prefijo "TX: " del eco del ESP32,
+ * mide los bytes por caracter que resultan y los convierte en caracteres
+ * por segundo a varios baudios con 8N1 (10 bits por byte). Cada flujo se
+ * decodifica de vuelta: el texto debe ser identico y se informa el costo
+ * del decodificador por caracter.
+ *
+ * Uso: prt7_bench_lote [lineas] [caracteres_por_linea]
+ */
+
+#include "CodificadorPRT7.h"
+#include "DecodificadorPRT7.h"
+#include "EnsambladorLineas.h"
+#include "TramaBase.h"
+#include "TramaLoad.h"
+#include "comun.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Junta el texto de un mensaje */
+struct SalidaTexto : public SalidaCarga {
+    std::string texto;
+    void escribir(const char* datos, int longitud) override { texto.append(datos, (size_t)longitud); }
+};
+
+/* Decodifica un flujo completo (lineas terminadas en '\n') */
+static void decodificar(const char* flujo, size_t longitud, SalidaCarga& salida) {
+    DecodificadorPRT7 decodificador;
+    decodificador.configurarVerboso(false);
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 4096, 4096);
+    EnsambladorLineas ensamblador;
+    const size_t bloque = 1 << 16;
+    for (size_t i = 0; i < longitud; i += bloque) {
+        size_t n = longitud - i;
+        if (n > bloque) n = bloque;
+        ensamblador.alimentar(flujo + i, (int)n, &decodificador);
+    }
+    ensamblador.terminar(&decodificador);
+    decodificador.finalizar();
+}
+
+struct Caso {
+    std::string linea;
+    std::string esperado; ///< Texto del mensaje; vacio si la linea no es trama
+    const char* nombre;
+};
+
+static bool probarLimites() {
+    std::string maximo(TramaLoad::MAX_LOTE, 'B');
+    std::string excedido(TramaLoad::MAX_LOTE + 1, 'B');
+    const Caso casos[] = {
+        {"L*1,Q", "Q", "lote de uno"},
+        {"L*0,", "", "n = 0"},
+        {"L*0,A", "", "n = 0 con carga"},
+        {"L*-1,A", "", "n negativo"},
+        {"L*,A", "", "sin n"},
+        {"L*" + std::to_string(TramaLoad::MAX_LOTE) + "," + maximo, maximo, "n = MAX_LOTE"},
+        {"L*" + std::to_string(TramaLoad::MAX_LOTE + 1) + "," + excedido, "", "n = MAX_LOTE + 1"},
+        {"L*9999999999,A", "", "n enorme"},
+        {"L*3,AB", "", "carga truncada"},
+        {"L*5,", "", "carga vacia"},
+        {"L*3,A  ", "A  ", "espacios finales como carga"},
+        {"L*3,A     ", "A  ", "espacios de mas despues de la carga"},
+        {"L*3,A  \r", "A  ", "'\\r' de CRLF despues de la carga"},
+        {"L*3,A \r", "", "el '\\r' de CRLF no completa la carga"},
+        {"L*3,A,]", "A,]", "coma y ']' dentro de la carga"},
+        {"[L*3,A,]]", "A,]", "entre corchetes"},
+        {"TX: [L*2,XY]", "XY", "eco TX:"},
+        {"@7 L*2,HI", "HI", "con marca de tiempo"},
+        {"L*02,AB", "AB", "n con cero a la izquierda"},
+        {"XL*2,AB", "", "precedida por una letra"},
+    };
+
+    bool correcto = true;
+    int fallidos = 0;
+    for (const Caso& c : casos) {
+        std::string flujo = c.linea + "\nF,\n";
+        SalidaTexto salida;
+        decodificar(flujo.data(), flujo.size(), salida);
+        if (salida.texto != c.esperado) {
+            std::printf("  ERROR %-40s esperado \"%s\", obtenido \"%s\"\n", c.nombre, c.esperado.c_str(),
+                        salida.texto.c_str());
+            correcto = false;
+            fallidos++;
+        }
+    }
+    int total = (int)(sizeof(casos) / sizeof(casos[0]));
+    std::printf("Limites del lote: %d de %d casos correctos\n", total - fallidos, total);
+    return correcto;
+}
+
+int main(int argc, char* argv[]) {
+    int lineas = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    int porLinea = (argc > 2) ? std::atoi(argv[2]) : 4000;
+    TramaBase::setVerboso(false);
+
+    bool correcto = probarLimites();
+
+    // Texto de letras y espacios; cada linea sera un mensaje ("F,")
+    std::string texto;
+    texto.reserve((size_t)lineas * (porLinea + 1));
+    unsigned long long referencia = HUELLA_INICIAL;
+    for (int l = 0; l < lineas; l++) {
+        size_t inicio = texto.size();
+        for (int i = 0; i < porLinea; i++) {
+            unsigned int r = aleatorio(32);
+            texto.push_back(r < 26 ? (char)('A' + r) : ' ');
+        }
+        referencia = mezclarHash(referencia, texto.data() + inicio, porLinea);
+        referencia = mezclarHash(referencia, "\n", 1);
+        texto.push_back('\n');
+    }
+    double caracteres = (double)lineas * porLinea;
+
+    const int lotes[3] = {1, 16, TramaLoad::MAX_LOTE};
+    const long baudios[4] = {9600, 57600, 115200, 921600};
+    double bytesPorCaracter[2][3];
+    std::vector<char> flujo(texto.size() * CodificadorPRT7::MAX_BYTES_POR_CARACTER);
+
+    std::printf("\n%d lineas de %d caracteres\n", lineas, porLinea);
+    std::printf("lote  bytes/car  con \"TX: \"  decodificar ns/car\n");
+    for (int k = 0; k < 3; k++) {
+        CodificadorPRT7 codificador;
+        codificador.configurarLote(lotes[k]);
+        size_t bytes = (size_t)codificador.codificar(texto.data(), (int)texto.size(), flujo.data());
+        long long tramas = 0;
+        for (size_t i = 0; i < bytes; i++) {
+            if (flujo[i] == '\n') tramas++;
+        }
+        bytesPorCaracter[0][k] = (double)bytes / caracteres;
+        bytesPorCaracter[1][k] = (double)(bytes + 4 * tramas) / caracteres;
+
+        SalidaHuella salida;
+        double inicio = segundos();
+        decodificar(flujo.data(), bytes, salida);
+        double ns = (segundos() - inicio) * 1e9 / caracteres;
+        bool igual = salida.hash == referencia;
+        correcto = correcto && igual;
+        std::printf("%4d  %9.3f  %11.3f  %18.1f%s\n", lotes[k], bytesPorCaracter[0][k], bytesPorCaracter[1][k], ns,
+                    igual ? "" : "  ERROR: texto distinto");
+    }
+
+    std::printf("\nCaracteres por segundo con 8N1\n");
+    std::printf("baudios    L,x   L*16  L*%d | TX: L,x  TX: L*16  TX: L*%d\n", TramaLoad::MAX_LOTE,
+                TramaLoad::MAX_LOTE);
+    for (long b : baudios) {
+        double bytesPorSegundo = b / 10.0;
+        std::printf("%7ld %6.0f %6.0f %6.0f | %7.0f %9.0f %10.0f\n", b, bytesPorSegundo / bytesPorCaracter[0][0],
+                    bytesPorSegundo / bytesPorCaracter[0][1], bytesPorSegundo / bytesPorCaracter[0][2],
+                    bytesPorSegundo / bytesPorCaracter[1][0], bytesPorSegundo / bytesPorCaracter[1][1],
+                    bytesPorSegundo / bytesPorCaracter[1][2]);
+    }
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file bench_mezcla.cpp
+ * @brief Throughput y memoria de MezcladorCapturas con cientos de capturas
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Escribe N capturas con marcas de tiempo crecientes y mensajes cortos
+ * cerrados con "F,", las decodifica una tras otra (referencia y velocidad
+ * de recorrido) y despues las mezcla. Comprueba que el texto de cada
+ * captura es identico al de la referencia y que las marcas de la linea de
+ * tiempo nunca retroceden. Se prueba con marcas entrelazadas (cada linea
+ * cambia de captura), con rangos de tiempo que casi no se solapan y con
+ * lineas de eco ("TX: @n L,x", "[@n L,x]") cuya marca tambien cuenta.
+ *
+ * Uso: prt7_bench_mezcla [capturas] [tramas_por_captura]
+ */
+
+#include "MezcladorCapturas.h"
+#include "DecodificadorPRT7.h"
+#include "SalidaCarga.h"
+#include "TramaBase.h"
+#include "comun.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <sys/resource.h>
+
+/**
+ * @brief Separa el texto por captura y vigila que las marcas no retrocedan
+ */
+struct LineaTiempoVerificada : public SalidaLineaTiempo {
+    std::vector<unsigned long long> hashes;
+    long long ultimaMarca = TramaBase::SIN_MARCA;
+    long long retrocesos = 0;
+    long long sinMarca = 0;
+    long long mensajes = 0;
+
+    void marca(long long m) {
+        if (m == TramaBase::SIN_MARCA) sinMarca++;
+        if (m < ultimaMarca) retrocesos++;
+        ultimaMarca = m;
+    }
+    void escribir(int flujo, long long m, const char* datos, int longitud) override {
+        marca(m);
+        hashes[flujo] = mezclarHash(hashes[flujo], datos, longitud);
+    }
+    void finMensaje(int flujo, long long m, bool vacio) override {
+        (void)vacio;
+        marca(m);
+        hashes[flujo] = mezclarHash(hashes[flujo], "\n", 1);
+        mensajes++;
+    }
+};
+
+/**
+ * @brief Escribe una captura con marcas crecientes
+ * @param separadas true para que cada captura ocupe casi sola su rango de tiempo
+ * @param eco true para envolver las lineas como ecos del emisor
+ * @return Bytes escritos
+ */
+static long long generar(const char* ruta, int numero, int capturas, int tramas, bool separadas, bool eco) {
+    static const char* const ANTES[3] = { "", "TX: ", "[" };
+    static const char* const DESPUES[3] = { "", "", "]" };
+    std::FILE* f = std::fopen(ruta, "wb");
+    if (f == nullptr) return -1;
+    long long marca = separadas ? (long long)numero * tramas * 500 : aleatorio(1000);
+    long long bytes = 0;
+    int restantes = 0;
+    for (int t = 0; t < tramas; t++) {
+        marca += 1 + aleatorio(separadas ? 600 : 1000 * (unsigned)capturas / 64 + 1);
+        char linea[64];
+        int forma = eco ? (int)aleatorio(3) : 0;
+        int n;
+        if (restantes == 0) {
+            n = std::sprintf(linea, "%s@%lld F,%s\n", ANTES[forma], marca, DESPUES[forma]);
+            restantes = 3 + (int)aleatorio(40);
+        } else if (aleatorio(8) == 0) {
+            n = std::sprintf(linea, "%s@%lld M,%d%s\n", ANTES[forma], marca, (int)aleatorio(51) - 25, DESPUES[forma]);
+        } else {
+            n = std::sprintf(linea, "%s@%lld L,%c%s\n", ANTES[forma], marca, 'A' + aleatorio(26), DESPUES[forma]);
+            restantes--;
+        }
+        std::fwrite(linea, 1, (size_t)n, f);
+        bytes += n;
+    }
+    std::fclose(f);
+    return bytes;
+}
+
+static long long memoriaMaximaKiB() {
+    rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return (long long)uso.ru_maxrss;
+}
+
+static bool ronda(int capturas, int tramas, bool separadas, bool eco) {
+    std::vector<std::vector<char>> rutas(capturas, std::vector<char>(64));
+    long long bytes = 0;
+    for (int i = 0; i < capturas; i++) {
+        std::snprintf(rutas[i].data(), 64, "prt7_bench_mezcla_%d.captura", i);
+        bytes += generar(rutas[i].data(), i, capturas, tramas, separadas, eco);
+    }
+
+    // Referencia: cada captura por separado, una tras otra
+    std::vector<unsigned long long> esperados(capturas);
+    double inicio = segundos();
+    for (int i = 0; i < capturas; i++) {
+        SalidaHuella huella;
+        DecodificadorPRT7 decodificador;
+        decodificador.inicializar();
+        decodificador.configurarVentana(&huella, 4096, 4096);
+        decodificador.ejecutarArchivo(rutas[i].data(), false);
+        decodificador.finalizar();
+        esperados[i] = huella.hash;
+    }
+    double secuencial = segundos() - inicio;
+
+    LineaTiempoVerificada linea;
+    linea.hashes.assign(capturas, HUELLA_INICIAL);
+    inicio = segundos();
+    long long lineas = 0;
+    {
+        MezcladorCapturas mezclador;
+        mezclador.configurarSesiones(4096, 4096, '\0');
+        mezclador.configurarSalida(&linea);
+        for (int i = 0; i < capturas; i++) {
+            if (mezclador.agregar(rutas[i].data()) < 0) {
+                std::fprintf(stderr, "No se pudo abrir %s\n", rutas[i].data());
+                return false;
+            }
+        }
+        mezclador.ejecutar();
+        lineas = mezclador.getLineas();
+    }
+    double mezcla = segundos() - inicio;
+
+    int distintas = 0;
+    for (int i = 0; i < capturas; i++) {
+        if (linea.hashes[i] != esperados[i]) distintas++;
+        std::remove(rutas[i].data());
+    }
+
+    std::printf("%4d capturas, marcas %-15s %6.1f MB, %9lld lineas: secuencial %6.3f s (%5.0f MB/s), "
+                "mezcla %6.3f s (%5.0f MB/s, %5.1f ns/linea), RSS maximo %lld KiB\n",
+                capturas, separadas ? "separadas," : eco ? "mezcladas, eco," : "mezcladas,", bytes / 1e6, lineas,
+                secuencial, bytes / 1e6 / secuencial, mezcla, bytes / 1e6 / mezcla,
+                mezcla * 1e9 / (double)lineas, memoriaMaximaKiB());
+    std::printf("     %lld mensajes, %d capturas con texto distinto de la referencia, %lld retrocesos de marca, "
+                "%lld volcados sin marca\n", linea.mensajes, distintas, linea.retrocesos, linea.sinMarca);
+    return distintas == 0 && linea.retrocesos == 0 && linea.sinMarca == 0;
+}
+
+int main(int argc, char* argv[]) {
+    int capturas = (argc > 1) ? std::atoi(argv[1]) : 256;
+    int tramas = (argc > 2) ? std::atoi(argv[2]) : 40000;
+    TramaBase::setVerboso(false);
+
+    bool correcto = ronda(capturas, tramas, false, false);
+    correcto = ronda(capturas, tramas, true, false) && correcto;
+    correcto = ronda(8, tramas * capturas / 8, false, false) && correcto;
+    correcto = ronda(8, tramas, false, true) && correcto;
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file bench_parser.cpp
+ * @brief Prueba diferencial y throughput de AutomataTramas frente al parser en cascada
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Conserva como referencia el parser de cascada de if que AutomataTramas
+ * reemplazo (solo la parte que reconoce, sin crear tramas). Primero
+ * compara ambos sobre lineas aleatorias de un alfabeto elegido para
+ * provocar casos limite (etiquetas seguidas, lotes truncados o enormes,
+ * prefijos TX: y @marca, corchetes, tabuladores); cualquier diferencia
+ * en tipo, dato o marca es un error. Despues mide ns por linea de cada
+ * uno sobre trafico mixto y sobre ruido.
+ *
+ * Uso: prt7_bench_parser [lineas_diferenciales] [lineas_medidas]
+ */
+
+#include "AutomataTramas.h"
+#include "RegistroTramas.h"
+#include "TramaLoad.h"
+#include "comun.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @brief Parser anterior: busca la trama con una cascada de comparaciones
+ * @param sonda Recibe 'L', 'B', 'M' o 'F'
+ */
+static bool reconocerCascada(const char* linea, int longitud, char& sonda, DatoTrama& dato, long long& marca) {
+    if (linea == nullptr || longitud <= 0) return false;
+    int inicio = 0;
+    while (inicio < longitud && (linea[inicio] == ' ' || linea[inicio] == '\t' || linea[inicio] == '[')) inicio++;
+    int fin = longitud;
+    while (fin > inicio && (linea[fin - 1] == ' ' || linea[fin - 1] == '\t' || linea[fin - 1] == '\r' || linea[fin - 1] == ']')) fin--;
+    if (fin - inicio >= 3 &&
+        (linea[inicio] == 'T' || linea[inicio] == 't') &&
+        (linea[inicio + 1] == 'X' || linea[inicio + 1] == 'x') &&
+        linea[inicio + 2] == ':') {
+        inicio += 3;
+        if (inicio < fin && linea[inicio] == ' ') inicio++;
+    }
+    marca = TramaBase::SIN_MARCA;
+    inicio += AutomataTramas::leerMarcaTiempo(linea + inicio, fin - inicio, marca);
+
+    dato = DatoTrama{' ', 0, nullptr, 0};
+    int i = inicio;
+    while (i < fin) {
+        char c = linea[i];
+        if (c == 'L' || c == 'l' || c == 'M' || c == 'm' || c == 'F' || c == 'f') {
+            if (i > inicio) {
+                char prev = linea[i - 1];
+                bool prevAlpha = (prev >= 'A' && prev <= 'Z') || (prev >= 'a' && prev <= 'z');
+                if (prevAlpha) { i++; continue; }
+            }
+            if ((c == 'L' || c == 'l') && i + 1 < fin && linea[i + 1] == '*') {
+                int q = i + 2;
+                int n = 0;
+                while (q < fin && linea[q] >= '0' && linea[q] <= '9' && n <= TramaLoad::MAX_LOTE) {
+                    n = n * 10 + (linea[q] - '0');
+                    q++;
+                }
+                if (q > i + 2 && q < fin && linea[q] == ',' &&
+                    n >= 1 && n <= TramaLoad::MAX_LOTE && q + 1 + n <= longitud) {
+                    sonda = 'B';
+                    dato.lote = linea + q + 1;
+                    dato.longitud = n;
+                    return true;
+                }
+                i++;
+                continue;
+            }
+            int j = i + 1;
+            while (j < fin && (linea[j] == ' ' || linea[j] == '\t')) j++;
+            if (j >= fin || linea[j] != ',') { i++; continue; }
+
+            char tipo = (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+            int p = j + 1;
+            while (p < fin && (linea[p] == ' ' || linea[p] == '\t')) p++;
+            sonda = tipo;
+            if (tipo == 'L') {
+                dato.caracter = (p >= fin) ? ' ' : linea[p];
+            } else if (tipo == 'M') {
+                dato.entero = AutomataTramas::leerEntero(linea + p, fin - p);
+            }
+            return true;
+        }
+        i++;
+    }
+    return false;
+}
+
+/**
+ * @brief Lineas guardadas de corrido en un solo arreglo
+ */
+struct Lineas {
+    std::vector<char> texto;
+    std::vector<int> inicios;
+
+    void agregar(const char* linea, int longitud) {
+        inicios.push_back((int)texto.size());
+        texto.insert(texto.end(), linea, linea + longitud);
+    }
+    int cantidad() const { return (int)inicios.size(); }
+    const char* linea(int i) const { return texto.data() + inicios[i]; }
+    int longitud(int i) const {
+        int fin = (i + 1 < cantidad()) ? inicios[i + 1] : (int)texto.size();
+        return fin - inicios[i];
+    }
+};
+
+/* Lineas cortas de un alfabeto que provoca casos limite */
+static int generarAdversaria(char* linea) {
+    static const char alfabeto[] = "LlMmFf*,,  \t0123456789[]@TX:\rax-+";
+    const int simbolos = (int)sizeof(alfabeto) - 1;
+    int largo = (int)aleatorio(24);
+    for (int i = 0; i < largo; i++) linea[i] = alfabeto[aleatorio((unsigned int)simbolos)];
+    // A veces un lote casi valido
+    if (largo > 4 && aleatorio(4) == 0) {
+        linea[0] = 'L';
+        linea[1] = '*';
+        linea[2] = (char)('0' + aleatorio(10));
+    }
+    return largo;
+}
+
+/* Trafico como el de una captura: sobre todo L y M, algo de lotes, ecos, marcas y ruido */
+static int generarMixta(char* linea, bool soloRuido) {
+    unsigned int tipo = soloRuido ? 999 : aleatorio(1000);
+    int n = 0;
+    if (tipo < 650) {
+        n = std::sprintf(linea, "L,%c", 'A' + aleatorio(26));
+    } else if (tipo < 800) {
+        n = std::sprintf(linea, "M,%d", (int)aleatorio(51) - 25);
+    } else if (tipo < 850) {
+        int largo = 1 + (int)aleatorio(TramaLoad::MAX_LOTE);
+        n = std::sprintf(linea, "L*%d,", largo);
+        for (int i = 0; i < largo; i++) linea[n++] = (char)('A' + aleatorio(26));
+    } else if (tipo < 852) {
+        n = std::sprintf(linea, "F,");
+    } else if (tipo < 900) {
+        n = std::sprintf(linea, "TX: [L,%c]\r", 'A' + aleatorio(26));
+    } else if (tipo < 950) {
+        n = std::sprintf(linea, "@%u L,%c", 1000 + aleatorio(1000000), 'A' + aleatorio(26));
+    } else {
+        int largo = (int)aleatorio(40);
+        for (int i = 0; i < largo; i++) linea[n++] = (char)('a' + aleatorio(26));
+    }
+    return n;
+}
+
+static double medir(const Lineas& lineas, bool automata, long long& huella) {
+    double mejor = 1e30;
+    for (int repeticion = 0; repeticion < 5; repeticion++) {
+        long long suma = 0;
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        for (int i = 0; i < lineas.cantidad(); i++) {
+            if (automata) {
+                TramaReconocida r;
+                if (AutomataTramas::reconocer(lineas.linea(i), lineas.longitud(i), r)) {
+                    suma += REGISTRO_TRAMAS[r.tipo].sonda + r.valor;
+                }
+            } else {
+                char sonda = 0;
+                DatoTrama dato;
+                long long marca;
+                if (reconocerCascada(lineas.linea(i), lineas.longitud(i), sonda, dato, marca)) {
+                    int valor = (sonda == 'B') ? dato.longitud : (sonda == 'M') ? dato.entero
+                              : (sonda == 'L') ? dato.caracter : 0;
+                    suma += sonda + valor;
+                }
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count();
+        mejor = std::min(mejor, ns / lineas.cantidad());
+        huella = suma;
+    }
+    return mejor;
+}
+
+int main(int argc, char* argv[]) {
+    int diferenciales = (argc > 1) ? std::atoi(argv[1]) : 2000000;
+    int medidas = (argc > 2) ? std::atoi(argv[2]) : 2000000;
+
+    // Prueba diferencial
+    long long diferencias = 0;
+    long long aceptadas = 0;
+    char linea[256];
+    for (int l = 0; l < diferenciales; l++) {
+        int n = (l % 2 == 0) ? generarAdversaria(linea) : generarMixta(linea, false);
+        char sonda = 0;
+        DatoTrama dato;
+        long long marca = 0;
+        TramaReconocida r;
+        bool esperada = reconocerCascada(linea, n, sonda, dato, marca);
+        bool obtenida = AutomataTramas::reconocer(linea, n, r);
+        bool igual = (esperada == obtenida);
+        if (igual && esperada) {
+            aceptadas++;
+            const TipoTrama& tipo = REGISTRO_TRAMAS[r.tipo];
+            igual = tipo.sonda == sonda && r.marca == marca &&
+                    (sonda != 'L' || r.dato.caracter == dato.caracter) &&
+                    (sonda != 'M' || r.dato.entero == dato.entero) &&
+                    (sonda != 'B' || (r.dato.lote == dato.lote && r.dato.longitud == dato.longitud));
+        }
+        if (!igual) {
+            if (diferencias < 5) {
+                std::printf("DIFERENCIA en [");
+                std::fwrite(linea, 1, (size_t)n, stdout);
+                std::printf("]: cascada %d, automata %d\n", esperada ? 1 : 0, obtenida ? 1 : 0);
+            }
+            diferencias++;
+        }
+    }
+    std::printf("diferencial: %d lineas, %lld tramas, %lld diferencias\n", diferenciales, aceptadas, diferencias);
+
+    // Throughput
+    const char* nombres[2] = {"trafico mixto", "solo ruido"};
+    for (int modo = 0; modo < 2; modo++) {
+        Lineas lineas;
+        for (int l = 0; l < medidas; l++) {
+            int n = generarMixta(linea, modo == 1);
+            lineas.agregar(linea, n);
+        }
+        long long huellaCascada = 0;
+        long long huellaAutomata = 0;
+        double cascada = medir(lineas, false, huellaCascada);
+        double automata = medir(lineas, true, huellaAutomata);
+        std::printf("%-14s cascada %6.2f ns/linea, automata %6.2f ns/linea (%+.1f%%)%s\n", nombres[modo], cascada,
+                    automata, (automata / cascada - 1) * 100, huellaCascada == huellaAutomata ? "" : " HUELLA DISTINTA");
+        if (huellaCascada != huellaAutomata) diferencias++;
+    }
+    return diferencias == 0 ? 0 : 1;
+}
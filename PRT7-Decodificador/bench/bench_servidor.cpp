@@ -0,0 +1,267 @@
+/**
+ * @file bench_servidor.cpp
+ * @brief Carga de ServidorPRT7 con miles de clientes locales y salida verificable
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Un proceso hijo ejecuta el servidor en un socket Unix con la salida
+ * estandar en un archivo. El padre abre miles de conexiones a la vez y en
+ * cada ronda manda a cada una un trozo de su captura, asi los mensajes
+ * quedan a medias mientras escriben las demas sesiones. Al terminar, cada
+ * cliente cierra su lado de escritura y espera a que el servidor cierre el
+ * suyo: en ese momento la sesion ya entrego todo su texto.
+ *
+ * La salida se rearma por sesion ("[id] " abre un mensaje, "[id]+ " lo
+ * continua) y se compara con lo que produce un decodificador local con la
+ * misma captura. Como los id dependen del orden de aceptacion, se comparan
+ * las huellas de las sesiones ordenadas. Todo renglon debe llevar prefijo.
+ *
+ * Uso: prt7_bench_servidor [clientes] [rondas] [tramas_por_ronda]
+ */
+
+#include "ServidorPRT7.h"
+#include "DecodificadorPRT7.h"
+#include "TramaBase.h"
+#include "comun.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const char* RUTA_SOCKET = "/tmp/prt7_bench_servidor.sock";
+static const char* RUTA_SALIDA = "prt7_bench_servidor.salida";
+static const int VENTANA = 8; ///< Ventana y lote chicos: cada mensaje sale en varios lotes
+
+/* Mensajes de una sesion, cada uno cerrado por finMensaje */
+struct SalidaMensajes : public SalidaCarga {
+    std::vector<std::string> mensajes;
+    bool abierto = false;
+    void escribir(const char* datos, int longitud) override {
+        if (!abierto) mensajes.emplace_back();
+        abierto = true;
+        mensajes.back().append(datos, (size_t)longitud);
+    }
+    void finMensaje() override {
+        if (!abierto) mensajes.emplace_back();
+        abierto = false;
+    }
+};
+
+/* Huella de una lista de mensajes */
+static unsigned long long huellaMensajes(const std::vector<std::string>& mensajes) {
+    unsigned long long hash = HUELLA_INICIAL;
+    for (const std::string& m : mensajes) {
+        hash = mezclarHash(hash, m.data(), (int)m.size());
+        hash = mezclarHash(hash, "\n", 1);
+    }
+    return hash;
+}
+
+/* Captura de un cliente: cargas, rotaciones y fines de mensaje, partida en rondas */
+static std::vector<std::string> generarCaptura(int rondas, int tramas) {
+    std::vector<std::string> trozos((size_t)rondas);
+    char linea[32];
+    for (int r = 0; r < rondas; r++) {
+        for (int t = 0; t < tramas; t++) {
+            unsigned int tipo = aleatorio(100);
+            if (tipo < 80) {
+                std::snprintf(linea, sizeof(linea), "L,%c\n", 'A' + aleatorio(26));
+            } else if (tipo < 93) {
+                std::snprintf(linea, sizeof(linea), "M,%d\n", (int)aleatorio(11) - 5);
+            } else {
+                std::snprintf(linea, sizeof(linea), "F,\n");
+            }
+            trozos[(size_t)r] += linea;
+        }
+    }
+    return trozos;
+}
+
+/* Lo que el servidor deberia entregar para una captura */
+static unsigned long long esperado(const std::vector<std::string>& trozos) {
+    SalidaMensajes salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, VENTANA, VENTANA);
+    EnsambladorLineas ensamblador;
+    for (const std::string& t : trozos) ensamblador.alimentar(t.data(), (int)t.size(), &decodificador);
+    ensamblador.terminar(&decodificador);
+    decodificador.finalizar();
+    return huellaMensajes(salida.mensajes);
+}
+
+static int conectar() {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    sockaddr_un direccion;
+    std::memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    std::strncpy(direccion.sun_path, RUTA_SOCKET, sizeof(direccion.sun_path) - 1);
+    if (connect(fd, (sockaddr*)&direccion, sizeof(direccion)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool escribirTodo(int fd, const std::string& datos) {
+    size_t hecho = 0;
+    while (hecho < datos.size()) {
+        ssize_t n = write(fd, datos.data() + hecho, datos.size() - hecho);
+        if (n <= 0) return false;
+        hecho += (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Rearma los mensajes de cada sesion desde la salida del servidor
+ * @return false si algun renglon no tiene prefijo
+ */
+static bool rearmar(const char* ruta, std::vector<std::vector<std::string>>& sesiones, long long& continuaciones) {
+    std::FILE* f = std::fopen(ruta, "rb");
+    if (f == nullptr) return false;
+    std::string renglon;
+    bool correcto = true;
+    int c;
+    while ((c = std::fgetc(f)) != EOF) {
+        if (c != '\n') {
+            renglon += (char)c;
+            continue;
+        }
+        if (renglon.empty()) renglon = "?";
+        int id = 0;
+        size_t i = 1;
+        while (i < renglon.size() && renglon[i] >= '0' && renglon[i] <= '9') id = id * 10 + (renglon[i++] - '0');
+        bool continua = renglon.compare(i, 3, "]+ ") == 0;
+        bool abre = !continua && renglon.compare(i, 2, "] ") == 0;
+        if (renglon[0] != '[' || id <= 0 || (!abre && !continua)) {
+            correcto = false;
+        } else {
+            if ((size_t)id >= sesiones.size()) sesiones.resize((size_t)id + 1);
+            std::vector<std::string>& mensajes = sesiones[(size_t)id];
+            if (abre || mensajes.empty()) mensajes.emplace_back();
+            if (continua) continuaciones++;
+            mensajes.back() += renglon.substr(i + (continua ? 3 : 2));
+        }
+        renglon.clear();
+    }
+    std::fclose(f);
+    return correcto && renglon.empty();
+}
+
+int main(int argc, char* argv[]) {
+    int clientes = (argc > 1) ? std::atoi(argv[1]) : 4000;
+    int rondas = (argc > 2) ? std::atoi(argv[2]) : 4;
+    int tramas = (argc > 3) ? std::atoi(argv[3]) : 24;
+    TramaBase::setVerboso(false);
+
+    // Un descriptor por cliente en cada proceso
+    rlimit limite;
+    getrlimit(RLIMIT_NOFILE, &limite);
+    if (limite.rlim_cur < (rlim_t)clientes + 64) {
+        limite.rlim_cur = (limite.rlim_max < (rlim_t)clientes + 64) ? limite.rlim_max : (rlim_t)clientes + 64;
+        setrlimit(RLIMIT_NOFILE, &limite);
+    }
+    if (limite.rlim_cur < (rlim_t)clientes + 64) {
+        clientes = (int)limite.rlim_cur - 64;
+        std::printf("Limite de descriptores: se usan %d clientes\n", clientes);
+    }
+
+    std::vector<std::vector<std::string>> capturas((size_t)clientes);
+    std::vector<unsigned long long> esperadas((size_t)clientes);
+    for (int c = 0; c < clientes; c++) {
+        capturas[(size_t)c] = generarCaptura(rondas, tramas);
+        esperadas[(size_t)c] = esperado(capturas[(size_t)c]);
+    }
+
+    unlink(RUTA_SOCKET);
+    pid_t hijo = fork();
+    if (hijo < 0) {
+        std::perror("fork");
+        return 2;
+    }
+    if (hijo == 0) {
+        int salida = open(RUTA_SALIDA, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        if (salida < 0 || dup2(salida, 1) < 0) _exit(2);
+        close(salida);
+        ServidorPRT7 servidor;
+        servidor.configurarSesiones(VENTANA, VENTANA, '\0');
+        if (!servidor.escucharUnix(RUTA_SOCKET)) _exit(2);
+        servidor.ejecutar();
+        _exit(0);
+    }
+
+    double inicio = segundos();
+    std::vector<int> fds((size_t)clientes, -1);
+    for (int c = 0; c < clientes; c++) {
+        // El servidor puede no estar escuchando todavia
+        for (int intento = 0; intento < 2000 && fds[(size_t)c] < 0; intento++) {
+            fds[(size_t)c] = conectar();
+            if (fds[(size_t)c] < 0) usleep(1000);
+        }
+        if (fds[(size_t)c] < 0) {
+            std::fprintf(stderr, "No se pudo conectar el cliente %d\n", c);
+            kill(hijo, SIGTERM);
+            return 2;
+        }
+    }
+    long long bytes = 0;
+    for (int r = 0; r < rondas; r++) {
+        for (int c = 0; c < clientes; c++) {
+            const std::string& trozo = capturas[(size_t)c][(size_t)r];
+            if (!escribirTodo(fds[(size_t)c], trozo)) {
+                std::fprintf(stderr, "Fallo la escritura del cliente %d\n", c);
+            }
+            bytes += (long long)trozo.size();
+        }
+    }
+    // El servidor cierra su lado cuando la sesion ya entrego todo
+    char basura[64];
+    for (int c = 0; c < clientes; c++) {
+        shutdown(fds[(size_t)c], SHUT_WR);
+    }
+    for (int c = 0; c < clientes; c++) {
+        while (read(fds[(size_t)c], basura, sizeof(basura)) > 0) {
+        }
+        close(fds[(size_t)c]);
+    }
+    double tiempo = segundos() - inicio;
+    kill(hijo, SIGTERM);
+    int estado = 0;
+    waitpid(hijo, &estado, 0);
+
+    std::vector<std::vector<std::string>> sesiones;
+    long long continuaciones = 0;
+    bool prefijos = rearmar(RUTA_SALIDA, sesiones, continuaciones);
+    std::vector<unsigned long long> obtenidas;
+    for (size_t id = 1; id < sesiones.size(); id++) {
+        if (!sesiones[id].empty()) obtenidas.push_back(huellaMensajes(sesiones[id]));
+    }
+    // Una captura sin texto no deja renglones
+    std::vector<unsigned long long> vacias;
+    std::vector<std::string> ninguno;
+    unsigned long long huellaVacia = huellaMensajes(ninguno);
+    for (unsigned long long h : esperadas) {
+        if (h != huellaVacia) vacias.push_back(h);
+    }
+    std::sort(obtenidas.begin(), obtenidas.end());
+    std::sort(vacias.begin(), vacias.end());
+    bool iguales = (obtenidas == vacias);
+
+    std::printf("%d clientes a la vez, %d rondas, %.1f MB en %.3f s (%.0f tramas/s)\n", clientes, rondas, bytes / 1e6,
+                tiempo, (double)clientes * rondas * tramas / tiempo);
+    std::printf("%lld renglones de continuacion; renglones sin prefijo: %s; sesiones %s a la referencia\n",
+                continuaciones, prefijos ? "ninguno" : "SI", iguales ? "identicas" : "DISTINTAS");
+    std::remove(RUTA_SALIDA);
+    return (prefijos && iguales && WIFEXITED(estado) && WEXITSTATUS(estado) == 0) ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file bench_sesion_asincrona.cpp
+ * @brief Miles de SesionAsincrona intercaladas en un EjecutorCola (compilacion PRT7_CORRUTINAS)
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Cada sesion tiene una corrutina productora, que alimenta su captura en
+ * bloques de tamanio aleatorio y cede el turno despues de cada uno, y una
+ * consumidora que junta los mensajes. Un limite de pendientes chico obliga
+ * a la contrapresion. Los mensajes de cada sesion se comparan con los de
+ * un DecodificadorPRT7 sincrono sobre la misma captura.
+ *
+ * El modo verboso global queda activo y la salida estandar se redirige a
+ * un archivo mientras corren las sesiones: la API asincrona no debe
+ * escribir ni un byte en ella.
+ *
+ * Uso: prt7_bench_sesion_asincrona [sesiones] [tramas_por_sesion]
+ */
+
+#include "SesionAsincrona.h"
+#include "DecodificadorPRT7.h"
+#include "EnsambladorLineas.h"
+#include "comun.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char* RUTA_SALIDA = "prt7_bench_sesion_asincrona.salida";
+
+/* Mensajes con la misma semantica que SesionAsincrona */
+struct SalidaMensajes : public SalidaCarga {
+    std::vector<std::string> mensajes;
+    std::string actual;
+    void escribir(const char* datos, int longitud) override { actual.append(datos, (size_t)longitud); }
+    void finMensaje() override {
+        mensajes.push_back(actual);
+        actual.clear();
+    }
+};
+
+/* Espera que devuelve el turno al ejecutor */
+struct CederTurno {
+    EjecutorCola* ejecutor;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) noexcept { ejecutor->programar(h); }
+    void await_resume() const noexcept {}
+};
+
+static std::string generarCaptura(int tramas) {
+    std::string captura;
+    char linea[32];
+    for (int t = 0; t < tramas; t++) {
+        unsigned int tipo = aleatorio(100);
+        if (tipo < 80) {
+            std::snprintf(linea, sizeof(linea), "L,%c\n", 'A' + aleatorio(26));
+        } else if (tipo < 92) {
+            std::snprintf(linea, sizeof(linea), "M,%d\n", (int)aleatorio(11) - 5);
+        } else {
+            std::snprintf(linea, sizeof(linea), "F,\n");
+        }
+        captura += linea;
+    }
+    return captura;
+}
+
+static std::vector<std::string> referencia(const std::string& captura) {
+    SalidaMensajes salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.configurarVerboso(false);
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, 256, 256);
+    EnsambladorLineas ensamblador;
+    ensamblador.alimentar(captura.data(), (int)captura.size(), &decodificador);
+    ensamblador.terminar(&decodificador);
+    decodificador.finalizar();
+    return salida.mensajes;
+}
+
+static TareaPRT7 producir(SesionAsincrona& sesion, EjecutorCola& ejecutor, const std::string& captura) {
+    size_t i = 0;
+    while (i < captura.size()) {
+        size_t n = 1 + aleatorio(64);
+        if (n > captura.size() - i) n = captura.size() - i;
+        co_await sesion.alimentar(captura.data() + i, (int)n);
+        i += n;
+        co_await CederTurno{&ejecutor};
+    }
+    sesion.cerrar();
+}
+
+static TareaPRT7 consumir(SesionAsincrona& sesion, std::vector<std::string>& recibidos) {
+    while (true) {
+        MensajeDecodificado m = co_await sesion.siguienteMensaje();
+        if (m.texto == nullptr) break;
+        recibidos.emplace_back(m.texto, (size_t)m.longitud);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int sesiones = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    int tramas = (argc > 2) ? std::atoi(argv[2]) : 400;
+
+    std::vector<std::string> capturas((size_t)sesiones);
+    for (std::string& c : capturas) c = generarCaptura(tramas);
+
+    EjecutorCola ejecutor;
+    std::vector<SesionAsincrona*> activas;
+    std::vector<std::vector<std::string>> recibidos((size_t)sesiones);
+    std::vector<TareaPRT7> tareas;
+    tareas.reserve((size_t)sesiones * 2);
+
+    // Todo lo que se escriba en la salida estandar a partir de aqui va al archivo
+    std::cout.flush();
+    std::fflush(stdout);
+    int consola = dup(1);
+    int archivo = open(RUTA_SALIDA, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (consola < 0 || archivo < 0 || dup2(archivo, 1) < 0) {
+        std::perror("redirigir la salida estandar");
+        return 2;
+    }
+    close(archivo);
+
+    double inicio = segundos();
+    for (int s = 0; s < sesiones; s++) {
+        activas.push_back(new SesionAsincrona(&ejecutor, 2));
+        tareas.push_back(consumir(*activas.back(), recibidos[(size_t)s]));
+        tareas.back().iniciar();
+        tareas.push_back(producir(*activas.back(), ejecutor, capturas[(size_t)s]));
+        tareas.back().iniciar();
+    }
+    long long reanudadas = ejecutor.ejecutarPendientes();
+    double tiempo = segundos() - inicio;
+
+    std::cout.flush();
+    std::fflush(stdout);
+    dup2(consola, 1);
+    close(consola);
+    struct stat estado;
+    long long escritos = (stat(RUTA_SALIDA, &estado) == 0) ? (long long)estado.st_size : -1;
+    std::remove(RUTA_SALIDA);
+
+    int terminadas = 0;
+    int distintas = 0;
+    long long mensajes = 0;
+    for (const TareaPRT7& t : tareas) {
+        if (t.terminada()) terminadas++;
+    }
+    for (int s = 0; s < sesiones; s++) {
+        if (recibidos[(size_t)s] != referencia(capturas[(size_t)s])) distintas++;
+        mensajes += (long long)recibidos[(size_t)s].size();
+        delete activas[(size_t)s];
+    }
+
+    std::printf("%d sesiones, %lld mensajes, %lld reanudaciones en %.3f s (%.0f tramas/s)\n", sesiones, mensajes,
+                reanudadas, tiempo, (double)sesiones * tramas / tiempo);
+    std::printf("corrutinas terminadas %d de %d; sesiones distintas de la referencia %d; "
+                "bytes en la salida estandar %lld\n",
+                terminadas, (int)tareas.size(), distintas, escritos);
+    return (terminadas == (int)tareas.size() && distintas == 0 && escritos == 0) ? 0 : 1;
+}
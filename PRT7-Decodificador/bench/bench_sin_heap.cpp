@@ -0,0 +1,169 @@
+/**
+ * @file bench_sin_heap.cpp
+ * @brief Asignaciones de memoria y latencia por linea del decodificador en regimen
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Reemplaza operator new/delete para contarlos (con PRT7_PERFIL_MEMORIA
+ * usa los contadores de la biblioteca, que ya los reemplaza), prepara en memoria una
+ * mezcla de tramas LOAD, MAP, lotes, FIN, ecos TX y marcas de tiempo, y la
+ * decodifica con procesarLinea() midiendo cada llamada. Tras una pasada de
+ * calentamiento cuenta las asignaciones de la pasada medida: con
+ * PRT7_SIN_HEAP deben ser cero. Se ejecuta con ventana acotada y con
+ * ventana 0 (que con PRT7_SIN_HEAP obliga a desbordar la lista); la
+ * huella del texto debe coincidir entre ambas y entre compilaciones.
+ *
+ * Uso: prt7_bench_sin_heap [lineas]
+ */
+
+#include "DecodificadorPRT7.h"
+#include "ListaDeCarga.h"
+#include "PerfilMemoria.h"
+#include "SalidaCarga.h"
+#include "TramaBase.h"
+#include "TramaLoad.h"
+#include "comun.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#ifdef PRT7_PERFIL_MEMORIA
+static long long contarAsignaciones() { return PerfilMemoria::getAsignaciones(); }
+#else
+static long long asignaciones = 0;
+static long long contarAsignaciones() { return asignaciones; }
+
+void* operator new(std::size_t tam) {
+    asignaciones++;
+    void* p = std::malloc(tam > 0 ? tam : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t tam) {
+    asignaciones++;
+    void* p = std::malloc(tam > 0 ? tam : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+/**
+ * @brief Lineas de prueba guardadas de corrido en un solo arreglo
+ */
+struct Lineas {
+    std::vector<char> texto;
+    std::vector<int> inicios;
+
+    void agregar(const char* linea, int longitud) {
+        inicios.push_back((int)texto.size());
+        texto.insert(texto.end(), linea, linea + longitud);
+    }
+    int cantidad() const { return (int)inicios.size(); }
+    const char* linea(int i) const { return texto.data() + inicios[i]; }
+    int longitud(int i) const {
+        int fin = (i + 1 < cantidad()) ? inicios[i + 1] : (int)texto.size();
+        return fin - inicios[i];
+    }
+};
+
+static void generar(Lineas& lineas, int cantidad) {
+    char linea[256];
+    long long marca = 1000;
+    for (int l = 0; l < cantidad; l++) {
+        unsigned int tipo = aleatorio(1000);
+        int n = 0;
+        if (tipo < 650) {
+            n = std::sprintf(linea, "L,%c", 'A' + aleatorio(26));
+        } else if (tipo < 800) {
+            n = std::sprintf(linea, "M,%d", (int)aleatorio(51) - 25);
+        } else if (tipo < 850) {
+            int largo = 1 + (int)aleatorio(TramaLoad::MAX_LOTE);
+            n = std::sprintf(linea, "L*%d,", largo);
+            for (int i = 0; i < largo; i++) linea[n++] = (char)('A' + aleatorio(26));
+        } else if (tipo < 852) {
+            n = std::sprintf(linea, "F,");
+        } else if (tipo < 900) {
+            n = std::sprintf(linea, "TX: [L,%c]\r", 'A' + aleatorio(26));
+        } else if (tipo < 950) {
+            marca += 1 + aleatorio(100);
+            n = std::sprintf(linea, "@%lld L,%c", marca, 'A' + aleatorio(26));
+        } else {
+            // Ruido que no es trama
+            int largo = (int)aleatorio(40);
+            for (int i = 0; i < largo; i++) linea[n++] = (char)('a' + aleatorio(26));
+        }
+        lineas.agregar(linea, n);
+    }
+}
+
+static bool ronda(const Lineas& lineas, int ventana, int lote, unsigned long long& huella) {
+    SalidaHuella salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, ventana, lote);
+
+    // Calentamiento: la primera pasada puede reservar lo que le falte
+    int mitad = lineas.cantidad() / 2;
+    for (int i = 0; i < mitad; i++) {
+        decodificador.procesarLinea(lineas.linea(i), lineas.longitud(i));
+    }
+
+    std::vector<long long> latencias((size_t)(lineas.cantidad() - mitad));
+    long long antes = contarAsignaciones();
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    for (int i = mitad; i < lineas.cantidad(); i++) {
+        decodificador.procesarLinea(lineas.linea(i), lineas.longitud(i));
+        std::chrono::steady_clock::time_point fin = std::chrono::steady_clock::now();
+        latencias[(size_t)(i - mitad)] = std::chrono::duration_cast<std::chrono::nanoseconds>(fin - inicio).count();
+        inicio = fin;
+    }
+    long long enRegimen = contarAsignaciones() - antes;
+    decodificador.finalizar();
+    huella = salida.hash;
+
+    std::sort(latencias.begin(), latencias.end());
+    size_t n = latencias.size();
+    double total = 0;
+    for (size_t i = 0; i < n; i++) total += (double)latencias[i];
+    std::printf("ventana %5d lote %5d: %lld asignaciones en %zu lineas medidas (%.3f por linea); "
+                "ns/linea media %.0f, p50 %lld, p99 %lld, p99.99 %lld, max %lld; "
+                "descartados %lld; huella %016llx\n",
+                ventana, lote, enRegimen, n, (double)enRegimen / (double)n, total / (double)n,
+                latencias[n / 2], latencias[n * 99 / 100], latencias[n * 9999 / 10000], latencias[n - 1],
+                decodificador.getTotalDescartados(), huella);
+    return ListaDeCarga::getCapacidad() == 0 || enRegimen == 0;
+}
+
+int main(int argc, char* argv[]) {
+    int cantidad = (argc > 1) ? std::atoi(argv[1]) : 2000000;
+    TramaBase::setVerboso(false);
+
+    Lineas lineas;
+    generar(lineas, cantidad);
+    if (ListaDeCarga::getCapacidad() > 0) {
+        std::printf("Compilacion PRT7_SIN_HEAP: lista de %d nodos, decodificador de %zu bytes\n",
+                    ListaDeCarga::getCapacidad(), sizeof(DecodificadorPRT7));
+    } else {
+        std::printf("Compilacion con memoria dinamica: decodificador de %zu bytes\n", sizeof(DecodificadorPRT7));
+    }
+
+    unsigned long long acotada = 0;
+    unsigned long long sinLimite = 0;
+    bool correcto = ronda(lineas, 4096, 4096, acotada);
+    correcto = ronda(lineas, 0, 4096, sinLimite) && correcto;
+    if (acotada != sinLimite) {
+        std::printf("ERROR: el texto cambia con la ventana\n");
+        correcto = false;
+    }
+    if (!correcto) std::printf("ERROR: hubo asignaciones en regimen\n");
+    return correcto ? 0 : 1;
+}
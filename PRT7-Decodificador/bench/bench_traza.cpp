@@ -0,0 +1,134 @@
+/**
+ * @file bench_traza.cpp
+ * @brief Costo de TrazadorPRT7 por linea: sin traza, muestreada y trazando todo
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Decodifica la misma captura generada por EnsambladorLineas y
+ * DecodificadorPRT7::lineaCompleta (el camino de la entrada estandar, el
+ * serial y el servidor) sin traza, con 1 de cada 1000 tramas y con todas.
+ * De cada configuracion se toma la mejor de varias repeticiones. El texto
+ * debe ser identico en todas y las pasadas con traza deben dejar tramos en
+ * el archivo; los descartados (anillo lleno entre dos volcados) se
+ * informan.
+ *
+ * Uso: prt7_bench_traza [tramas] [repeticiones]
+ */
+
+#include "DecodificadorPRT7.h"
+#include "EnsambladorLineas.h"
+#include "TrazadorPRT7.h"
+#include "TramaBase.h"
+#include "comun.h"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static const char* RUTA_TRAZA = "prt7_bench_traza.json";
+static const int BLOQUE = 1 << 16;
+
+/* Lineas como las de una captura: cargas, rotaciones y algun fin de mensaje */
+static std::vector<char> generarCaptura(long long tramas) {
+    std::vector<char> datos;
+    datos.reserve((size_t)tramas * 5);
+    char linea[32];
+    for (long long t = 0; t < tramas; t++) {
+        unsigned int tipo = aleatorio(100);
+        int n;
+        if (tipo < 80) {
+            n = std::snprintf(linea, sizeof(linea), "L,%c\n", 'A' + aleatorio(26));
+        } else if (tipo < 98) {
+            n = std::snprintf(linea, sizeof(linea), "M,%d\n", (int)aleatorio(11) - 5);
+        } else {
+            n = std::snprintf(linea, sizeof(linea), "F,\n");
+        }
+        datos.insert(datos.end(), linea, linea + n);
+    }
+    return datos;
+}
+
+/* Renglones del archivo de traza: uno por tramo mas el corchete inicial */
+static long long contarTramos(const char* ruta) {
+    std::FILE* f = std::fopen(ruta, "rb");
+    if (f == nullptr) return 0;
+    long long renglones = 0;
+    int c;
+    while ((c = std::fgetc(f)) != EOF) {
+        if (c == '\n') renglones++;
+    }
+    std::fclose(f);
+    // El ultimo tramo no lleva salto de linea; el corchete si
+    return renglones;
+}
+
+/**
+ * @brief Mejor tiempo por linea de una configuracion
+ * @param muestreo 0 sin traza; si no, 1 de cada muestreo tramas
+ */
+static double medir(const std::vector<char>& captura, long long tramas, int muestreo, int repeticiones,
+                    unsigned long long& huella, long long& tramos, long long& descartados) {
+    double mejor = 1e30;
+    long long descartadosAntes = TrazadorPRT7::getDescartados();
+    tramos = 0;
+    for (int r = 0; r < repeticiones; r++) {
+        if (muestreo > 0 && !TrazadorPRT7::activar(RUTA_TRAZA, muestreo)) {
+            std::fprintf(stderr, "No se pudo crear %s\n", RUTA_TRAZA);
+            return 0;
+        }
+        SalidaHuella salida;
+        DecodificadorPRT7 decodificador;
+        decodificador.inicializar();
+        decodificador.configurarVentana(&salida, 4096, 4096);
+        EnsambladorLineas ensamblador;
+
+        double inicio = segundos();
+        for (size_t i = 0; i < captura.size(); i += BLOQUE) {
+            size_t n = captura.size() - i;
+            if (n > (size_t)BLOQUE) n = BLOQUE;
+            ensamblador.alimentar(captura.data() + i, (int)n, &decodificador);
+        }
+        ensamblador.terminar(&decodificador);
+        decodificador.finalizar();
+        double tiempo = segundos() - inicio;
+
+        if (muestreo > 0) {
+            TrazadorPRT7::detener();
+            tramos += contarTramos(RUTA_TRAZA);
+        }
+        if (tiempo < mejor) mejor = tiempo;
+        huella = salida.hash;
+    }
+    descartados = TrazadorPRT7::getDescartados() - descartadosAntes;
+    return mejor * 1e9 / (double)tramas;
+}
+
+int main(int argc, char* argv[]) {
+    long long tramas = (argc > 1) ? std::atoll(argv[1]) : 4000000;
+    int repeticiones = (argc > 2) ? std::atoi(argv[2]) : 3;
+    TramaBase::setVerboso(false);
+
+    std::vector<char> captura = generarCaptura(tramas);
+    std::printf("%lld tramas, %.1f MB, mejor de %d\n", tramas, captura.size() / 1e6, repeticiones);
+
+    const int muestreos[3] = {0, 1000, 1};
+    const char* nombres[3] = {"sin traza", "1 de cada 1000", "todas las tramas"};
+    unsigned long long referencia = 0;
+    double base = 0;
+    bool correcto = true;
+    for (int c = 0; c < 3; c++) {
+        unsigned long long huella = 0;
+        long long tramos = 0;
+        long long descartados = 0;
+        double ns = medir(captura, tramas, muestreos[c], repeticiones, huella, tramos, descartados);
+        if (c == 0) {
+            referencia = huella;
+            base = ns;
+        }
+        bool bien = ns > 0 && huella == referencia && (muestreos[c] == 0 || tramos > 0);
+        correcto = correcto && bien;
+        std::printf("%-18s %8.2f ns/linea (%+6.1f%%)  %10lld tramos escritos  %9lld descartados%s\n", nombres[c], ns,
+                    (ns / base - 1) * 100, tramos, descartados, bien ? "" : "  ERROR");
+    }
+    std::remove(RUTA_TRAZA);
+    return correcto ? 0 : 1;
+}
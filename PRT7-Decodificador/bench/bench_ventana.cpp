@@ -0,0 +1,165 @@
+/**
+ * @file bench_ventana.cpp
+ * @brief RSS maximo de un flujo sin fin con y sin ventana deslizante en ListaDeCarga
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Decodifica un unico mensaje que nunca se cierra (tramas "L,x" y "M,n",
+ * ningun "F,"), como una pasarela que lleva semanas encendida. Las tramas
+ * se generan por bloques sobre la marcha para que la captura no ocupe
+ * memoria. Cada configuracion corre en un proceso hijo aparte, porque el
+ * RSS maximo de un proceso nunca baja, y se mide con dos largos de flujo:
+ *
+ * - ventana 0 (todo en memoria): el RSS crece con el flujo; se informa
+ *   cuanto ocupa cada caracter y lo que pediria una corrida de mil
+ *   millones de tramas;
+ * - ventanas de 4096 y 65536 caracteres: el RSS no debe crecer al
+ *   alargar el flujo.
+ *
+ * Con PRT7_SIN_HEAP la lista tiene capacidad fija y no puede crecer, asi
+ * que solo se miden las ventanas.
+ *
+ * Uso: prt7_bench_ventana [tramas]
+ */
+
+#include "DecodificadorPRT7.h"
+#include "EnsambladorLineas.h"
+#include "TramaBase.h"
+#include "comun.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const int BLOQUE = 1 << 16;
+static const int LOTE = 4096;
+static const long long MIL_MILLONES = 1000000000LL;
+
+/* Crecimiento admitido con ventana al cuadruplicar el flujo */
+static const long long HOLGURA_KIB = 1024;
+
+static long long memoriaMaximaKiB() {
+    rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return (long long)uso.ru_maxrss;
+}
+
+/**
+ * @struct Medicion
+ * @brief Lo que el hijo devuelve por la tuberia
+ */
+struct Medicion {
+    long long crecimientoKiB; ///< RSS maximo durante la decodificacion menos el de antes
+    long long caracteres;     ///< Caracteres decodificados
+};
+
+/* Decodifica 'tramas' tramas generadas sobre la marcha */
+static Medicion decodificar(long long tramas, int ventana) {
+    estadoAleatorio = 88172645463325252ULL;
+    static char bloque[BLOQUE + 32];
+    SalidaNula salida;
+    DecodificadorPRT7 decodificador;
+    decodificador.configurarVerboso(false);
+    decodificador.inicializar();
+    decodificador.configurarVentana(&salida, ventana, LOTE);
+    EnsambladorLineas ensamblador;
+    long long antes = memoriaMaximaKiB();
+
+    long long restantes = tramas;
+    while (restantes > 0) {
+        int n = 0;
+        while (n < BLOQUE && restantes > 0) {
+            if (aleatorio(100) < 85) {
+                n += std::snprintf(bloque + n, 32, "L,%c\n", 'A' + aleatorio(26));
+            } else {
+                n += std::snprintf(bloque + n, 32, "M,%d\n", (int)aleatorio(11) - 5);
+            }
+            restantes--;
+        }
+        ensamblador.alimentar(bloque, n, &decodificador);
+    }
+    ensamblador.terminar(&decodificador);
+    long long pico = memoriaMaximaKiB();
+    decodificador.finalizar();
+
+    Medicion m;
+    m.crecimientoKiB = pico - antes;
+    m.caracteres = salida.caracteres;
+    return m;
+}
+
+/* Corre decodificar() en un proceso hijo para que su RSS maximo no se mezcle */
+static bool medirEnHijo(long long tramas, int ventana, Medicion& m) {
+    int tuberia[2];
+    if (pipe(tuberia) != 0) return false;
+    pid_t hijo = fork();
+    if (hijo < 0) return false;
+    if (hijo == 0) {
+        close(tuberia[0]);
+        Medicion resultado = decodificar(tramas, ventana);
+        ssize_t escritos = write(tuberia[1], &resultado, sizeof(resultado));
+        _exit(escritos == (ssize_t)sizeof(resultado) ? 0 : 1);
+    }
+    close(tuberia[1]);
+    ssize_t leidos = read(tuberia[0], &m, sizeof(m));
+    close(tuberia[0]);
+    int estado = 0;
+    waitpid(hijo, &estado, 0);
+    return leidos == (ssize_t)sizeof(m) && WIFEXITED(estado) && WEXITSTATUS(estado) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    long long tramas = (argc > 1) ? std::atoll(argv[1]) : 2000000;
+    TramaBase::setVerboso(false);
+
+    const int ventanas[3] = {0, LOTE, 65536};
+    const long long largos[2] = {tramas, 4 * tramas};
+    bool correcto = true;
+#ifdef PRT7_SIN_HEAP
+    const int primera = 1;
+#else
+    const int primera = 0;
+#endif
+
+    std::printf("Un mensaje sin \"F,\", lote %d; RSS maximo durante la decodificacion (proceso aparte)\n", LOTE);
+    std::printf("ventana       tramas   caracteres   RSS KiB\n");
+    Medicion medidas[3][2];
+    for (int v = primera; v < 3; v++) {
+        for (int l = 0; l < 2; l++) {
+            if (!medirEnHijo(largos[l], ventanas[v], medidas[v][l])) {
+                std::printf("ERROR: el proceso hijo no termino bien\n");
+                return 1;
+            }
+            std::printf("%7d %12lld %12lld %9lld\n", ventanas[v], largos[l], medidas[v][l].caracteres,
+                        medidas[v][l].crecimientoKiB);
+        }
+    }
+
+    if (primera == 0) {
+        // Sin ventana: bytes por caracter y proyeccion a mil millones de tramas
+        const Medicion& corto = medidas[0][0];
+        const Medicion& largo = medidas[0][1];
+        double bytesPorCaracter = (double)(largo.crecimientoKiB - corto.crecimientoKiB) * 1024.0 /
+                                  (double)(largo.caracteres - corto.caracteres);
+        double caracteresPorTrama = (double)largo.caracteres / (double)largos[1];
+        std::printf("\nsin ventana: %.1f bytes por caracter; %lld tramas pedirian unos %.1f GB\n", bytesPorCaracter,
+                    MIL_MILLONES, bytesPorCaracter * caracteresPorTrama * (double)MIL_MILLONES / 1e9);
+        if (largo.crecimientoKiB <= corto.crecimientoKiB) {
+            std::printf("ERROR: sin ventana el RSS deberia crecer con el flujo\n");
+            correcto = false;
+        }
+    }
+
+    // Con ventana: el RSS no depende del largo del flujo
+    for (int v = 1; v < 3; v++) {
+        long long diferencia = medidas[v][1].crecimientoKiB - medidas[v][0].crecimientoKiB;
+        std::printf("ventana %d: %+lld KiB al cuadruplicar el flujo; %lld tramas quedarian en unos %lld KiB\n",
+                    ventanas[v], diferencia, MIL_MILLONES, medidas[v][1].crecimientoKiB);
+        if (diferencia > HOLGURA_KIB) {
+            std::printf("ERROR: con ventana %d el RSS crece con el flujo\n", ventanas[v]);
+            correcto = false;
+        }
+    }
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file comun.h
+ * @brief Utilidades de los benchs: numeros aleatorios reproducibles, reloj y salidas de prueba
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Solo para los programas de bench/: no forma parte de libprt7.
+ */
+
+#ifndef BENCH_COMUN_H
+#define BENCH_COMUN_H
+
+#include "SalidaCarga.h"
+#include <chrono>
+
+/** Estado del generador; se puede fijar para repetir una secuencia */
+inline unsigned long long estadoAleatorio = 88172645463325252ULL;
+
+/** Valor inicial de mezclarHash() (base de FNV-1a de 64 bits) */
+const unsigned long long HUELLA_INICIAL = 1469598103934665603ULL;
+
+/**
+ * @brief xorshift64: reproducible con la misma semilla
+ * @return Entero en [0, limite)
+ */
+inline unsigned int aleatorio(unsigned int limite) {
+    estadoAleatorio ^= estadoAleatorio << 13;
+    estadoAleatorio ^= estadoAleatorio >> 7;
+    estadoAleatorio ^= estadoAleatorio << 17;
+    return (unsigned int)(estadoAleatorio % limite);
+}
+
+/**
+ * @brief Segundos del reloj monotono
+ */
+inline double segundos() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Nanosegundos del reloj monotono
+ */
+inline long long nanosegundos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Agrega bytes a una huella FNV-1a de 64 bits
+ */
+inline unsigned long long mezclarHash(unsigned long long hash, const char* datos, int longitud) {
+    for (int i = 0; i < longitud; i++) {
+        hash = (hash ^ (unsigned char)datos[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Descarta el texto y solo cuenta los caracteres
+ */
+struct SalidaNula : public SalidaCarga {
+    long long caracteres = 0;
+    void escribir(const char*, int longitud) override { caracteres += longitud; }
+};
+
+/**
+ * @brief Resume el texto y los fines de mensaje para compararlos con una referencia
+ *
+ * Cada fin de mensaje cuenta como un '\n' en la huella.
+ */
+struct SalidaHuella : public SalidaCarga {
+    unsigned long long hash = HUELLA_INICIAL;
+    long long caracteres = 0;
+    long long mensajes = 0;
+    void escribir(const char* datos, int longitud) override {
+        hash = mezclarHash(hash, datos, longitud);
+        caracteres += longitud;
+    }
+    void finMensaje() override {
+        hash = mezclarHash(hash, "\n", 1);
+        mensajes++;
+    }
+};
+
+#endif // BENCH_COMUN_H
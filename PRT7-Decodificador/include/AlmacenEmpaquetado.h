@@ -0,0 +1,135 @@
+/**
+ * @file AlmacenEmpaquetado.h
+ * @brief Almacen del texto decodificado empaquetado en codigos de 5 bits
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef ALMACENEMPAQUETADO_H
+#define ALMACENEMPAQUETADO_H
+
+#include "SalidaCarga.h"
+
+class AlmacenEmpaquetado;
+
+/**
+ * @class IteradorEmpaquetado
+ * @brief Recorre secuencialmente los caracteres de un AlmacenEmpaquetado
+ */
+class IteradorEmpaquetado {
+private:
+    const AlmacenEmpaquetado* almacen; ///< Almacen que se recorre
+    long long bit;                     ///< Posicion del siguiente codigo en bits
+    long long restantes;               ///< Caracteres que faltan por leer
+    
+public:
+    /**
+     * @brief Constructor que apunta al primer caracter del almacen
+     * @param a Almacen a recorrer
+     */
+    explicit IteradorEmpaquetado(const AlmacenEmpaquetado* a);
+    
+    /**
+     * @brief Obtiene el siguiente caracter
+     * @param c Caracter leido
+     * @return false cuando ya no quedan caracteres
+     */
+    bool siguiente(char& c);
+};
+
+/**
+ * @class AlmacenEmpaquetado
+ * @brief Guarda el texto decodificado usando 5 bits por simbolo comun
+ * 
+ * Las letras A-Z, el espacio y los signos . , ! ? ocupan un codigo de 5 bits;
+ * cualquier otro byte se guarda como el codigo de escape seguido de sus
+ * 8 bits (13 bits en total). Frente a un NodoCarga (un char y dos
+ * punteros) esto reduce la memoria del mensaje en mas de 35 veces.
+ * 
+ * Tambien es una SalidaCarga: al usarlo como destino de la ventana
+ * deslizante, el texto antiguo queda empaquetado y solo la cola reciente
+ * permanece en la lista enlazada. Cada fin de mensaje se guarda como '\n'.
+ */
+class AlmacenEmpaquetado : public SalidaCarga {
+private:
+    static const int BITS_CODIGO = 5;    ///< Bits de un codigo comun
+    static const int CODIGO_ESCAPE = 31; ///< Codigo que antecede a un byte literal
+    
+    unsigned long long* palabras; ///< Bits empaquetados en palabras de 64 bits
+    long long capacidadPalabras;  ///< Palabras reservadas
+    long long bitsUsados;         ///< Bits ocupados
+    long long tamanio;            ///< Caracteres almacenados
+    unsigned char codigo[256];    ///< Codigo de 5 bits de cada byte (CODIGO_ESCAPE si no es comun)
+    
+    /**
+     * @brief Agrega los n bits menos significativos de valor al final
+     */
+    void escribirBits(unsigned long long valor, int n);
+    
+    friend class IteradorEmpaquetado;
+    
+    /**
+     * @brief Lee n bits a partir de una posicion
+     */
+    unsigned int leerBits(long long posicion, int n) const;
+    
+public:
+    /**
+     * @brief Constructor que crea un almacen vacio
+     */
+    AlmacenEmpaquetado();
+    
+    /**
+     * @brief Destructor que libera las palabras reservadas
+     */
+    ~AlmacenEmpaquetado();
+    
+    /**
+     * @brief Agrega un caracter al final
+     * @param c El caracter a guardar
+     */
+    void agregar(char c);
+    
+    /**
+     * @brief Agrega un bloque de caracteres (interfaz SalidaCarga)
+     */
+    void escribir(const char* datos, int longitud) override;
+    
+    /**
+     * @brief Guarda un '\n' como separador de mensajes (interfaz SalidaCarga)
+     */
+    void finMensaje() override;
+    
+    /**
+     * @brief Obtiene un iterador al primer caracter
+     */
+    IteradorEmpaquetado iterador() const;
+    
+    /**
+     * @brief Imprime todo el contenido en la salida estandar
+     */
+    void imprimir() const;
+    
+    /**
+     * @brief Obtiene el numero de caracteres almacenados
+     */
+    long long getTamanio() const;
+    
+    /**
+     * @brief Obtiene los bytes que ocupa el contenido empaquetado
+     */
+    long long getBytesUsados() const;
+    
+    /**
+     * @brief Calcula cuantas veces menos memoria usa que una ListaDeCarga
+     * @return Bytes de tamanio nodos NodoCarga entre bytes empaquetados
+     */
+    double getRazonCompresion() const;
+    
+    /**
+     * @brief Borra el contenido conservando la memoria reservada
+     */
+    void limpiar();
+};
+
+#endif // ALMACENEMPAQUETADO_H
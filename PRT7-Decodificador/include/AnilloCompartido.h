@@ -0,0 +1,101 @@
+/**
+ * @file AnilloCompartido.h
+ * @brief Anillo SPSC en memoria compartida POSIX para recibir bytes de otro proceso
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef ANILLOCOMPARTIDO_H
+#define ANILLOCOMPARTIDO_H
+
+struct CabeceraAnillo; // forward
+
+/**
+ * @class AnilloCompartido
+ * @brief Cola circular de un productor y un consumidor en un segmento shm_open
+ * 
+ * El proceso de captura (productor) escribe los bytes crudos del UART en el
+ * anillo y el decodificador (consumidor) los lee directamente del segmento
+ * compartido, sin tuberias intermedias. Las posiciones de lectura y
+ * escritura son contadores atomicos de 64 bits en lineas de cache
+ * separadas. Cuando un lado no tiene trabajo duerme en un futex del propio
+ * segmento y el otro lado solo hace la llamada de despertar si sabe que
+ * alguien duerme, asi que en regimen no hay llamadas al sistema por bloque.
+ * 
+ * Formato del segmento: una cabecera de 256 bytes (ver CabeceraAnillo en
+ * AnilloCompartido.cpp) seguida de los datos; la capacidad es potencia de 2.
+ * 
+ * Solo disponible en Linux; en otros sistemas abrir() devuelve false.
+ */
+class AnilloCompartido {
+private:
+    CabeceraAnillo* cabecera;   ///< Cabecera mapeada al inicio del segmento
+    char* datos;                ///< Zona de datos del anillo
+    unsigned long long mascara; ///< capacidad - 1
+    unsigned long long bytesMapeados; ///< Tamanio total del mapeo
+    
+public:
+    /**
+     * @brief Constructor de un anillo sin abrir
+     */
+    AnilloCompartido();
+    
+    /**
+     * @brief Destructor que desmapea el segmento (no lo elimina)
+     */
+    ~AnilloCompartido();
+    
+    /**
+     * @brief Crea el segmento o se une a uno existente
+     * @param nombre Nombre POSIX del segmento (ej. "/prt7")
+     * @param capacidad Bytes de datos si hay que crearlo (se redondea a potencia de 2)
+     * @return true si el anillo quedo listo para usarse
+     */
+    bool abrir(const char* nombre, unsigned long long capacidad);
+    
+    /**
+     * @brief Escribe todos los bytes, esperando si el anillo esta lleno (productor)
+     * @param bytes Datos a escribir
+     * @param longitud Numero de bytes
+     * @return Bytes escritos (menos que longitud solo si el consumidor cerro)
+     */
+    int escribir(const char* bytes, int longitud);
+    
+    /**
+     * @brief Obtiene sin copiar el siguiente tramo contiguo de datos (consumidor)
+     * @param bloque Puntero a los bytes dentro del segmento compartido
+     * @param longitud Bytes disponibles en el tramo
+     * @return false cuando el productor cerro y ya no quedan datos
+     * 
+     * Espera mientras el anillo este vacio. Los bytes siguen siendo del
+     * consumidor hasta llamar a liberar().
+     */
+    bool obtenerBloque(const char*& bloque, int& longitud);
+    
+    /**
+     * @brief Devuelve al productor el espacio de bytes ya consumidos
+     * @param longitud Bytes consumidos desde el ultimo obtenerBloque()
+     */
+    void liberar(int longitud);
+    
+    /**
+     * @brief Marca el fin del flujo: el consumidor termina al vaciar el anillo
+     */
+    void cerrarEscritura();
+    
+    /**
+     * @brief Desmapea el segmento
+     */
+    void cerrar();
+    
+    /**
+     * @brief Elimina el nombre del segmento del sistema
+     * @param nombre Nombre POSIX del segmento
+     * 
+     * Lo llama el consumidor al vaciar el anillo cerrado. Los mapeos
+     * existentes siguen validos.
+     */
+    static void eliminar(const char* nombre);
+};
+
+#endif // ANILLOCOMPARTIDO_H
@@ -0,0 +1,99 @@
+/**
+ * @file AutomataTramas.h
+ * @brief Reconocedor de tramas por tabla de transiciones generada del registro
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef AUTOMATATRAMAS_H
+#define AUTOMATATRAMAS_H
+
+#include "TramaBase.h"
+
+/**
+ * @struct TramaReconocida
+ * @brief Resultado de reconocer una linea
+ */
+struct TramaReconocida {
+    int tipo;        ///< Fila de REGISTRO_TRAMAS
+    DatoTrama dato;  ///< Dato segun la forma del tipo
+    int valor;       ///< Valor que informan las sondas (caracter, entero o longitud)
+    long long marca; ///< Marca de tiempo del prefijo "@n", o TramaBase::SIN_MARCA
+};
+
+/**
+ * @class AutomataTramas
+ * @brief Automata finito determinista que busca la primera trama de una linea
+ *
+ * La tabla de transiciones se construye en compilacion (constexpr) a partir
+ * de REGISTRO_TRAMAS: una clase de caracter por etiqueta registrada y, por
+ * cada etiqueta, estados para "etiqueta", "espacios antes de la coma",
+ * "asterisco" y "digitos del lote". Llegar a la coma de una etiqueta
+ * acepta la fila del registro correspondiente, asi que elegir la fabrica
+ * es un acceso a arreglo.
+ *
+ * Reglas que reproduce:
+ * - Se ignoran '[', espacios y tabuladores al inicio; ']', espacios,
+ *   tabuladores y '\r' al final; el prefijo "TX:" y una marca "@n ".
+ * - La etiqueta no puede ir precedida de una letra ("Load,x" no es trama).
+ * - Si un candidato falla, la busqueda sigue en el caracter siguiente; el
+ *   automata no retrocede porque lo consumido (espacios, '*', digitos) no
+ *   puede abrir otra trama.
+ * - El lote "L*n," exige 1 <= n <= TramaLoad::MAX_LOTE y n caracteres
+ *   disponibles en la linea sin recortar.
+ */
+class AutomataTramas {
+public:
+    /**
+     * @brief Reconoce la primera trama de una linea
+     * @param linea Caracteres de la linea, sin '\0' final
+     * @param longitud Numero de caracteres
+     * @param r Recibe el tipo, el dato y la marca
+     * @return true si la linea contiene una trama valida
+     */
+    static bool reconocer(const char* linea, int longitud, TramaReconocida& r);
+
+    /**
+     * @brief Delimita la parte de una linea donde puede ir la marca y la trama
+     * @param linea Caracteres de la linea
+     * @param longitud Numero de caracteres
+     * @param fin Recibe el fin de la vista (sin ']', espacios, tabuladores ni '\r' finales)
+     * @return Inicio de la vista, despues de '[', espacios, tabuladores y el prefijo "TX:"
+     *
+     * Lo usan reconocer() y quien necesita la marca de una linea sin
+     * reconocer la trama (MezcladorCapturas), para que un eco "TX: @n ..."
+     * tenga la misma marca en ambos.
+     */
+    static int recortar(const char* linea, int longitud, int& fin);
+
+    /**
+     * @brief Lee el prefijo de marca de tiempo "@<entero> " de una linea
+     * @param linea Caracteres de la linea (normalmente la vista de recortar())
+     * @param longitud Numero de caracteres
+     * @param marca Recibe la marca si la hay
+     * @return Caracteres que ocupa el prefijo con sus espacios, 0 si no hay marca
+     *
+     * Los espacios iniciales se ignoran. La marca admite hasta 18 digitos y
+     * debe ir seguida de un espacio o tabulador, o terminar la linea.
+     */
+    static int leerMarcaTiempo(const char* linea, int longitud, long long& marca);
+
+    /**
+     * @brief Filtro rapido: la linea tiene una etiqueta seguida de coma o de '*'
+     * @param linea Caracteres de la linea
+     * @param longitud Numero de caracteres
+     *
+     * Sirve para descartar ruido del puerto serial sin mostrarlo; una linea
+     * que lo pasa aun puede ser rechazada por reconocer().
+     */
+    static bool pareceTrama(const char* linea, int longitud);
+
+    /**
+     * @brief Convierte un entero con signo opcional (saturado si no cabe en int)
+     * @param str Caracteres a convertir; se detiene en el primer no digito
+     * @param longitud Caracteres que se pueden leer
+     */
+    static int leerEntero(const char* str, int longitud);
+};
+
+#endif // AUTOMATATRAMAS_H
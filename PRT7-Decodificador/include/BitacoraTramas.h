@@ -0,0 +1,81 @@
+/**
+ * @file BitacoraTramas.h
+ * @brief Bitacora circular compacta con el efecto de cada trama procesada
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef BITACORATRAMAS_H
+#define BITACORATRAMAS_H
+
+/**
+ * @class BitacoraTramas
+ * @brief Registro circular de los efectos de las ultimas tramas, para deshacerlas
+ * 
+ * Cada trama ocupa una sola entrada de 16 bits: los dos bits altos indican
+ * el tipo de efecto y el resto su valor (caracteres agregados o
+ * desplazamiento del rotor). Cuando la bitacora se llena, las entradas
+ * mas antiguas se sobrescriben.
+ */
+class BitacoraTramas {
+public:
+    /**
+     * @brief Tipos de efecto que puede registrar una trama
+     */
+    enum TipoEntrada {
+        NINGUNO = 0,   ///< La trama no cambio el estado
+        CARGA = 1,     ///< La trama agrego caracteres al final de la carga
+        ROTACION = 2,  ///< La trama movio la cabeza del rotor
+        BARRERA = 3    ///< La trama tuvo un efecto que no se puede deshacer
+    };
+    
+private:
+    unsigned short* entradas; ///< Arreglo circular de entradas
+    int capacidad;            ///< Numero maximo de entradas
+    int inicio;               ///< Indice de la entrada mas antigua
+    int cantidad;             ///< Entradas almacenadas
+    
+public:
+    /**
+     * @brief Constructor que reserva la bitacora
+     * @param cap Numero de tramas que se pueden deshacer como maximo
+     */
+    explicit BitacoraTramas(int cap);
+    
+    /**
+     * @brief Destructor que libera el arreglo de entradas
+     */
+    ~BitacoraTramas();
+    
+    /**
+     * @brief Agrega la entrada de una trama
+     * @param tipo Tipo de efecto
+     * @param valor Caracteres agregados (CARGA) o desplazamiento 0-25 (ROTACION)
+     */
+    void registrar(TipoEntrada tipo, int valor);
+    
+    /**
+     * @brief Consulta la entrada mas reciente sin quitarla
+     * @param tipo Tipo de efecto de la entrada
+     * @param valor Valor de la entrada
+     * @return true si habia alguna entrada
+     */
+    bool verUltima(TipoEntrada& tipo, int& valor) const;
+    
+    /**
+     * @brief Quita la entrada mas reciente
+     */
+    void descartarUltima();
+    
+    /**
+     * @brief Obtiene el numero de entradas almacenadas
+     */
+    int getCantidad() const;
+    
+    /**
+     * @brief Borra todas las entradas
+     */
+    void vaciar();
+};
+
+#endif // BITACORATRAMAS_H
@@ -0,0 +1,233 @@
+/**
+ * @file CacheTramos.h
+ * @brief Cache en disco del resultado de decodificar cada tramo de una captura
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef CACHETRAMOS_H
+#define CACHETRAMOS_H
+
+#include "EnsambladorLineas.h"
+#include <cstdio>
+
+class DecodificadorPRT7;
+class ListaDeCarga;
+
+/**
+ * @struct EntradaCache
+ * @brief Un tramo guardado en el archivo de la cache
+ */
+struct EntradaCache {
+    unsigned long long hash;  ///< Huella de las lineas del tramo
+    int longitud;             ///< Bytes del tramo (lineas mas sus '\n')
+    int rotorEntrada;         ///< Desplazamiento del rotor al empezar el tramo
+    int rotorSalida;          ///< Desplazamiento del rotor al terminarlo
+    int eventos;              ///< Bytes de eventos grabados
+    unsigned int control;     ///< FNV-1a de los eventos, para detectar archivos danados
+    long long marca;          ///< Ultima marca de tiempo del tramo (SIN_MARCA = ninguna)
+    long long uso;            ///< Ultima generacion que lo uso
+    long long posicion;       ///< Byte del archivo donde empieza su registro
+    bool tocada;              ///< uso cambio y hay que escribirlo al cerrar
+};
+
+/**
+ * @class CacheTramos
+ * @brief Memoriza lo que cada tramo de una captura le hace al decodificador
+ *
+ * Repetir una captura archivada (regresiones, otros formatos de salida)
+ * vuelve a parsear y decodificar cada trama. La cache agrupa las lineas en
+ * tramos y los identifica por una huella de su contenido mas el
+ * desplazamiento del rotor al entrar, que es todo el estado del que depende
+ * su resultado. Si el tramo ya esta en la cache se reproducen sus eventos
+ * y el rotor salta al desplazamiento de salida sin parsear nada; si no, se
+ * decodifica normalmente mientras ListaDeCarga graba los eventos.
+ *
+ * Los eventos son las llamadas de las tramas a insertarAlFinal() y
+ * cerrarMensaje(), antes de delimitador, ventana, vigilante o salida: la
+ * misma cache sirve para cualquier configuracion de salida.
+ *
+ * Los cortes entre tramos dependen del contenido: un tramo termina tras
+ * la primera linea cuya huella tiene ceros en MASCARA_CORTE despues de
+ * TAM_MIN_TRAMO bytes, o al llegar a TAM_MAX_TRAMO. Asi un cambio en la
+ * captura solo invalida su tramo (y los siguientes si cambia el rotor).
+ *
+ * El archivo es una cabecera de TAM_CABECERA bytes ("PRT7CCH1", version
+ * y generacion) seguida de registros de TAM_REGISTRO bytes mas sus eventos,
+ * en little-endian. Cada apertura es una generacion nueva; al cerrar, si
+ * el archivo pasa del limite se reescribe sin los tramos usados hace mas
+ * generaciones. Durante la ejecucion solo se agregan tramos mientras lo que
+ * no se uso en esta generacion alcance para volver al limite.
+ *
+ * No se usa con verificacion de integridad ni bitacora (dependen de estado
+ * que no esta en la clave), y los tramos reproducidos no disparan sondas,
+ * trazas ni mensajes por trama.
+ */
+class CacheTramos : public ReceptorLineas {
+public:
+    static const int TAM_MIN_TRAMO = 32 * 1024;     ///< Bytes minimos de un tramo
+    static const int TAM_MAX_TRAMO = 256 * 1024;    ///< Bytes maximos de un tramo
+    static const unsigned int MASCARA_CORTE = 4095; ///< Una de cada 4096 lineas puede cortar
+    static const int TAM_CABECERA = 24;             ///< Bytes de la cabecera del archivo
+    static const int TAM_REGISTRO = 48;             ///< Bytes fijos de cada tramo guardado
+    static const int VERSION = 1;                   ///< Cambia si cambia lo que decodifica una trama
+    static const long long LIMITE_DEFECTO = 256LL * 1024 * 1024; ///< Bytes en disco por defecto
+
+private:
+    std::FILE* archivo;       ///< Archivo de la cache abierto para leer y escribir
+    const char* ruta;         ///< Ruta del archivo (para compactar)
+    bool ocupada;             ///< La ultima apertura fallo porque otro proceso tiene el archivo
+    long long limite;         ///< Bytes maximos del archivo
+    long long generacion;     ///< Generacion de esta apertura
+    long long tamanioArchivo; ///< Bytes del archivo, incluidos los tramos agregados
+    long long bytesViejos;    ///< Bytes de tramos que esta generacion no uso
+
+    EntradaCache* entradas;   ///< Tramos conocidos, en el orden del archivo
+    int numEntradas;          ///< Tramos en entradas
+    int capacidadEntradas;    ///< Capacidad de entradas
+    int* tabla;               ///< Direccionamiento abierto: indice en entradas, -1 = libre
+    int capacidadTabla;       ///< Potencia de dos
+
+    DecodificadorPRT7* decodificador; ///< Decodificador que recibe los tramos
+    char* tramo;              ///< Lineas del tramo en curso separadas por '\n'
+    int usados;               ///< Bytes en tramo
+    unsigned long long hashTramo; ///< Huella del tramo en curso
+    char* eventos;            ///< Eventos grabados o leidos del archivo
+    int numEventos;           ///< Bytes en eventos
+    int capacidadEventos;     ///< Capacidad de eventos
+
+    long long consultas;      ///< Tramos buscados
+    long long aciertos;       ///< Tramos reproducidos desde la cache
+    long long bytesConsultados; ///< Bytes de captura de los tramos buscados
+    long long bytesAcertados; ///< Bytes de captura reproducidos desde la cache
+    long long agregadas;      ///< Tramos guardados en esta generacion
+    long long rechazadas;     ///< Tramos no guardados por el limite
+    long long eliminadas;     ///< Tramos desalojados al compactar
+
+    /**
+     * @brief Busca un tramo
+     * @return Indice en entradas, o -1
+     */
+    int buscar(unsigned long long hash, int longitud, int rotor) const;
+
+    /**
+     * @brief Agrega una entrada a la tabla de direccionamiento abierto
+     */
+    void indexar(int numero);
+
+    /**
+     * @brief Agrega un tramo al arreglo de entradas (crece si hace falta)
+     * @return Indice de la entrada
+     */
+    int nuevaEntrada(const EntradaCache& e);
+
+    /**
+     * @brief Asegura espacio para n bytes mas de eventos
+     */
+    void reservarEventos(int n);
+
+    /**
+     * @brief Lee las entradas del archivo; descarta la cola de un registro incompleto
+     * @return false si el archivo no es una cache de esta version
+     */
+    bool cargar();
+
+    /**
+     * @brief Resuelve el tramo en curso: lo reproduce o lo decodifica y lo guarda
+     */
+    void cerrarTramo();
+
+    /**
+     * @brief Decodifica el tramo en curso linea por linea, grabando sus eventos
+     */
+    void decodificarTramo();
+
+    /**
+     * @brief Escribe al final del archivo el tramo recien decodificado
+     */
+    void guardar(EntradaCache& e);
+
+    /**
+     * @brief Reescribe el archivo sin los tramos usados hace mas generaciones
+     * @return false si fallo la escritura (el archivo anterior queda intacto)
+     */
+    bool compactar();
+
+public:
+    /**
+     * @brief Constructor de una cache cerrada
+     */
+    CacheTramos();
+
+    /**
+     * @brief Destructor que cierra la cache
+     */
+    ~CacheTramos();
+
+    /**
+     * @brief Abre o crea el archivo de la cache
+     * @param rutaArchivo Archivo de la cache (la cadena debe seguir viva hasta cerrar)
+     * @param limiteBytes Bytes maximos que puede ocupar en disco
+     * @return false si no se pudo abrir ni crear, si no es un archivo de
+     *         cache o si otro proceso lo tiene abierto (ver getOcupada())
+     *
+     * Un archivo de otra version se descarta y se empieza una cache vacia.
+     * Mientras esta abierta, la cache tiene el bloqueo exclusivo del
+     * archivo (flock, o LockFileEx en Windows): un segundo proceso con la
+     * misma ruta no espera, abrir() le devuelve false.
+     */
+    bool abrir(const char* rutaArchivo, long long limiteBytes = LIMITE_DEFECTO);
+
+    /**
+     * @brief Empieza a recibir lineas para un decodificador
+     * @param d Decodificador inicializado; su rotor es el de entrada del primer tramo
+     */
+    void iniciar(DecodificadorPRT7* d);
+
+    /**
+     * @brief Agrega una linea al tramo en curso (ver ReceptorLineas)
+     */
+    void lineaCompleta(const char* linea, int longitud) override;
+
+    /**
+     * @brief Resuelve el ultimo tramo al terminar la entrada
+     */
+    void terminar();
+
+    /**
+     * @brief Escribe los usos, compacta si pasa del limite y cierra el archivo
+     * @return false si fallo alguna escritura
+     */
+    bool cerrar();
+
+    /**
+     * @brief Graba la insercion de un caracter (la llama ListaDeCarga)
+     */
+    void grabarCaracter(char c);
+
+    /**
+     * @brief Graba un cierre de mensaje (la llama ListaDeCarga)
+     */
+    void grabarCierre(bool aunqueVacio);
+
+    /**
+     * @brief Aplica eventos grabados a una lista de carga
+     * @param datos Eventos de un tramo
+     * @param longitud Bytes de eventos
+     * @param carga Lista que los recibe
+     */
+    static void reproducir(const char* datos, int longitud, ListaDeCarga* carga);
+
+    bool getOcupada() const;               ///< abrir() fallo porque otro proceso tiene la cache
+    long long getConsultas() const;        ///< Tramos buscados
+    long long getAciertos() const;         ///< Tramos reproducidos desde la cache
+    long long getBytesConsultados() const; ///< Bytes de captura buscados
+    long long getBytesAcertados() const;   ///< Bytes de captura reproducidos
+    long long getAgregadas() const;        ///< Tramos guardados en esta generacion
+    long long getRechazadas() const;       ///< Tramos que no cupieron en el limite
+    long long getEliminadas() const;       ///< Tramos desalojados al cerrar
+    int getEntradas() const;               ///< Tramos en la cache
+    long long getTamanioArchivo() const;   ///< Bytes del archivo
+};
+
+#endif // CACHETRAMOS_H
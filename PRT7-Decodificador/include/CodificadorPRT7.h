@@ -0,0 +1,140 @@
+/**
+ * @file CodificadorPRT7.h
+ * @brief Codificador que genera tramas PRT-7 a partir de texto plano
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef CODIFICADORPRT7_H
+#define CODIFICADORPRT7_H
+
+#include "TramaLoad.h"
+
+/**
+ * @class CodificadorPRT7
+ * @brief Inverso del decodificador: convierte texto en un flujo de tramas L,x / M,n
+ * 
+ * Mantiene el mismo desplazamiento de rotor que tendria el decodificador y,
+ * para cada caracter A-Z, emite la letra que RotorDeMapeo::getMapeo
+ * convertira de vuelta en el caracter original. Segun la politica de
+ * rotacion intercala tramas MAP para cambiar el mapeo durante el flujo.
+ * 
+ * Los saltos de linea del texto se emiten como tramas FIN ("F,"), de modo
+ * que cada linea llega al decodificador como un mensaje. Los caracteres
+ * que el parser no puede transportar en una trama LOAD ('\\t', '\\r', ']'
+ * y '\\0') se omiten y se cuentan en getOmitidos().
+ * 
+ * Con configurarLote(n), los caracteres consecutivos que comparten el
+ * mismo estado del rotor salen juntos en tramas "L*<k>,<k caracteres>"
+ * de hasta n caracteres (ver TramaLoad).
+ */
+class CodificadorPRT7 {
+public:
+    /**
+     * @brief Politicas para decidir cuando se intercala una trama MAP
+     */
+    enum PoliticaRotacion {
+        SIN_ROTACION, ///< Nunca rota: todas las letras se envian tal cual
+        FIJA,         ///< Rota "paso" posiciones cada "cada" caracteres
+        ALEATORIA     ///< Rota una cantidad pseudoaleatoria cada "cada" caracteres
+    };
+    
+    /**
+     * @brief Bytes de salida que puede generar como maximo cada caracter de entrada
+     * 
+     * Una trama "M,-25\n" (6) seguida de "L,x\n" (4), cada una con el
+     * sufijo de integridad opcional (hasta 20 bytes).
+     */
+    static const int MAX_BYTES_POR_CARACTER = 50;
+    
+private:
+    PoliticaRotacion politica; ///< Politica de rotacion activa
+    int cada;                  ///< Caracteres entre rotaciones
+    int paso;                  ///< Posiciones por rotacion (politica FIJA)
+    unsigned int estadoAzar;   ///< Estado del generador pseudoaleatorio
+    int desplazamiento;        ///< Desplazamiento del rotor del receptor [0, 25]
+    int contador;              ///< Caracteres desde la ultima rotacion
+    long long omitidos;        ///< Caracteres que no se pudieron codificar
+    bool integridad;           ///< Agregar "*secuencia*crc32c" a cada trama
+    unsigned int secuencia;    ///< Secuencia de la siguiente trama
+    int lote;                  ///< Caracteres maximos por trama LOAD (1 = "L,x")
+    
+    /**
+     * @brief Calcula la rotacion de la siguiente trama MAP segun la politica
+     * @return Posiciones a rotar (puede ser negativa)
+     */
+    int siguienteRotacion();
+    
+    /**
+     * @brief Termina la trama que empieza en inicio (sufijo opcional y '\n')
+     * @param inicio Primer byte de la trama
+     * @param escritura Posicion actual de escritura; avanza
+     */
+    void terminarTrama(const char* inicio, char*& escritura);
+    
+    /**
+     * @brief Escribe una trama LOAD con los caracteres ya codificados
+     * @param datos Caracteres a enviar
+     * @param longitud Numero de caracteres (1 produce "L,x")
+     * @param escritura Posicion actual de escritura; avanza
+     */
+    void emitirCarga(const char* datos, int longitud, char*& escritura);
+    
+public:
+    /**
+     * @brief Constructor con politica SIN_ROTACION
+     */
+    CodificadorPRT7();
+    
+    /**
+     * @brief Configura la politica de rotacion
+     * @param p Politica a usar
+     * @param cadaN Caracteres entre rotaciones (minimo 1)
+     * @param pasoN Posiciones por rotacion en la politica FIJA
+     * @param semilla Semilla del generador para la politica ALEATORIA
+     */
+    void configurar(PoliticaRotacion p, int cadaN, int pasoN, unsigned int semilla);
+    
+    /**
+     * @brief Activa el sufijo de secuencia y CRC32C (ver VerificadorIntegridad)
+     */
+    void configurarIntegridad(bool activar);
+    
+    /**
+     * @brief Define cuantos caracteres puede llevar cada trama LOAD
+     * @param caracteres 1 para "L,x" (por defecto), hasta TramaLoad::MAX_LOTE
+     * 
+     * Un lote se cierra al llenarse, antes de cada trama MAP o FIN y al
+     * terminar cada llamada a codificar().
+     */
+    void configurarLote(int caracteres);
+    
+    /**
+     * @brief Codifica un bloque de texto en tramas terminadas en '\\n'
+     * @param texto Caracteres a codificar
+     * @param longitud Numero de caracteres
+     * @param destino Buffer de salida con al menos longitud * MAX_BYTES_POR_CARACTER bytes
+     * @return Numero de bytes escritos en destino
+     * 
+     * El estado del rotor se conserva entre llamadas, por lo que un texto
+     * largo puede codificarse en bloques de cualquier tamanio.
+     */
+    int codificar(const char* texto, int longitud, char* destino);
+    
+    /**
+     * @brief Vuelve al estado inicial (rotor en 'A') conservando la politica
+     */
+    void reiniciar();
+    
+    /**
+     * @brief Obtiene el desplazamiento actual del rotor del receptor
+     */
+    int getDesplazamiento() const;
+    
+    /**
+     * @brief Obtiene cuantos caracteres se omitieron por no poder transportarse
+     */
+    long long getOmitidos() const;
+};
+
+#endif // CODIFICADORPRT7_H
@@ -11,7 +11,14 @@
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
 #include "TramaBase.h"
+#include "EnsambladorLineas.h"
 class SerialPort; // forward
+class SalidaCarga; // forward
+class VigilantePatrones; // forward
+class BitacoraTramas; // forward
+class VerificadorIntegridad; // forward
+class EspejoCarga; // forward
+class CacheTramos; // forward
 
 /**
  * @class DecodificadorPRT7
@@ -20,22 +27,71 @@ class SerialPort; // forward
  * Esta clase maneja la comunicacion serial, el parseo de tramas,
  * la instanciacion de objetos polimorficos y la coordinacion entre
  * las estructuras de datos para decodificar el mensaje oculto.
+ * 
+ * Compilado con PRT7_SIN_HEAP, la lista de carga, el rotor y la trama en
+ * curso se construyen dentro del propio objeto: procesar lineas no pide
+ * memoria dinamica (ver ListaDeCarga::PoliticaDesborde).
  */
-class DecodificadorPRT7 {
+class DecodificadorPRT7 : public ReceptorLineas {
+public:
+    static const int TAM_ESPACIO_TRAMA = 48; ///< Bytes para la trama en curso (PRT7_SIN_HEAP)
+    
 private:
     ListaDeCarga* listaCarga;  ///< Lista que almacena los caracteres decodificados
     RotorDeMapeo* rotor;       ///< Rotor que realiza el mapeo de caracteres
     bool activo;               ///< Estado del decodificador
+    bool lineasSerial;         ///< lineaCompleta muestra cada trama (ejecutarSerial)
+    bool verboso;              ///< Mostrar el arranque y cada trama procesada
+    int inactividadMs;         ///< Milisegundos sin tramas que cierran un mensaje (0 = nunca)
+    long long ultimaActividadMs; ///< Instante de la ultima trama valida o del ultimo cierre por inactividad
+    BitacoraTramas* bitacora;  ///< Efectos de las ultimas tramas para poder deshacerlas
+    VerificadorIntegridad* integridad; ///< Verificador de sufijos (nullptr = sin verificar)
+    long long marcaTiempo;     ///< Marca de la ultima trama que trajo una (SIN_MARCA = ninguna)
+    EspejoCarga* espejo;       ///< Estado publicado para hilos de monitoreo (nullptr = ninguno)
+    bool bajaLatencia;         ///< ejecutarSerial sondea el puerto en lugar de esperar
+    int nucleoLector;          ///< Nucleo del hilo lector del puerto (-1 = sin fijar)
+    int nucleoDecodificador;   ///< Nucleo del hilo que decodifica (-1 = sin fijar)
+    bool tiempoReal;           ///< Ambos hilos con SCHED_FIFO
+    CacheTramos* cache;        ///< Cache de tramos para ejecutarArchivo (nullptr = ninguna)
+#ifdef PRT7_SIN_HEAP
+    alignas(ListaDeCarga) unsigned char espacioCarga[sizeof(ListaDeCarga)]; ///< Lista de carga
+    alignas(RotorDeMapeo) unsigned char espacioRotor[sizeof(RotorDeMapeo)]; ///< Rotor
+    alignas(8) unsigned char espacioTrama[TAM_ESPACIO_TRAMA]; ///< Unica trama viva a la vez
+#endif
+    
+    /**
+     * @brief Destruye una trama creada por parsearTrama
+     * @param trama Trama ya procesada
+     */
+    void liberarTrama(TramaBase* trama);
+    
+    /**
+     * @brief Aplica el verificador de integridad a una linea
+     * @param linea La linea recibida
+     * @param longitud Caracteres de la linea; si trae sufijo valido se
+     *        acorta para que el parser solo vea la trama
+     * @return false si la linea se descarta
+     */
+    bool verificarIntegridad(const char* linea, int& longitud);
     
     /**
      * @brief Parsea una linea de entrada y crea la trama correspondiente
-     * @param linea La linea de texto recibida (ej. "L,A" o "M,5")
+     * @param linea La linea de texto recibida (ej. "L,A" o "M,5"), sin '\0' final
+     * @param longitud Numero de caracteres de la linea
      * @return Puntero a la trama creada, nullptr si hay error
      * 
-     * Analiza el formato de la linea y crea el objeto TramaLoad o TramaMap
-     * correspondiente usando polimorfismo.
+     * AutomataTramas reconoce la linea y la fabrica de la fila aceptada de
+     * REGISTRO_TRAMAS crea la trama (con new, o en espacioTrama con
+     * PRT7_SIN_HEAP). No copia la linea, asi que acepta cualquier longitud.
+     */
+    TramaBase* parsearTrama(const char* linea, int longitud);
+    
+    /**
+     * @brief Filtra, muestra y procesa una linea recibida por el puerto serial
+     * @param linea Caracteres de la linea
+     * @param longitud Numero de caracteres
      */
-    TramaBase* parsearTrama(const char* linea);
+    void procesarLineaSerial(const char* linea, int longitud);
     
     /**
      * @brief Procesa una sola trama usando polimorfismo
@@ -46,19 +102,26 @@ private:
      */
     void procesarTrama(TramaBase* trama);
     
+    /**
+     * @brief Publica en el espejo los contadores y el rotor actuales
+     */
+    void publicarEspejo();
+    
     /**
      * @brief Convierte una cadena a entero (reemplazo de atoi sin STL)
      * @param str La cadena a convertir
-     * @return El valor entero correspondiente
+     * @param longitud Caracteres que se pueden leer de str
+     * @return El valor entero correspondiente (saturado si no cabe en int)
      */
-    int stringAEntero(const char* str);
+    int stringAEntero(const char* str, int longitud);
     
     /**
-     * @brief Copia una cadena (reemplazo de strcpy sin STL)
-     * @param destino Buffer donde copiar
-     * @param origen Cadena a copiar
+     * @brief Asigna la marca de tiempo a una trama recien creada
+     * @param trama Trama creada por parsearTrama
+     * @param marca Marca leida del prefijo, o TramaBase::SIN_MARCA
+     * @return La misma trama
      */
-    void copiarCadena(char* destino, const char* origen);
+    static TramaBase* marcar(TramaBase* trama, long long marca);
     
     /**
      * @brief Busca un caracter en una cadena (reemplazo de strchr sin STL)
@@ -94,11 +157,18 @@ public:
     void ejecutar();
 
     /**
-     * @brief Ejecuta leyendo lineas desde un puerto serial real (Windows)
-     * @param puerto Nombre del puerto, ej. "COM3"
+     * @brief Ejecuta leyendo lineas desde un puerto serial real
+     * @param puerto Nombre del puerto, ej. "COM3" o "/dev/ttyUSB0"
      * @param baud   Velocidad (ej. 9600)
+     * @param controlFlujo Control de flujo con el emisor: un SerialPort::ControlFlujo
+     *        (por defecto SerialPort::SIN_CONTROL); se recibe como int para
+     *        que este encabezado no incluya SerialPort.h
+     * 
+     * El puerto se vacia en un hilo aparte; si el decodificador se atrasa,
+     * el emisor se pausa con XON/XOFF o RTS/CTS en lugar de perder bytes.
+     * Ver configurarBajaLatencia para sondear el puerto sin esperas.
      */
-    void ejecutarSerial(const char* puerto, unsigned long baud);
+    void ejecutarSerial(const char* puerto, unsigned long baud, int controlFlujo = 0);
     
     /**
      * @brief Simula el procesamiento de datos de un Arduino
@@ -108,6 +178,249 @@ public:
      */
     void simularArduino();
     
+    /**
+     * @brief Decodifica lineas desde la entrada estandar sin interaccion
+     * 
+     * Pensado para pasarelas que reciben un flujo continuo: no muestra
+     * mensajes por trama e ignora en silencio las lineas invalidas o
+     * demasiado largas (ver EnsambladorLineas). Termina al llegar al fin
+     * de la entrada.
+     */
+    void ejecutarFlujo();
+    
+    /**
+     * @brief Parsea y procesa una sola linea de entrada
+     * @param linea La linea de texto recibida (ej. "L,A" o "M,5"), sin '\0' final
+     * @param longitud Numero de caracteres de la linea
+     * @return true si la linea contenia una trama valida
+     */
+    bool procesarLinea(const char* linea, int longitud);
+    
+    /**
+     * @brief Recibe una linea de un EnsambladorLineas y la procesa
+     * @param linea La linea completa (vista valida solo durante la llamada)
+     * @param longitud Numero de caracteres de la linea
+     */
+    void lineaCompleta(const char* linea, int longitud) override;
+    
+    /**
+     * @brief Decodifica los bytes que otro proceso escribe en un anillo compartido
+     * @param nombre Nombre POSIX del segmento (ej. "/prt7")
+     * 
+     * Lee los bloques directamente del segmento (ver AnilloCompartido) hasta
+     * que el productor cierra el flujo y despues elimina el nombre del
+     * segmento; el productor no lo elimina, asi puede terminar antes de que
+     * el consumidor se conecte. Solo disponible en Linux.
+     */
+    void ejecutarAnillo(const char* nombre);
+    
+    /**
+     * @brief Decodifica un archivo de captura, tuberia o tty leyendo por bloques
+     * @param ruta Ruta de la entrada ("-" para la entrada estandar)
+     * @param permitirUring false para forzar read() aunque haya io_uring
+     * @param desde Byte de un archivo regular desde el que se empieza a leer;
+     *        debe ser un inicio de linea con el rotor ya posicionado (ver IndiceCaptura)
+     * 
+     * Usa LectorEntrada para mantener lecturas grandes en vuelo y entrega
+     * cada bloque al EnsambladorLineas sin pasar por std::cin. Con una
+     * cache configurada las lineas pasan por ella (ver configurarCache).
+     */
+    void ejecutarArchivo(const char* ruta, bool permitirUring = true, long long desde = 0);
+    
+    /**
+     * @brief Activa el volcado por lotes de la lista de carga
+     * @param destino Salida que recibe el texto decodificado
+     * @param ventana Caracteres recientes que se conservan en memoria (0 = todos)
+     * @param lote Caracteres que se entregan en cada volcado
+     * 
+     * Debe llamarse despues de inicializar(). Ver ListaDeCarga::configurarVentana.
+     */
+    void configurarVentana(SalidaCarga* destino, int ventana, int lote);
+    
+    /**
+     * @brief Configura como se separan los mensajes del flujo
+     * @param delimitador Caracter decodificado que cierra un mensaje ('\0' = ninguno)
+     * @param inactividad Milisegundos sin tramas tras los que se cierra el mensaje (0 = nunca)
+     * 
+     * Ademas de estos criterios, una trama "F," siempre cierra el mensaje.
+     * Cada mensaje cerrado se entrega a la salida configurada y su memoria
+     * se libera. Debe llamarse despues de inicializar().
+     */
+    void configurarSegmentacion(char delimitador, int inactividad);
+    
+    /**
+     * @brief Cierra el mensaje en curso si se supero el tiempo de inactividad
+     * 
+     * Los bucles de lectura la llaman cuando no llegan datos; un anfitrion
+     * que alimente el decodificador por su cuenta puede llamarla periodicamente.
+     */
+    void verificarInactividad();
+    
+    /**
+     * @brief Activa la vigilancia de palabras clave sobre el texto decodificado
+     * @param vigilante Automata ya construido (no se toma su propiedad), o nullptr
+     * 
+     * Debe llamarse despues de inicializar(). Ver ListaDeCarga::configurarVigilante.
+     */
+    void configurarVigilante(VigilantePatrones* vigilante);
+    
+    /**
+     * @brief Activa la bitacora que permite deshacer las ultimas tramas
+     * @param capacidad Numero maximo de tramas que se pueden deshacer (0 = desactivar)
+     */
+    void configurarBitacora(int capacidad);
+    
+    /**
+     * @brief Deshace las ultimas tramas procesadas
+     * @param tramas Numero de tramas a deshacer
+     * @return Numero de tramas que realmente se deshicieron
+     * 
+     * Restaura la cola de la lista de carga y la cabeza del rotor a partir
+     * de la bitacora. Se detiene antes de una trama que cerro un mensaje o
+     * cuyos caracteres ya se volcaron a la salida, porque esos efectos ya
+     * salieron del decodificador. El estado del vigilante de patrones no
+     * se retrocede.
+     */
+    int retroceder(int tramas);
+    
+    /**
+     * @brief Activa la verificacion del sufijo de secuencia y CRC32C
+     * @param verificador Verificador con sus contadores, o nullptr para desactivar
+     * 
+     * Las tramas que el verificador rechaza se descartan antes de parsearlas;
+     * las validas se procesan sin el sufijo.
+     */
+    void configurarIntegridad(VerificadorIntegridad* verificador);
+    
+    /**
+     * @brief Elige si este decodificador escribe en consola al arrancar y por cada trama
+     * @param activo true para mostrar los mensajes
+     * 
+     * Parte de TramaBase::esVerboso() al construirse. Para callar tambien
+     * el arranque, debe llamarse antes de inicializar(). No toca el valor
+     * global, asi que cada hilo puede configurar el suyo.
+     */
+    void configurarVerboso(bool activo);
+    
+    /**
+     * @brief Elige que hacer si la lista de carga se queda sin nodos (PRT7_SIN_HEAP)
+     * @param politica Politica de desborde de la lista
+     * 
+     * Debe llamarse despues de inicializar(). Ver ListaDeCarga::configurarDesborde.
+     */
+    void configurarDesborde(ListaDeCarga::PoliticaDesborde politica);
+    
+    /**
+     * @brief Publica el estado en un espejo que otros hilos leen sin bloquear
+     * @param e Espejo (no se toma su propiedad), o nullptr para desactivarlo
+     * 
+     * Cada caracter insertado se copia al espejo y, al terminar cada trama,
+     * cierre de mensaje, retroceso o reinicio, se publican los contadores y
+     * el rotor. El decodificador sigue siendo de un solo hilo: los demas
+     * solo llaman a EspejoCarga::leer(). Debe llamarse despues de inicializar()
+     * y antes de la primera trama: los caracteres anteriores no estan en el espejo.
+     */
+    void configurarEspejo(EspejoCarga* e);
+    
+    /**
+     * @brief Hace que ejecutarSerial sondee el puerto en lugar de esperar
+     * @param nucleoLector Nucleo del hilo que vacia el puerto (-1 = sin fijar)
+     * @param nucleoDecodificador Nucleo del hilo que llama a ejecutarSerial (-1 = sin fijar)
+     * @param tiempoReal Ejecutar ambos hilos con SCHED_FIFO
+     * 
+     * Ver SerialPort::configurarBajaLatencia. Cada hilo ocupa su nucleo al
+     * 100% aunque no lleguen tramas; los dos nucleos deberian ser distintos
+     * y estar libres de otras tareas. Al volver, ejecutarSerial devuelve al
+     * hilo que lo llamo la afinidad y la planificacion que tenia.
+     */
+    void configurarBajaLatencia(int nucleoLector, int nucleoDecodificador, bool tiempoReal);
+    
+    /**
+     * @brief Hace que ejecutarArchivo reproduzca desde una cache los tramos ya vistos
+     * @param c Cache abierta (no se toma su propiedad), o nullptr para desactivarla
+     * 
+     * Se ignora con verificacion de integridad o bitacora configuradas. Ver
+     * CacheTramos.
+     */
+    void configurarCache(CacheTramos* c);
+    
+    /**
+     * @brief Graba en una cache lo que las tramas le piden a la lista de carga
+     * @param c Cache que graba el tramo en curso, o nullptr para dejar de grabar
+     */
+    void configurarGrabacion(CacheTramos* c);
+    
+    /**
+     * @brief Aplica un tramo grabado en lugar de decodificar sus lineas
+     * @param eventos Eventos grabados (ver CacheTramos::reproducir)
+     * @param longitud Bytes de eventos
+     * @param desplazamiento Rotor al terminar el tramo
+     * @param marca Ultima marca de tiempo del tramo, o TramaBase::SIN_MARCA
+     */
+    void reproducirTramo(const char* eventos, int longitud, int desplazamiento, long long marca);
+    
+    /**
+     * @brief Obtiene los caracteres perdidos por desborde de la lista de carga
+     */
+    long long getTotalDescartados() const;
+    
+    /**
+     * @brief Obtiene un caracter del mensaje en memoria por su posicion
+     * @param posicion Posicion desde el inicio del mensaje en memoria
+     * @return El caracter, o '\0' si la posicion no existe
+     */
+    char obtenerCaracter(int posicion) const;
+    
+    /**
+     * @brief Decodifica un caracter con la posicion actual del rotor
+     * @param c Caracter recibido en una trama de carga
+     * @return El caracter decodificado (no modifica el estado)
+     */
+    char mapearCaracter(char c);
+    
+    /**
+     * @brief Obtiene la posicion del rotor (0 = cabeza en 'A')
+     */
+    int getDesplazamiento() const;
+    
+    /**
+     * @brief Coloca el rotor en una posicion absoluta
+     * @param desplazamiento Posicion deseada (0 = cabeza en 'A'), se toma modulo 26
+     * 
+     * Junto con ejecutarArchivo(ruta, ..., desde) permite retomar una captura
+     * en un punto de IndiceCaptura sin repetir las tramas anteriores.
+     */
+    void posicionarRotor(int desplazamiento);
+    
+    /**
+     * @brief Obtiene cuantos caracteres se decodificaron desde el arranque
+     * @return Caracteres en memoria mas los ya volcados o cerrados
+     */
+    long long getTotalCaracteres() const;
+    
+    /**
+     * @brief Obtiene la marca de tiempo de la ultima trama que trajo una
+     * @return La marca, o TramaBase::SIN_MARCA si ninguna la trajo
+     * 
+     * Se actualiza antes de procesar la trama, asi que una SalidaCarga que
+     * reciba el texto volcado por esa trama ya ve su marca.
+     */
+    long long getMarcaTiempo() const;
+    
+    /**
+     * @brief Entrega el mensaje abierto sin detener el decodificador
+     */
+    void cerrarMensaje();
+    
+    /**
+     * @brief Vuelve al estado recien inicializado conservando la configuracion
+     * 
+     * Descarta el mensaje en memoria que aun no se volco, regresa el rotor
+     * a 'A' y vacia la bitacora. La ventana, la segmentacion y el
+     * vigilante configurados se mantienen.
+     */
+    void reiniciar();
+    
     /**
      * @brief Finaliza el decodificador mostrando el resultado
      */
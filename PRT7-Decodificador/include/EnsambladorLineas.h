@@ -0,0 +1,102 @@
+/**
+ * @file EnsambladorLineas.h
+ * @brief Ensamblador de lineas para entradas que llegan en bloques de bytes
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef ENSAMBLADORLINEAS_H
+#define ENSAMBLADORLINEAS_H
+
+/**
+ * @class ReceptorLineas
+ * @brief Clase base abstracta para recibir las lineas completas
+ */
+class ReceptorLineas {
+public:
+    /**
+     * @brief Destructor virtual para la destruccion polimorfica
+     */
+    virtual ~ReceptorLineas() {}
+
+    /**
+     * @brief Recibe una linea completa sin el salto de linea final
+     * @param linea Caracteres de la linea; no terminan en '\0'
+     * @param longitud Numero de caracteres de la linea
+     *
+     * La vista apunta al bloque que se esta alimentando o al buffer del
+     * ensamblador y solo es valida durante la llamada.
+     */
+    virtual void lineaCompleta(const char* linea, int longitud) = 0;
+};
+
+/**
+ * @class EnsambladorLineas
+ * @brief Junta bytes recibidos en bloques arbitrarios y entrega lineas completas
+ *
+ * Cada fuente (conexion, archivo, puerto) tiene su propio ensamblador, ya
+ * que una linea puede quedar repartida entre dos lecturas. Las lineas que
+ * caben completas en el bloque se entregan como vistas del propio bloque,
+ * sin copiarlas; solo el trozo de linea que queda al final de un bloque se
+ * guarda en el buffer. Las lineas mas largas que la capacidad se descartan
+ * completas hasta el siguiente '\n', sin copiarlas, asi el ruido no se
+ * convierte en tramas truncadas.
+ */
+class EnsambladorLineas {
+public:
+    static const int CAPACIDAD = 256; ///< Longitud maxima de una linea aceptada
+
+private:
+    char buffer[CAPACIDAD];     ///< Linea repartida entre bloques
+    int usados;                 ///< Bytes de la linea en construccion
+    bool descartando;           ///< Se esta saltando una linea demasiado larga
+    long long descartadas;      ///< Lineas descartadas por exceder la capacidad
+    long long consumidos;       ///< Bytes alimentados desde el inicio del flujo
+    long long finLinea;         ///< Desplazamiento que sigue a la ultima linea entregada
+
+    /**
+     * @brief Quita el '\r' final y entrega la linea al receptor
+     */
+    void entregar(const char* linea, int longitud, ReceptorLineas* receptor);
+
+public:
+    /**
+     * @brief Constructor que crea un ensamblador vacio
+     */
+    EnsambladorLineas();
+
+    /**
+     * @brief Procesa un bloque de bytes y entrega cada linea completa
+     * @param datos Bytes recibidos
+     * @param longitud Numero de bytes
+     * @param receptor Quien recibe las lineas completas
+     */
+    void alimentar(const char* datos, int longitud, ReceptorLineas* receptor);
+
+    /**
+     * @brief Entrega la ultima linea si quedo sin '\n' al terminar la entrada
+     * @param receptor Quien recibe la linea
+     */
+    void terminar(ReceptorLineas* receptor);
+
+    /**
+     * @brief Obtiene cuantas lineas se descartaron por ser demasiado largas
+     */
+    long long getDescartadas() const;
+
+    /**
+     * @brief Obtiene cuantos bytes esperan el fin de su linea
+     */
+    int getPendientes() const;
+
+    /**
+     * @brief Obtiene donde termina, en el flujo, la ultima linea entregada
+     * @return Desplazamiento del byte que sigue a su '\n' (inicio de la siguiente linea)
+     *
+     * Valido durante ReceptorLineas::lineaCompleta; lo usa IndiceCaptura
+     * para anotar desde donde se puede retomar la decodificacion.
+     */
+    long long getFinLinea() const;
+};
+
+#endif // ENSAMBLADORLINEAS_H
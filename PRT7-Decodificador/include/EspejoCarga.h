@@ -0,0 +1,119 @@
+/**
+ * @file EspejoCarga.h
+ * @brief Copia del estado del decodificador que otros hilos leen sin bloquearlo
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef ESPEJOCARGA_H
+#define ESPEJOCARGA_H
+
+#include <atomic>
+
+/**
+ * @struct InstantaneaCarga
+ * @brief Vista coherente del decodificador en un instante
+ */
+struct InstantaneaCarga {
+    long long version;         ///< Publicaciones hechas hasta esta vista
+    int tamanio;               ///< Caracteres del mensaje en memoria
+    long long totalInsertados; ///< Caracteres decodificados desde el arranque
+    long long totalMensajes;   ///< Mensajes cerrados
+    int desplazamiento;        ///< Posicion del rotor (0 = cabeza en 'A')
+    int copiados;              ///< Caracteres finales del mensaje copiados al texto
+};
+
+/**
+ * @class EspejoCarga
+ * @brief Estado publicado por el hilo decodificador para hilos de monitoreo
+ *
+ * La lista de carga libera nodos mientras decodifica, asi que ningun otro
+ * hilo puede recorrerla. El decodificador escribe ademas cada caracter en
+ * este espejo, en un arreglo circular indexado por posicion absoluta, y al
+ * terminar cada trama publica los contadores y el rotor.
+ *
+ * - Los contadores se publican con un seqlock: la secuencia es impar
+ *   mientras se escriben, y el lector repite si cambio durante su lectura.
+ * - El texto no usa la secuencia: el lector copia los ultimos caracteres y
+ *   despues comprueba que el escritor no haya dado la vuelta al arreglo
+ *   sobre ellos (frontera) ni haya quitado caracteres (retrocesos). La
+ *   frontera se anuncia de RESERVA en RESERVA posiciones, y como el lector
+ *   solo copia MAX_VISIBLE caracteres de CAPACIDAD, el escritor tiene
+ *   margen para seguir avanzando mientras tanto.
+ *
+ * El escritor nunca espera ni toma un candado; cada caracter cuesta un
+ * almacenamiento relajado y cada trama unos pocos mas. Hay un solo
+ * escritor (el hilo que llama al decodificador) y cualquier numero de
+ * lectores.
+ */
+class EspejoCarga {
+public:
+    static const int CAPACIDAD = 8192;            ///< Caracteres recientes guardados (potencia de 2)
+    static const int MAX_VISIBLE = CAPACIDAD / 2; ///< Caracteres que un lector puede copiar
+    static const int RESERVA = 256;               ///< Posiciones que el escritor anuncia de una vez
+
+private:
+    std::atomic<char> texto[CAPACIDAD];           ///< Caracter de cada posicion, modulo CAPACIDAD
+    alignas(64) std::atomic<long long> frontera;  ///< Cota de las posiciones escritas o por escribir
+    std::atomic<long long> retrocesos;            ///< Veces que se quitaron caracteres del final
+    alignas(64) std::atomic<unsigned long long> secuencia; ///< Impar mientras se publica
+    std::atomic<int> tamanio;                     ///< Publicado: caracteres en memoria
+    std::atomic<long long> totalInsertados;       ///< Publicado: caracteres desde el arranque
+    std::atomic<long long> totalMensajes;         ///< Publicado: mensajes cerrados
+    std::atomic<int> desplazamiento;              ///< Publicado: posicion del rotor
+    std::atomic<long long> retrocesosPublicados;  ///< Publicado: retrocesos hasta esta vista
+    alignas(64) long long fronteraEscritor;       ///< Copia privada del escritor
+    long long retrocesosEscritor;                 ///< Copia privada del escritor
+    unsigned long long secuenciaEscritor;         ///< Copia privada del escritor
+
+public:
+    /**
+     * @brief Constructor de un espejo vacio
+     */
+    EspejoCarga();
+
+    /**
+     * @brief Guarda un caracter insertado (solo el hilo escritor)
+     * @param posicion Posicion absoluta del caracter desde el arranque
+     * @param c Caracter decodificado
+     */
+    void anotar(long long posicion, char c) {
+        if (posicion >= fronteraEscritor) {
+            // Se anuncian RESERVA posiciones por adelantado: un lector que vea
+            // cualquiera de esos caracteres vera tambien la frontera nueva
+            fronteraEscritor = posicion + RESERVA;
+            frontera.store(fronteraEscritor, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        texto[posicion & (CAPACIDAD - 1)].store(c, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Avisa que se quito un caracter del final (solo el hilo escritor)
+     *
+     * La posicion se volvera a escribir con otro caracter, asi que los
+     * lectores en curso deben repetir.
+     */
+    void retroceder();
+
+    /**
+     * @brief Publica los contadores tras una trama (solo el hilo escritor)
+     * @param tam Caracteres del mensaje en memoria
+     * @param insertados Caracteres decodificados desde el arranque
+     * @param mensajes Mensajes cerrados
+     * @param rotor Posicion del rotor
+     */
+    void publicar(int tam, long long insertados, long long mensajes, int rotor);
+
+    /**
+     * @brief Toma una vista coherente desde cualquier hilo sin bloquear al escritor
+     * @param foto Recibe los contadores
+     * @param destino Recibe los ultimos caracteres del mensaje en memoria (puede ser nullptr)
+     * @param capacidad Caracteres que caben en destino (se copian a lo sumo MAX_VISIBLE)
+     * @param intentos Lecturas que se intentan antes de rendirse
+     * @return true si la vista es coherente; false si el escritor la cambio en todos los intentos
+     */
+    bool leer(InstantaneaCarga& foto, char* destino, int capacidad, int intentos = 1000) const;
+};
+
+#endif // ESPEJOCARGA_H
@@ -0,0 +1,147 @@
+/**
+ * @file IndiceCaptura.h
+ * @brief Indice de puntos de sincronizacion para retomar una captura sin repetirla
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef INDICECAPTURA_H
+#define INDICECAPTURA_H
+
+#include <cstdio>
+
+class VerificadorIntegridad; // forward
+
+/**
+ * @struct PuntoIndice
+ * @brief Estado del decodificador justo despues de una trama valida
+ */
+struct PuntoIndice {
+    long long entrada;    ///< Byte de la captura donde empieza la linea siguiente
+    long long caracteres; ///< Caracteres decodificados antes de este punto
+    int rotor;            ///< Desplazamiento del rotor en este punto [0, 25]
+};
+
+/**
+ * @class IndiceCaptura
+ * @brief Archivo lateral que permite decodificar una captura desde cualquier punto
+ *
+ * La cabeza del rotor depende de todas las tramas MAP anteriores, asi que
+ * sin indice hay que repetir la captura desde el byte 0. construir() la
+ * recorre una sola vez y cada INTERVALO tramas validas anota un
+ * PuntoIndice; el punto 0 es el inicio de la captura. Para retomar basta
+ * leer un punto, posicionar el rotor y leer la captura desde su byte
+ * (DecodificadorPRT7::posicionarRotor y ejecutarArchivo).
+ *
+ * Formato: una cabecera de TAM_CABECERA bytes ("PRT7IDX1", intervalo,
+ * tamanio de la captura, tramas y puntos) seguida de los puntos, cada uno
+ * de TAM_PUNTO bytes, en little-endian. Como los puntos tienen tamanio
+ * fijo, leerPunto() y buscarTrama() son O(1); buscarCaracter() hace una
+ * busqueda binaria sobre el archivo.
+ *
+ * El indice vale para la configuracion con la que se construyo (con o sin
+ * verificacion de integridad). Al retomar se pierden el estado del
+ * vigilante de patrones y la secuencia esperada por el verificador, que
+ * toma la primera trama como nuevo inicio.
+ */
+class IndiceCaptura {
+public:
+    static const int TAM_CABECERA = 40;          ///< Bytes de la cabecera
+    static const int TAM_PUNTO = 24;             ///< Bytes de cada punto
+    static const int INTERVALO_DEFECTO = 4096;   ///< Tramas entre puntos por defecto
+
+private:
+    std::FILE* archivo;      ///< Archivo del indice abierto para leer
+    int intervalo;           ///< Tramas validas entre dos puntos
+    long long tamanioCaptura; ///< Bytes de la captura al construir el indice
+    long long tramas;        ///< Tramas validas de la captura
+    long long puntos;        ///< Puntos guardados (incluido el punto 0)
+
+public:
+    /**
+     * @brief Constructor de un indice sin abrir
+     */
+    IndiceCaptura();
+
+    /**
+     * @brief Destructor que cierra el archivo del indice
+     */
+    ~IndiceCaptura();
+
+    /**
+     * @brief Recorre una captura y escribe su indice
+     * @param rutaCaptura Archivo de captura (tramas separadas por '\n')
+     * @param rutaIndice Archivo de indice a crear o reemplazar
+     * @param intervaloTramas Tramas validas entre dos puntos
+     * @param integridad Verificador a aplicar a cada linea, o nullptr
+     * @return true si el indice quedo escrito; luego queda abierto para consultas
+     */
+    bool construir(const char* rutaCaptura, const char* rutaIndice,
+                   int intervaloTramas = INTERVALO_DEFECTO, VerificadorIntegridad* integridad = nullptr);
+
+    /**
+     * @brief Abre un indice existente y lee su cabecera
+     * @param rutaIndice Archivo del indice
+     * @return false si no existe o no tiene el formato esperado
+     */
+    bool abrir(const char* rutaIndice);
+
+    /**
+     * @brief Lee un punto del indice
+     * @param numero Numero de punto, de 0 a getPuntos() - 1
+     * @param punto Recibe el punto
+     * @return false si el numero esta fuera de rango o fallo la lectura
+     */
+    bool leerPunto(long long numero, PuntoIndice& punto);
+
+    /**
+     * @brief Busca el ultimo punto que no pasa de una trama
+     * @param trama Numero de trama valida (0 = la primera)
+     * @return Numero del punto desde el que se llega a esa trama
+     */
+    long long buscarTrama(long long trama) const;
+
+    /**
+     * @brief Busca el ultimo punto con menos o igual caracteres que una posicion
+     * @param posicion Posicion del caracter decodificado (0 = el primero)
+     * @return Numero del punto, o -1 si no se pudo leer el indice
+     */
+    long long buscarCaracter(long long posicion);
+
+    /**
+     * @brief Obtiene las tramas validas entre dos puntos
+     */
+    int getIntervalo() const;
+
+    /**
+     * @brief Obtiene el tamanio que tenia la captura al construir el indice
+     */
+    long long getTamanioCaptura() const;
+
+    /**
+     * @brief Comprueba que una captura tenga el tamanio con que se construyo el indice
+     * @param rutaCaptura Archivo de captura que se va a retomar
+     * @return false si no existe o su tamanio es otro (indice viejo o de otra captura)
+     *
+     * Los puntos son desplazamientos en bytes: con otra captura se leeria
+     * desde posiciones arbitrarias y con un rotor que no corresponde.
+     */
+    bool coincideCaptura(const char* rutaCaptura) const;
+
+    /**
+     * @brief Obtiene las tramas validas de la captura
+     */
+    long long getTramas() const;
+
+    /**
+     * @brief Obtiene el numero de puntos del indice
+     */
+    long long getPuntos() const;
+
+    /**
+     * @brief Cierra el archivo del indice
+     */
+    void cerrar();
+};
+
+#endif // INDICECAPTURA_H
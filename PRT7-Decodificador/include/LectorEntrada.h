@@ -0,0 +1,132 @@
+/**
+ * @file LectorEntrada.h
+ * @brief Lector de archivos y dispositivos por bloques grandes con io_uring
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef LECTORENTRADA_H
+#define LECTORENTRADA_H
+
+struct AnilloUring; // forward
+
+/**
+ * @class LectorEntrada
+ * @brief Entrega en orden bloques grandes leidos de un archivo, tuberia o tty
+ * 
+ * En Linux con io_uring mantiene varias lecturas de TAM_BLOQUE bytes en
+ * vuelo: en archivos de captura cada bloque pide su propio desplazamiento,
+ * asi que el kernel lee por delante mientras el decodificador procesa; en
+ * tuberias y dispositivos de caracteres (sin desplazamiento) hay una
+ * lectura en vuelo mientras se procesa el bloque anterior. Si io_uring no
+ * esta disponible (kernel antiguo, seccomp, otro sistema) se usa read()
+ * bloqueante con el mismo tamanio de bloque; si io_uring_enter deja de
+ * aceptar lecturas a mitad de la entrada, se pasa a read() en ese punto.
+ * 
+ * Uso: siguienteBloque() devuelve el proximo bloque; el puntero es valido
+ * hasta la siguiente llamada, que recicla el bloque anterior.
+ */
+class LectorEntrada {
+public:
+    static const int TAM_BLOQUE = 256 * 1024; ///< Bytes por lectura
+    static const int MAX_BLOQUES = 8;         ///< Lecturas en vuelo como maximo
+    
+private:
+    int fd;                      ///< Descriptor de la entrada
+    bool propio;                 ///< El descriptor se abrio aqui y hay que cerrarlo
+    bool esArchivo;              ///< Entrada con desplazamiento (archivo regular)
+    long long tamanioArchivo;    ///< Tamanio del archivo regular
+    long long inicio;            ///< Desplazamiento desde el que se lee el archivo
+    char* memoria;               ///< Espacio de los bloques
+    int numBloques;              ///< Bloques en uso
+    int estado[MAX_BLOQUES];     ///< Estado de cada bloque (libre, en vuelo, completo)
+    int resultado[MAX_BLOQUES];  ///< Bytes leidos por cada bloque completo
+    long long secuencia[MAX_BLOQUES]; ///< Numero de orden de cada bloque
+    long long siguienteEnvio;    ///< Numero de orden de la proxima lectura a pedir
+    long long siguienteEntrega;  ///< Numero de orden del proximo bloque a entregar
+    int entregado;               ///< Bloque entregado que se recicla en la siguiente llamada
+    int enVuelo;                 ///< Lecturas pedidas y no completadas
+    bool finEnvio;               ///< Ya no hay que pedir mas lecturas
+    AnilloUring* uring;          ///< Estado de io_uring (nullptr = read() simple)
+    
+    /**
+     * @brief Intenta crear la instancia de io_uring
+     * @return true si esta disponible
+     */
+    bool iniciarUring();
+    
+    /**
+     * @brief Pide lecturas para todos los bloques libres que correspondan
+     *
+     * Solo cuentan como en vuelo las que io_uring_enter acepto; las demas
+     * se retiran de la cola y sus bloques quedan libres.
+     */
+    void enviarLecturas();
+    
+    /**
+     * @brief Espera al menos una lectura completa y registra su resultado
+     * @return false si ocurrio un error en io_uring
+     */
+    bool recogerCompletadas();
+    
+    /**
+     * @brief Abandona io_uring y sigue con read() desde el proximo bloque a entregar
+     * @return false si no se pudo posicionar el archivo
+     *
+     * Solo se llama sin lecturas en vuelo, cuando io_uring_enter rechazo las pedidas.
+     */
+    bool pasarARead();
+    
+    /**
+     * @brief Libera las colas y el descriptor de io_uring
+     */
+    void liberarUring();
+    
+public:
+    /**
+     * @brief Constructor de un lector sin abrir
+     */
+    LectorEntrada();
+    
+    /**
+     * @brief Destructor que cierra la entrada y libera los bloques
+     */
+    ~LectorEntrada();
+    
+    /**
+     * @brief Abre la entrada
+     * @param ruta Ruta del archivo o dispositivo, o "-" para la entrada estandar
+     * @param permitirUring false para forzar el modo read()
+     * @return true si se pudo abrir
+     */
+    bool abrir(const char* ruta, bool permitirUring = true);
+    
+    /**
+     * @brief Hace que la lectura empiece en un desplazamiento del archivo
+     * @param desplazamiento Byte desde el que se entregan los bloques
+     * @return false si la entrada no es un archivo regular o ya se leyo de ella
+     * 
+     * Debe llamarse justo despues de abrir(); lo usa la busqueda con IndiceCaptura.
+     */
+    bool posicionar(long long desplazamiento);
+    
+    /**
+     * @brief Obtiene el siguiente bloque leido, en orden
+     * @param datos Puntero a los bytes del bloque
+     * @param longitud Bytes del bloque
+     * @return false al llegar al fin de la entrada o ante un error
+     */
+    bool siguienteBloque(const char*& datos, int& longitud);
+    
+    /**
+     * @brief Indica si las lecturas se hacen con io_uring
+     */
+    bool usaUring() const;
+    
+    /**
+     * @brief Cierra la entrada
+     */
+    void cerrar();
+};
+
+#endif // LECTORENTRADA_H
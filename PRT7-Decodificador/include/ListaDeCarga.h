@@ -8,6 +8,15 @@
 #ifndef LISTADECARGA_H
 #define LISTADECARGA_H
 
+class SalidaCarga;
+class VigilantePatrones;
+class EspejoCarga;
+class CacheTramos;
+
+#ifndef PRT7_CAPACIDAD_CARGA
+#define PRT7_CAPACIDAD_CARGA 8192 ///< Nodos de la lista con PRT7_SIN_HEAP (CMake)
+#endif
+
 /**
  * @struct NodoCarga
  * @brief Nodo para la lista doblemente enlazada de carga
@@ -21,7 +30,7 @@ struct NodoCarga {
      * @brief Constructor del nodo
      * @param c El caracter a almacenar en el nodo
      */
-    NodoCarga(char c) : dato(c), siguiente(nullptr), anterior(nullptr) {}
+    NodoCarga(char c = '\0') : dato(c), siguiente(nullptr), anterior(nullptr) {}
 };
 
 /**
@@ -30,13 +39,100 @@ struct NodoCarga {
  * 
  * Esta clase implementa una lista doblemente enlazada para mantener
  * en orden los caracteres decodificados que forman el mensaje final.
+ * 
+ * Compilada con PRT7_SIN_HEAP los nodos salen de un arreglo fijo de
+ * PRT7_CAPACIDAD_CARGA nodos dentro del propio objeto, enlazados en una
+ * lista de libres, y el indice tambien es fijo: insertar y volcar nunca
+ * piden memoria. Cuando el arreglo se agota se aplica la PoliticaDesborde
+ * configurada.
  */
 class ListaDeCarga {
+public:
+    /**
+     * @brief Que hacer al insertar con todos los nodos ocupados (solo PRT7_SIN_HEAP)
+     */
+    enum PoliticaDesborde {
+        VOLCAR_ANTIGUOS,    ///< Volcar un lote a la salida antes de tiempo (sin salida se pierden)
+        DESCARTAR_NUEVO,    ///< Descartar el caracter que llega
+        DESCARTAR_ANTIGUOS  ///< Descartar sin entregar el lote mas antiguo
+    };
+    
 private:
     NodoCarga* cabeza; ///< Puntero al primer nodo de la lista
     NodoCarga* cola;   ///< Puntero al ultimo nodo de la lista
     int tamanio;       ///< Numero de elementos en la lista
     
+    SalidaCarga* salida;        ///< Destino de los caracteres volcados (modo ventana)
+    int capacidadVentana;       ///< Caracteres que se conservan en memoria (0 = sin limite)
+    int tamanioLote;            ///< Caracteres que se vuelcan de una sola vez
+    long long totalVolcados;    ///< Caracteres entregados a la salida y liberados
+    char delimitador;           ///< Caracter que cierra un mensaje ('\0' = ninguno)
+    long long totalMensajes;    ///< Mensajes cerrados y entregados
+    bool mensajeAbierto;        ///< Hay caracteres del mensaje actual (en memoria o ya volcados)
+    VigilantePatrones* vigilante; ///< Automata que observa cada caracter insertado
+    EspejoCarga* espejo;        ///< Copia para hilos de monitoreo (nullptr = ninguna)
+    CacheTramos* grabador;      ///< Cache que graba lo que aplican las tramas (nullptr = ninguna)
+    
+    PoliticaDesborde politica;  ///< Respuesta a quedarse sin nodos
+    long long totalDescartados; ///< Caracteres perdidos por desborde
+    
+    static const int SALTO_INDICE = 64; ///< Caracteres entre entradas del indice
+#ifdef PRT7_SIN_HEAP
+    static const int CAPACIDAD_INDICE = PRT7_CAPACIDAD_CARGA / SALTO_INDICE + 2; ///< Bloques que puede abarcar la lista
+    NodoCarga nodos[PRT7_CAPACIDAD_CARGA]; ///< Almacenamiento de todos los nodos
+    NodoCarga* libres;          ///< Nodos sin usar, enlazados por siguiente
+    NodoCarga* indice[CAPACIDAD_INDICE]; ///< Nodo al inicio de cada bloque de SALTO_INDICE posiciones absolutas
+#else
+    NodoCarga** indice;         ///< Nodo al inicio de cada bloque de SALTO_INDICE posiciones absolutas
+#endif
+    int indiceInicio;           ///< Primera entrada valida del arreglo del indice
+    int indiceCantidad;         ///< Numero de entradas validas del indice
+    int indiceCapacidad;        ///< Capacidad del arreglo del indice
+    long long bloqueBase;       ///< Bloque absoluto al que apunta la primera entrada valida
+    long long baseAbsoluta;     ///< Posicion absoluta de la cabeza desde el arranque
+    
+    /**
+     * @brief Obtiene un nodo nuevo (del arreglo fijo con PRT7_SIN_HEAP)
+     * @param c Caracter del nodo
+     * @return El nodo, o nullptr si el arreglo fijo esta agotado
+     */
+    NodoCarga* crearNodo(char c);
+    
+    /**
+     * @brief Devuelve un nodo que ya no esta en la lista
+     * @param nodo Nodo obtenido con crearNodo
+     */
+    void liberarNodo(NodoCarga* nodo);
+    
+    /**
+     * @brief Libera nodos segun la politica de desborde
+     * @return true si el caracter nuevo se puede insertar
+     */
+    bool resolverDesborde();
+    
+    /**
+     * @brief Entrega los primeros caracteres de la lista a la salida y libera sus nodos
+     * @param cantidad Numero de caracteres a volcar desde la cabeza
+     * @param entregar false para liberarlos sin escribirlos en la salida
+     */
+    void volcarInicio(int cantidad, bool entregar = true);
+    
+    /**
+     * @brief Agrega al indice un nodo que inicia un bloque
+     * @param nodo Nodo recien insertado cuya posicion absoluta es multiplo de SALTO_INDICE
+     */
+    void indexarNodo(NodoCarga* nodo);
+    
+    /**
+     * @brief Descarta las entradas del indice que ya no estan en la lista
+     */
+    void recortarIndice();
+    
+    /**
+     * @brief Cierra el mensaje sin avisar al grabador (ver cerrarMensaje)
+     */
+    void terminarMensaje(bool aunqueVacio);
+    
 public:
     /**
      * @brief Constructor que inicializa una lista vacia
@@ -89,6 +185,143 @@ public:
      * @brief Limpia toda la lista liberando la memoria
      */
     void limpiar();
+    
+    /**
+     * @brief Activa el modo de ventana deslizante para flujos sin fin
+     * @param destino Salida que recibe el texto ya completo
+     * @param ventana Numero de caracteres recientes que se conservan en memoria
+     * @param lote Numero de caracteres que se vuelcan en cada entrega
+     * 
+     * Cuando la lista alcanza ventana + lote caracteres, los lote mas antiguos
+     * se escriben en la salida y sus nodos se liberan, de modo que la memoria
+     * queda acotada sin importar cuanto dure la sesion. Con ventana 0 la
+     * lista crece sin limite y todo se entrega en vaciarVentana(); con
+     * destino nulo se desactiva el volcado.
+     */
+    void configurarVentana(SalidaCarga* destino, int ventana, int lote);
+    
+    /**
+     * @brief Vuelca todo el contenido pendiente a la salida (modo ventana)
+     * 
+     * Se usa al finalizar para que la salida reciba tambien la cola que
+     * aun estaba en memoria.
+     */
+    void vaciarVentana();
+    
+    /**
+     * @brief Indica si la lista vuelca su contenido a una salida
+     * @return true si hay una salida configurada
+     */
+    bool enModoVentana() const;
+    
+    /**
+     * @brief Obtiene el numero de caracteres ya volcados y liberados
+     * @return Total de caracteres entregados a la salida
+     */
+    long long getTotalVolcados() const;
+    
+    /**
+     * @brief Configura el caracter decodificado que marca el fin de un mensaje
+     * @param c Caracter delimitador, o '\0' para desactivar
+     * 
+     * Al recibir el delimitador no se almacena; en su lugar se cierra
+     * el mensaje en curso con cerrarMensaje().
+     */
+    void configurarDelimitador(char c);
+    
+    /**
+     * @brief Cierra el mensaje en curso y libera su memoria
+     * 
+     * Con una salida configurada entrega el contenido pendiente seguido
+     * de SalidaCarga::finMensaje(); sin salida imprime el mensaje en
+     * consola. En ambos casos la lista queda vacia para el siguiente.
+     * 
+     * @param aunqueVacio true para emitir tambien un mensaje sin caracteres;
+     * lo usan los cierres explicitos (trama FIN y delimitador), mientras
+     * que la inactividad y el cierre final no emiten mensajes vacios.
+     */
+    void cerrarMensaje(bool aunqueVacio = false);
+    
+    /**
+     * @brief Obtiene el numero de mensajes cerrados
+     * @return Total de mensajes entregados
+     */
+    long long getTotalMensajes() const;
+    
+    /**
+     * @brief Asocia un vigilante de patrones que recibe cada caracter insertado
+     * @param v Vigilante ya construido, o nullptr para desactivarlo
+     * 
+     * El vigilante avanza dentro de insertarAlFinal(), por lo que detecta
+     * palabras repartidas entre tramas; se reinicia al cerrar cada mensaje.
+     */
+    void configurarVigilante(VigilantePatrones* v);
+    
+    /**
+     * @brief Asocia un espejo que recibe cada caracter insertado
+     * @param e Espejo ya construido, o nullptr para desactivarlo
+     * 
+     * Otros hilos no deben llamar a ningun metodo de la lista; leen el
+     * espejo (ver EspejoCarga::leer). Los contadores del espejo los publica
+     * DecodificadorPRT7 al terminar cada trama.
+     */
+    void configurarEspejo(EspejoCarga* e);
+    
+    /**
+     * @brief Asocia una cache que graba cada insercion y cada cierre pedidos
+     * @param c Cache que esta grabando un tramo, o nullptr para dejar de grabar
+     * 
+     * Se graba lo que piden las tramas, antes del delimitador, la ventana
+     * y el vigilante: al reproducirlo con insertarAlFinal() y cerrarMensaje()
+     * esa configuracion se vuelve a aplicar (ver CacheTramos::reproducir).
+     */
+    void configurarGrabador(CacheTramos* c);
+    
+    /**
+     * @brief Obtiene el caracter en una posicion de la lista
+     * @param posicion Posicion desde la cabeza (0 = primer caracter en memoria)
+     * @return El caracter almacenado, o '\0' si la posicion no existe
+     * 
+     * Usa un indice con un puntero cada SALTO_INDICE caracteres, por lo que
+     * el costo es O(1) para llegar al bloque mas a lo sumo SALTO_INDICE - 1
+     * pasos dentro de el, sin importar el largo de la lista.
+     */
+    char obtenerEn(int posicion) const;
+    
+    /**
+     * @brief Elimina el ultimo caracter de la lista
+     * @return true si habia un caracter que quitar
+     */
+    bool quitarDelFinal();
+    
+    /**
+     * @brief Obtiene cuantos caracteres se han insertado desde el arranque
+     * @return Caracteres en memoria mas los ya volcados o liberados
+     */
+    long long getTotalInsertados() const;
+    
+    /**
+     * @brief Elige que hacer cuando no quedan nodos libres
+     * @param p Politica a aplicar (por defecto VOLCAR_ANTIGUOS)
+     * 
+     * Solo tiene efecto con PRT7_SIN_HEAP; sin esa opcion la lista crece
+     * con new y nunca se desborda. Conviene ventana + lote <= capacidad
+     * para que VOLCAR_ANTIGUOS no tenga que actuar.
+     */
+    void configurarDesborde(PoliticaDesborde p);
+    
+    /**
+     * @brief Obtiene los caracteres perdidos por desborde
+     * @return Caracteres descartados por DESCARTAR_NUEVO, DESCARTAR_ANTIGUOS,
+     *         o por VOLCAR_ANTIGUOS sin salida configurada
+     */
+    long long getTotalDescartados() const;
+    
+    /**
+     * @brief Obtiene cuantos nodos puede tener la lista a la vez
+     * @return PRT7_CAPACIDAD_CARGA con PRT7_SIN_HEAP, 0 (sin limite) sin ella
+     */
+    static int getCapacidad();
 };
 
 #endif // LISTADECARGA_H
\ No newline at end of file
@@ -0,0 +1,182 @@
+/**
+ * @file MezcladorCapturas.h
+ * @brief Mezcla por marca de tiempo de capturas de varios puertos en una sola linea de tiempo
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef MEZCLADORCAPTURAS_H
+#define MEZCLADORCAPTURAS_H
+
+struct FlujoCaptura; // forward
+
+/**
+ * @struct EntradaMonticulo
+ * @brief Captura del monticulo con la marca de su linea actual copiada
+ *
+ * La marca se copia para comparar sin ir al FlujoCaptura de cada hija.
+ */
+struct EntradaMonticulo {
+    long long marca; ///< Marca de la linea actual de la captura
+    int captura;     ///< Numero de la captura
+};
+
+/**
+ * @class SalidaLineaTiempo
+ * @brief Clase base abstracta para recibir el texto decodificado de todas las capturas
+ */
+class SalidaLineaTiempo {
+public:
+    /**
+     * @brief Destructor virtual para la destruccion polimorfica
+     */
+    virtual ~SalidaLineaTiempo() {}
+
+    /**
+     * @brief Recibe un bloque de texto decodificado de una captura
+     * @param flujo Numero de la captura (en el orden en que se agregaron)
+     * @param marca Marca de tiempo de la trama que produjo el volcado
+     * @param datos Caracteres (no terminados en '\0')
+     * @param longitud Numero de caracteres
+     */
+    virtual void escribir(int flujo, long long marca, const char* datos, int longitud) = 0;
+
+    /**
+     * @brief Marca el final de un mensaje de una captura
+     * @param flujo Numero de la captura
+     * @param marca Marca de tiempo de la trama que cerro el mensaje
+     * @param vacio true si el mensaje no tuvo caracteres
+     */
+    virtual void finMensaje(int flujo, long long marca, bool vacio) {
+        (void)flujo;
+        (void)marca;
+        (void)vacio;
+    }
+};
+
+/**
+ * @class SalidaLineaTiempoConsola
+ * @brief Escribe cada bloque en la salida estandar como "@marca [flujo] texto"
+ *
+ * Un mensaje que cabe en la ventana sale en una sola linea; uno mas largo
+ * sale en varias lineas con el mismo [flujo]. Los mensajes vacios salen
+ * como una linea sin texto.
+ */
+class SalidaLineaTiempoConsola : public SalidaLineaTiempo {
+public:
+    void escribir(int flujo, long long marca, const char* datos, int longitud) override;
+    void finMensaje(int flujo, long long marca, bool vacio) override;
+};
+
+/**
+ * @class MezcladorCapturas
+ * @brief Intercala N capturas ordenadas por marca de tiempo, cada una con su decodificador
+ *
+ * Cada emisor tiene su propio rotor, asi que cada captura conserva su
+ * DecodificadorPRT7; lo que se mezcla es el orden en que se procesan sus
+ * lineas. Un monticulo binario de capturas, ordenado por (marca de la
+ * linea actual, numero de captura), elige siempre la linea mas antigua;
+ * mientras la captura de la cima siga sin pasar a la menor de sus hijas se
+ * procesan sus lineas sin reordenar el monticulo, de modo que las rachas
+ * largas cuestan lo mismo que un recorrido secuencial.
+ *
+ * Las lineas sin marca heredan la de la linea anterior de su captura. Si
+ * una captura no esta ordenada se procesa igual en su propio orden y la
+ * linea se cuenta en getDesordenadas(). La memoria es acotada: por captura
+ * un bloque de TAM_BLOQUE bytes mas la ventana de su lista de carga. Las
+ * lineas mas largas que EnsambladorLineas::CAPACIDAD se descartan, igual
+ * que en el resto de entradas.
+ */
+class MezcladorCapturas {
+public:
+    static const int TAM_BLOQUE = 16 * 1024; ///< Bytes leidos de cada captura por vez
+
+private:
+    FlujoCaptura** flujos;       ///< Capturas agregadas
+    int cantidad;                ///< Numero de capturas
+    int capacidad;               ///< Tamanio del arreglo de capturas
+    EntradaMonticulo* monticulo; ///< Capturas con lineas pendientes
+    int enMonticulo;             ///< Capturas en el monticulo
+    int ventana;                 ///< Ventana de la lista de carga de cada captura
+    int lote;                    ///< Lote de volcado de cada captura
+    char delimitador;            ///< Delimitador de mensajes de cada captura
+    SalidaLineaTiempo* salida;   ///< Destino del texto
+    long long lineas;            ///< Lineas procesadas
+    long long tramas;            ///< Tramas validas
+    long long desordenadas;      ///< Lineas con marca menor que la anterior de su captura
+
+    /**
+     * @brief Indica si la entrada a va antes que la b
+     */
+    static bool precede(const EntradaMonticulo& a, const EntradaMonticulo& b);
+
+    /**
+     * @brief Baja una captura del monticulo hasta su lugar
+     * @param posicion Posicion en el monticulo
+     */
+    void hundir(int posicion);
+
+public:
+    /**
+     * @brief Constructor de un mezclador sin capturas
+     */
+    MezcladorCapturas();
+
+    /**
+     * @brief Destructor que cierra las capturas
+     */
+    ~MezcladorCapturas();
+
+    /**
+     * @brief Configura el decodificador de cada captura
+     * @param ventanaN Caracteres en memoria por captura (debe ser > 0)
+     * @param loteN Caracteres por volcado
+     * @param delim Caracter que cierra mensajes ('\0' = ninguno)
+     *
+     * Debe llamarse antes de agregar las capturas.
+     */
+    void configurarSesiones(int ventanaN, int loteN, char delim);
+
+    /**
+     * @brief Asigna el destino del texto decodificado
+     * @param destino Salida que recibe los bloques de todas las capturas
+     */
+    void configurarSalida(SalidaLineaTiempo* destino);
+
+    /**
+     * @brief Abre una captura y la agrega a la mezcla
+     * @param ruta Archivo de captura
+     * @return Numero de la captura, o -1 si no se pudo abrir
+     */
+    int agregar(const char* ruta);
+
+    /**
+     * @brief Mezcla todas las capturas hasta agotarlas
+     *
+     * Cada captura se finaliza en cuanto se agota, asi que su ultimo
+     * mensaje aparece en su lugar de la linea de tiempo.
+     */
+    void ejecutar();
+
+    /**
+     * @brief Obtiene el numero de capturas agregadas
+     */
+    int getCapturas() const;
+
+    /**
+     * @brief Obtiene las lineas procesadas
+     */
+    long long getLineas() const;
+
+    /**
+     * @brief Obtiene las tramas validas procesadas
+     */
+    long long getTramas() const;
+
+    /**
+     * @brief Obtiene las lineas cuya marca retrocede dentro de su captura
+     */
+    long long getDesordenadas() const;
+};
+
+#endif // MEZCLADORCAPTURAS_H
@@ -0,0 +1,154 @@
+/**
+ * @file PerfilMemoria.h
+ * @brief Conteo de asignaciones de memoria por trama y por fase del decodificador
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Con la opcion de CMake PRT7_PERFIL_MEMORIA, la biblioteca estatica
+ * reemplaza operator new/delete para contar asignaciones, liberaciones,
+ * bytes y el pico de bytes vivos. La compartida no lo reemplaza (seria el
+ * asignador de todo el proceso anfitrion), asi que con ella no cuenta nada. Cada conteo se atribuye a la fase en curso del hilo
+ * que asigna y, si ese hilo esta decodificando una trama, al tipo de esa
+ * trama. DecodificadorPRT7::finalizar() imprime el desglose en stderr.
+ * Sin la opcion, las macros no generan codigo.
+ *
+ * Fases:
+ *   parseo    crear y destruir el objeto de la trama
+ *   proceso   TramaBase::procesar fuera de la lista (rotor, bitacora, salida)
+ *   almacen   nodos e indice de la lista de carga
+ *   reinicio  inicializar(), reiniciar() y el destructor del decodificador
+ *   fuera     cualquier otro punto (configuracion, lectura, otros hilos)
+ *
+ * Las asignaciones de una trama se acumulan aparte y se suman a su tipo
+ * (L, L*n, M, F o linea rechazada) al liberarla; las que ocurren sin
+ * trama abierta van a la fila "sin trama".
+ */
+
+#ifndef PERFILMEMORIA_H
+#define PERFILMEMORIA_H
+
+#ifdef PRT7_PERFIL_MEMORIA
+
+#include <cstddef>
+
+/**
+ * @class PerfilMemoria
+ * @brief Contadores globales de memoria dinamica por tipo de trama y fase
+ */
+class PerfilMemoria {
+public:
+    /**
+     * @enum Fase
+     * @brief Parte del decodificador a la que se atribuye una asignacion
+     */
+    enum Fase {
+        FUERA,    ///< Ninguna fase del decodificador
+        PARSEO,   ///< Creacion y destruccion de la trama
+        PROCESO,  ///< Procesamiento de la trama
+        ALMACEN,  ///< Nodos e indice de la lista de carga
+        REINICIO, ///< Inicializacion, reinicio y destruccion
+        NUM_FASES
+    };
+
+    /**
+     * @enum Clase
+     * @brief Fila del desglose: tipo de trama, o ninguna
+     */
+    enum Clase {
+        CARGA,     ///< "L,x"
+        LOTE,      ///< "L*n,..."
+        MAPEO,     ///< "M,n"
+        FIN,       ///< "F,"
+        RECHAZADA, ///< Linea que no resulto ser trama
+        SIN_TRAMA, ///< Fuera de cualquier trama
+        NUM_CLASES
+    };
+
+    /**
+     * @brief Registra una asignacion (lo llama operator new)
+     * @param bytes Bytes pedidos
+     */
+    static void registrarAsignacion(std::size_t bytes);
+
+    /**
+     * @brief Registra una liberacion (lo llama operator delete)
+     * @param bytes Bytes de la asignacion liberada
+     */
+    static void registrarLiberacion(std::size_t bytes);
+
+    /**
+     * @brief Cambia la fase del hilo actual
+     * @param fase Nueva fase; dentro de REINICIO se ignora
+     * @return La fase anterior, para restaurarla
+     */
+    static Fase entrarFase(Fase fase);
+
+    /**
+     * @brief Restaura la fase devuelta por entrarFase()
+     */
+    static void salirFase(Fase anterior);
+
+    /**
+     * @brief Empieza a acumular aparte las asignaciones de una trama
+     */
+    static void abrirTrama();
+
+    /**
+     * @brief Indica el tipo de la trama abierta
+     * @param tipo 'L', 'B' (lote "L*n"), 'M' o 'F'
+     */
+    static void tipoTrama(char tipo);
+
+    /**
+     * @brief Suma lo acumulado a la fila del tipo de la trama (o RECHAZADA)
+     */
+    static void cerrarTrama();
+
+    /**
+     * @brief Imprime el desglose en stderr si se cerraron tramas desde el anterior
+     */
+    static void reportar();
+
+    /**
+     * @brief Obtiene las asignaciones totales desde el arranque
+     */
+    static long long getAsignaciones();
+
+    /**
+     * @brief Obtiene el maximo de bytes vivos a la vez
+     */
+    static long long getPicoBytes();
+};
+
+/**
+ * @class FaseMemoria
+ * @brief Atribuye a una fase las asignaciones del bloque donde vive
+ *
+ * Uso: { FaseMemoria f(PerfilMemoria::ALMACEN); ... }
+ */
+class FaseMemoria {
+private:
+    PerfilMemoria::Fase anterior; ///< Fase a restaurar
+
+public:
+    explicit FaseMemoria(PerfilMemoria::Fase fase) : anterior(PerfilMemoria::entrarFase(fase)) {}
+    ~FaseMemoria() { PerfilMemoria::salirFase(anterior); }
+
+    FaseMemoria(const FaseMemoria&) = delete;
+    FaseMemoria& operator=(const FaseMemoria&) = delete;
+};
+
+    #define PRT7_PERFIL_FASE(fase) FaseMemoria faseMemoria(PerfilMemoria::fase)
+    #define PRT7_PERFIL_ABRIR_TRAMA() PerfilMemoria::abrirTrama()
+    #define PRT7_PERFIL_TIPO_TRAMA(tipo) PerfilMemoria::tipoTrama(tipo)
+    #define PRT7_PERFIL_CERRAR_TRAMA() PerfilMemoria::cerrarTrama()
+    #define PRT7_PERFIL_REPORTAR() PerfilMemoria::reportar()
+#else
+    #define PRT7_PERFIL_FASE(fase) ((void)0)
+    #define PRT7_PERFIL_ABRIR_TRAMA() ((void)0)
+    #define PRT7_PERFIL_TIPO_TRAMA(tipo) ((void)0)
+    #define PRT7_PERFIL_CERRAR_TRAMA() ((void)0)
+    #define PRT7_PERFIL_REPORTAR() ((void)0)
+#endif
+
+#endif // PERFILMEMORIA_H
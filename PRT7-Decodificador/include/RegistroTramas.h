@@ -0,0 +1,86 @@
+/**
+ * @file RegistroTramas.h
+ * @brief Registro de los tipos de trama que reconoce el decodificador
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Cada fila asocia una etiqueta y la forma de su dato con la fabrica de
+ * su clase. AutomataTramas genera en compilacion su tabla de transiciones
+ * a partir de este arreglo, asi que agregar un tipo de trama es agregar
+ * su clase (con un constructor que reciba DatoTrama) y una fila aqui.
+ */
+
+#ifndef REGISTROTRAMAS_H
+#define REGISTROTRAMAS_H
+
+#include "TramaBase.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "TramaFin.h"
+#include <new>
+
+static const int TAM_MAX_TRAMA = 48; ///< Bytes maximos de cualquier trama registrada
+
+/**
+ * @brief Funcion que construye una trama a partir de su dato
+ * @param espacio Almacenamiento de TAM_MAX_TRAMA bytes (solo con PRT7_SIN_HEAP)
+ * @param dato Dato reconocido por el automata
+ */
+typedef TramaBase* (*FabricaTrama)(void* espacio, const DatoTrama& dato);
+
+/**
+ * @struct TipoTrama
+ * @brief Fila del registro: sintaxis y fabrica de un tipo de trama
+ *
+ * La sintaxis es "<etiqueta>,<dato>" (la etiqueta en mayuscula o
+ * minuscula, con espacios antes de la coma), o "<etiqueta>*<n>,<n
+ * caracteres>" para la forma LOTE. Una etiqueta puede tener una fila con
+ * coma y otra LOTE; si se repite, gana la primera.
+ */
+struct TipoTrama {
+    /**
+     * @enum Forma
+     * @brief Como se lee el dato que sigue a la coma
+     */
+    enum Forma {
+        SIN_DATO, ///< Nada ("F,")
+        CARACTER, ///< Primer caracter tras los espacios; ' ' si no hay ("L,x")
+        ENTERO,   ///< Entero con signo, saturado ("M,-3")
+        LOTE      ///< n caracteres tomados por longitud ("L*3,abc")
+    };
+
+    char etiqueta;       ///< Letra mayuscula que abre la trama
+    Forma forma;         ///< Forma del dato
+    char sonda;          ///< Tipo que informan las sondas y el perfil de memoria
+    FabricaTrama fabricar; ///< Construye la trama
+};
+
+/**
+ * @brief Fabrica generica: construye T a partir del dato
+ */
+template <typename T>
+TramaBase* fabricarTrama(void* espacio, const DatoTrama& dato) {
+    static_assert(sizeof(T) <= TAM_MAX_TRAMA && alignof(T) <= 8,
+                  "Toda trama registrada debe caber en TAM_MAX_TRAMA");
+#ifdef PRT7_SIN_HEAP
+    // Cada trama se procesa y se libera antes de parsear la siguiente
+    return new (espacio) T(dato);
+#else
+    (void)espacio;
+    return new T(dato);
+#endif
+}
+
+/**
+ * @brief Tipos de trama reconocidos, en orden de prioridad
+ */
+inline constexpr TipoTrama REGISTRO_TRAMAS[] = {
+    {'L', TipoTrama::CARACTER, 'L', &fabricarTrama<TramaLoad>},
+    {'L', TipoTrama::LOTE,     'B', &fabricarTrama<TramaLoad>},
+    {'M', TipoTrama::ENTERO,   'M', &fabricarTrama<TramaMap>},
+    {'F', TipoTrama::SIN_DATO, 'F', &fabricarTrama<TramaFin>},
+};
+
+inline constexpr int NUM_TIPOS_TRAMA = (int)(sizeof(REGISTRO_TRAMAS) / sizeof(REGISTRO_TRAMAS[0]));
+
+#endif // REGISTROTRAMAS_H
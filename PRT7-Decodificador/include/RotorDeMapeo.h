@@ -21,7 +21,7 @@ struct NodoRotor {
      * @brief Constructor del nodo
      * @param c El caracter a almacenar en el nodo
      */
-    NodoRotor(char c) : dato(c), siguiente(nullptr), anterior(nullptr) {}
+    NodoRotor(char c = 'A') : dato(c), siguiente(nullptr), anterior(nullptr) {}
 };
 
 /**
@@ -31,11 +31,16 @@ struct NodoRotor {
  * Esta clase implementa una lista circular que contiene el alfabeto A-Z y
  * permite rotaciones para cambiar el mapeo de caracteres. Actua como un
  * "disco de cifrado" similar a las maquinas Enigma.
+ * 
+ * Con PRT7_SIN_HEAP los 26 nodos viven dentro del propio objeto.
  */
 class RotorDeMapeo {
 private:
     NodoRotor* cabeza; ///< Puntero a la posicion "cero" actual del rotor
     int tamanio;       ///< Numero de elementos en el rotor (26 para A-Z)
+#ifdef PRT7_SIN_HEAP
+    NodoRotor nodos[26]; ///< Almacenamiento fijo de los nodos
+#endif
     
     /**
      * @brief Busca un nodo que contenga el caracter especificado
@@ -75,6 +80,17 @@ public:
      */
     char getMapeo(char caracterEntrada);
     
+    /**
+     * @brief Mapea varios caracteres con la rotacion actual
+     * @param origen Caracteres a mapear
+     * @param longitud Numero de caracteres
+     * @param destino Donde escribir los caracteres mapeados
+     * 
+     * Equivale a llamar getMapeo por cada caracter, pero recorre el rotor
+     * una sola vez para armar la tabla de mapeo.
+     */
+    void mapearBloque(const char* origen, int longitud, char* destino);
+    
     /**
      * @brief Muestra el estado actual del rotor (para depuracion)
      */
@@ -85,6 +101,12 @@ public:
      * @return El caracter en la posicion de la cabeza
      */
     char getCabeza();
+    
+    /**
+     * @brief Obtiene cuantas posiciones esta rotada la cabeza respecto a 'A'
+     * @return Desplazamiento en el rango [0, 25]
+     */
+    int getDesplazamiento() const;
 };
 
 #endif // ROTORDEMAPEO_H
\ No newline at end of file
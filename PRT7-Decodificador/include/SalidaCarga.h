@@ -0,0 +1,61 @@
+/**
+ * @file SalidaCarga.h
+ * @brief Destinos de salida para el texto decodificado que se vuelca desde la ListaDeCarga
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef SALIDACARGA_H
+#define SALIDACARGA_H
+
+/**
+ * @class SalidaCarga
+ * @brief Clase base abstracta para cualquier destino del texto decodificado
+ *
+ * La ListaDeCarga entrega a la salida bloques de caracteres ya completos
+ * para poder liberar sus nodos. Cada implementacion decide a donde van
+ * (consola, archivo, socket, etc.).
+ */
+class SalidaCarga {
+public:
+    /**
+     * @brief Destructor virtual para la destruccion polimorfica
+     */
+    virtual ~SalidaCarga() {}
+
+    /**
+     * @brief Recibe un bloque de caracteres decodificados
+     * @param datos Puntero a los caracteres (no terminados en '\0')
+     * @param longitud Numero de caracteres del bloque
+     */
+    virtual void escribir(const char* datos, int longitud) = 0;
+    
+    /**
+     * @brief Marca el final de un mensaje completo
+     * 
+     * Se invoca despues de entregar el ultimo bloque de cada mensaje
+     * cuando la segmentacion esta activa. Por defecto no hace nada.
+     */
+    virtual void finMensaje() {}
+};
+
+/**
+ * @class SalidaConsola
+ * @brief Salida que escribe los bloques directamente en la salida estandar
+ */
+class SalidaConsola : public SalidaCarga {
+public:
+    /**
+     * @brief Escribe el bloque en std::cout sin agregar saltos de linea
+     * @param datos Puntero a los caracteres
+     * @param longitud Numero de caracteres del bloque
+     */
+    void escribir(const char* datos, int longitud) override;
+    
+    /**
+     * @brief Termina la linea del mensaje actual
+     */
+    void finMensaje() override;
+};
+
+#endif // SALIDACARGA_H
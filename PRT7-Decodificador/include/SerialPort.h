@@ -1,6 +1,6 @@
 /**
  * @file SerialPort.h
- * @brief Envoltorio minimo para leer lineas desde un puerto COM en Windows (Win32 API)
+ * @brief Envoltorio minimo para leer desde un puerto serial (Win32 API o termios POSIX)
  */
 
 #ifndef SERIALPORT_H
@@ -10,11 +10,80 @@
 #include <windows.h>
 #endif
 
+struct ColaRecepcion; // forward
+
+/**
+ * @class SerialPort
+ * @brief Puerto serial con control de flujo opcional regulado por la cola de entrada
+ *
+ * Sin iniciarRecepcion(), leer() lee directamente del controlador. Con
+ * ella, un hilo vacia el puerto continuamente hacia una cola de
+ * CAPACIDAD_COLA bytes y leer() toma los bytes de esa cola; asi el buffer
+ * del controlador (1024 bytes en Windows, 4 KiB en Linux) ya no se
+ * desborda mientras el decodificador va atrasado. Si la cola pasa de 3/4,
+ * se pide al emisor que pare (XOFF o RTS bajo) y se le deja seguir
+ * cuando baja de 1/4; el cuarto libre absorbe los bytes que ya venian en
+ * camino. Si aun asi se llena (o no hay control de flujo), el hilo sigue
+ * leyendo y descarta, y los bytes descartados se cuentan en getPerdidos().
+ *
+ * Con XON_XOFF el flujo no puede transportar los bytes 0x11 y 0x13, lo
+ * que no afecta a las tramas PRT-7 (texto).
+ *
+ * configurarBajaLatencia() cambia las esperas por sondeo activo: el
+ * descriptor pasa a no bloqueante (sin VTIME ni COMMTIMEOUTS de 50/100 ms)
+ * y tanto el hilo lector como leer() giran hasta que hay bytes, asi que un
+ * byte llega al decodificador sin despertar a ningun hilo. Cada hilo que
+ * sondea ocupa un nucleo entero; con menos nucleos ceden el procesador
+ * tras unas vueltas, lo que funciona pero sin la latencia prometida. Un
+ * hilo de tiempo real no cede: duerme unos microsegundos (ver
+ * fijarHiloActual).
+ */
 class SerialPort {
+public:
+    /**
+     * @brief Control de flujo hacia el emisor
+     */
+    enum ControlFlujo {
+        SIN_CONTROL, ///< Ninguno: si la cola se llena se pierden bytes
+        XON_XOFF,    ///< Software: se envian XOFF (0x13) y XON (0x11)
+        RTS_CTS      ///< Hardware: se baja y sube la linea RTS
+    };
+
+    static const int CAPACIDAD_COLA = 1 << 16; ///< Bytes de la cola de recepcion
+    
+    /**
+     * @brief Afinidad y planificacion de un hilo, para restaurarlas despues de fijarlo
+     */
+    struct EstadoHilo {
+        unsigned long long nucleos[16]; ///< Mascara de afinidad (hasta 1024 nucleos)
+        int politica;                   ///< Politica de planificacion (sin uso en Windows)
+        int prioridad;                  ///< Prioridad dentro de la politica
+        bool guardado;                  ///< Se pudo leer el estado anterior
+    };
+
+private:
 #ifdef _WIN32
     HANDLE handle;
+#else
+    int fd;
 #endif
     bool abierto;
+    ControlFlujo control;   ///< Control de flujo configurado en abrir()
+    ColaRecepcion* cola;    ///< Cola del hilo lector (nullptr = leer directo)
+    bool bajaLatencia;      ///< Sondeo activo en lugar de esperas con timeout
+    int nucleoLector;       ///< Nucleo del hilo lector (-1 = sin fijar)
+    bool tiempoReal;        ///< Hilo lector con SCHED_FIFO
+
+    /**
+     * @brief Lee del controlador sin pasar por la cola
+     * @return Bytes leidos, 0 si timeout, -1 si error
+     */
+    int leerPuerto(char* buffer, int maxLen);
+
+    /**
+     * @brief Cuerpo del hilo lector: vacia el puerto hacia la cola
+     */
+    void recibir();
 
 public:
     SerialPort();
@@ -22,19 +91,90 @@ public:
 
     /**
      * @brief Abre el puerto serial
-     * @param puerto Nombre del puerto, por ejemplo "COM3" (se convierte a \\ \\.\\COM3)
+     * @param puerto Nombre del puerto, por ejemplo "COM3" (se convierte a \\ \\.\\COM3) o "/dev/ttyUSB0"
      * @param baud   Velocidad en baudios (ej. 9600)
+     * @param controlFlujo Control de flujo hacia el emisor
      * @return true si abrio correctamente
+     *
+     * En 8N1, con timeout de lectura de unos 100 ms.
+     */
+    bool abrir(const char* puerto, unsigned long baud, ControlFlujo controlFlujo = SIN_CONTROL);
+
+    /**
+     * @brief Activa el modo de baja latencia (despues de abrir, antes de iniciarRecepcion)
+     * @param nucleo Nucleo al que se fija el hilo lector (-1 = sin fijar)
+     * @param tiempoReal Ejecutar el hilo lector con SCHED_FIFO (requiere privilegios)
+     * @return false si el puerto no esta abierto o no admite lecturas no bloqueantes
+     *
+     * En Linux pide ademas ASYNC_LOW_LATENCY al controlador, si lo admite.
+     * Con este modo leer() devuelve 0 tras 1 ms sin datos en lugar de 100 ms.
+     */
+    bool configurarBajaLatencia(int nucleo, bool tiempoReal);
+
+    /**
+     * @brief Fija el hilo que llama a un nucleo y opcionalmente a tiempo real
+     * @param nucleo Nucleo (-1 = no cambiar la afinidad)
+     * @param tiempoReal SCHED_FIFO en POSIX, THREAD_PRIORITY_TIME_CRITICAL en Windows
+     * @param anterior Si no es nullptr, recibe el estado previo para restaurarHiloActual
+     * @return false si el sistema rechazo alguno de los cambios
+     *
+     * Un hilo de tiempo real que sondea sin ceder dejaria sin CPU a los
+     * hilos normales de su nucleo, porque yield solo cede a otros de tiempo
+     * real. Por eso, en ese modo, la espera activa duerme unos
+     * microsegundos en lugar de ceder cuando se agotan las vueltas de giro.
+     */
+    static bool fijarHiloActual(int nucleo, bool tiempoReal, EstadoHilo* anterior = nullptr);
+    
+    /**
+     * @brief Devuelve al hilo que llama la afinidad y planificacion guardadas
+     * @param anterior Estado que lleno fijarHiloActual
+     */
+    static void restaurarHiloActual(const EstadoHilo& anterior);
+
+    /**
+     * @brief Arranca el hilo que vacia el puerto hacia la cola de recepcion
+     * @param capacidad Bytes de la cola
+     * @return true si el hilo arranco
      */
-    bool abrir(const char* puerto, unsigned long baud);
+    bool iniciarRecepcion(int capacidad = CAPACIDAD_COLA);
 
     /**
-     * @brief Lee una linea terminada en \n (o \r\n)
+     * @brief Lee los bytes disponibles, sin separar lineas
      * @param buffer Buffer de salida
      * @param maxLen Tamano maximo del buffer
-     * @return Numero de bytes leidos (>0 si hay linea completa, 0 si timeout, -1 si error)
+     * @return Numero de bytes leidos (>0 si hubo datos, 0 si timeout, -1 si error)
+     *
+     * Las lineas se separan con un EnsambladorLineas, que descarta las
+     * demasiado largas en vez de truncarlas.
+     */
+    int leer(char* buffer, int maxLen);
+
+    /**
+     * @brief Pide al emisor que deje de transmitir (XOFF o RTS bajo)
+     * @return false si no hay control de flujo o el puerto no lo admite
+     */
+    bool pausarEmisor();
+
+    /**
+     * @brief Permite al emisor volver a transmitir (XON o RTS alto)
+     * @return false si no hay control de flujo o el puerto no lo admite
+     */
+    bool reanudarEmisor();
+
+    /**
+     * @brief Obtiene cuantas veces la cola pidio pausar al emisor
+     */
+    long long getPausas() const;
+
+    /**
+     * @brief Obtiene los bytes que se descartaron por cola llena
+     */
+    long long getPerdidos() const;
+
+    /**
+     * @brief Obtiene la mayor ocupacion que alcanzo la cola, en bytes
      */
-    int leerLinea(char* buffer, int maxLen);
+    int getOcupacionMaxima() const;
 
     /**
      * @brief Escribe datos crudos al puerto
@@ -50,7 +190,7 @@ public:
     bool escribirLinea(const char* str);
 
     /**
-     * @brief Cierra el puerto
+     * @brief Detiene el hilo lector y cierra el puerto
      */
     void cerrar();
 
@@ -0,0 +1,114 @@
+/**
+ * @file ServidorPRT7.h
+ * @brief Servidor local (socket Unix o TCP de loopback) que decodifica tramas PRT-7
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef SERVIDORPRT7_H
+#define SERVIDORPRT7_H
+
+struct SesionPRT7; // forward
+
+/**
+ * @class ServidorPRT7
+ * @brief Acepta muchas conexiones concurrentes, cada una con su propio decodificador
+ * 
+ * Pensado para emisores que reenvian el puerto serial por un puente de
+ * sockets. Un solo hilo atiende todas las conexiones con epoll y sockets
+ * no bloqueantes; cada conexion tiene su propio ensamblador de lineas y
+ * su propio DecodificadorPRT7 (lista de carga y rotor independientes).
+ * Los mensajes decodificados se escriben en la salida estandar con el
+ * prefijo "[id] " de la conexion que los produjo. Si otra conexion escribe
+ * mientras un mensaje esta a medias, el resto sigue en un renglon nuevo
+ * con el prefijo "[id]+ ": todo renglon lleva el id de su conexion.
+ * 
+ * Solo disponible en Linux; en otros sistemas escuchar* devuelve false.
+ */
+class ServidorPRT7 {
+private:
+    int fdEscucha;             ///< Socket que acepta conexiones
+    int fdEpoll;               ///< Instancia de epoll
+    SesionPRT7** sesiones;     ///< Sesiones indexadas por descriptor
+    int capacidadSesiones;     ///< Tamanio del arreglo de sesiones
+    int activas;               ///< Conexiones abiertas en este momento
+    long long totalConexiones; ///< Conexiones aceptadas desde el arranque
+    int ventana;               ///< Ventana de la lista de carga de cada sesion
+    int lote;                  ///< Lote de volcado de cada sesion
+    char delimitador;          ///< Delimitador de mensajes de cada sesion
+    int lineaAbierta;          ///< Id de la sesion con un renglon sin terminar en stdout (0 = ninguna)
+    char rutaUnix[108];        ///< Ruta del socket Unix (para borrarlo al cerrar)
+    
+    /**
+     * @brief Registra el socket de escucha en epoll
+     * @return true si se pudo preparar
+     */
+    bool prepararEscucha();
+    
+    /**
+     * @brief Acepta todas las conexiones pendientes
+     */
+    void aceptarConexiones();
+    
+    /**
+     * @brief Lee todo lo disponible de una sesion y lo decodifica
+     * @param sesion Sesion con datos pendientes
+     */
+    void leerSesion(SesionPRT7* sesion);
+    
+    /**
+     * @brief Termina la sesion, emite su ultimo mensaje y libera sus recursos
+     * @param sesion Sesion a cerrar
+     */
+    void cerrarSesion(SesionPRT7* sesion);
+    
+public:
+    /**
+     * @brief Constructor de un servidor sin escuchar
+     */
+    ServidorPRT7();
+    
+    /**
+     * @brief Destructor que cierra todas las conexiones
+     */
+    ~ServidorPRT7();
+    
+    /**
+     * @brief Configura el decodificador que recibe cada nueva conexion
+     * @param ventanaN Caracteres en memoria por sesion (0 = todos)
+     * @param loteN Caracteres por volcado
+     * @param delim Caracter que cierra mensajes ('\0' = ninguno)
+     */
+    void configurarSesiones(int ventanaN, int loteN, char delim);
+    
+    /**
+     * @brief Escucha en un socket de dominio Unix
+     * @param ruta Ruta del socket (se reemplaza si ya existe)
+     * @return true si se pudo abrir
+     */
+    bool escucharUnix(const char* ruta);
+    
+    /**
+     * @brief Escucha en un puerto TCP de 127.0.0.1
+     * @param puerto Puerto TCP
+     * @return true si se pudo abrir
+     */
+    bool escucharTcp(int puerto);
+    
+    /**
+     * @brief Atiende conexiones hasta recibir SIGINT/SIGTERM
+     */
+    void ejecutar();
+    
+    /**
+     * @brief Obtiene el numero de conexiones abiertas
+     */
+    int getSesionesActivas() const;
+    
+    /**
+     * @brief Obtiene el numero de conexiones aceptadas desde el arranque
+     */
+    long long getTotalConexiones() const;
+};
+
+#endif // SERVIDORPRT7_H
@@ -0,0 +1,329 @@
+/**
+ * @file SesionAsincrona.h
+ * @brief Interfaz con corrutinas de C++20 para alimentar un decodificador sin bloquear el hilo
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef SESIONASINCRONA_H
+#define SESIONASINCRONA_H
+
+// Solo se compila con soporte de corrutinas (C++20, opcion PRT7_CORRUTINAS)
+#if defined(__cpp_impl_coroutine)
+
+#include "DecodificadorPRT7.h"
+#include "EnsambladorLineas.h"
+#include "SalidaCarga.h"
+#include <coroutine>
+#include <exception>
+
+/**
+ * @class EjecutorPRT7
+ * @brief Clase base abstracta para quien reanuda las corrutinas suspendidas
+ *
+ * Permite conectar las sesiones al ejecutor del servicio que las aloja
+ * (bucle de eventos, pool de hilos, etc.). Sin ejecutor, las corrutinas
+ * se reanudan en linea dentro de la llamada que las despierta.
+ */
+class EjecutorPRT7 {
+public:
+    /**
+     * @brief Destructor virtual para la destruccion polimorfica
+     */
+    virtual ~EjecutorPRT7() {}
+
+    /**
+     * @brief Programa la reanudacion de una corrutina
+     * @param h Corrutina lista para continuar
+     */
+    virtual void programar(std::coroutine_handle<> h) = 0;
+};
+
+/**
+ * @class EjecutorCola
+ * @brief Ejecutor de un solo hilo: reanuda en orden FIFO las corrutinas programadas
+ *
+ * Basta un hilo que llame a ejecutarPendientes() para intercalar miles de
+ * sesiones, cada una suspendida en su propio co_await.
+ */
+class EjecutorCola : public EjecutorPRT7 {
+private:
+    std::coroutine_handle<>* cola; ///< Corrutinas pendientes (arreglo circular)
+    int capacidad;                 ///< Capacidad de la cola
+    int inicio;                    ///< Posicion de la siguiente a reanudar
+    int cantidad;                  ///< Corrutinas pendientes
+
+public:
+    /**
+     * @brief Constructor que crea la cola vacia
+     */
+    EjecutorCola();
+
+    /**
+     * @brief Destructor que libera la cola (no destruye las corrutinas)
+     */
+    ~EjecutorCola();
+
+    /**
+     * @brief Agrega la corrutina al final de la cola
+     */
+    void programar(std::coroutine_handle<> h) override;
+
+    /**
+     * @brief Reanuda corrutinas hasta que la cola quede vacia
+     * @return Numero de corrutinas reanudadas
+     */
+    long long ejecutarPendientes();
+
+    /**
+     * @brief Obtiene el numero de corrutinas pendientes
+     */
+    int getPendientes() const;
+};
+
+/**
+ * @class TareaPRT7
+ * @brief Corrutina perezosa sin valor de retorno
+ *
+ * No empieza hasta que se espera con co_await (desde otra corrutina) o se
+ * arranca con iniciar(). Al terminar continua a quien la esperaba. El
+ * objeto TareaPRT7 es duenio del marco de la corrutina y lo destruye.
+ */
+class TareaPRT7 {
+public:
+    struct promise_type;
+
+private:
+    std::coroutine_handle<promise_type> handle; ///< Marco de la corrutina
+
+public:
+    /**
+     * @brief Estado compartido entre la corrutina y su TareaPRT7
+     */
+    struct promise_type {
+        std::coroutine_handle<> continuacion; ///< Quien espera a esta tarea
+        std::exception_ptr excepcion;         ///< Excepcion no atrapada dentro de la tarea
+
+        /**
+         * @brief Al terminar, continuar directamente con quien esperaba
+         */
+        struct FinalTarea {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                std::coroutine_handle<> c = h.promise().continuacion;
+                return c ? c : std::noop_coroutine();
+            }
+            void await_resume() const noexcept {}
+        };
+
+        TareaPRT7 get_return_object() {
+            return TareaPRT7(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalTarea final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() { excepcion = std::current_exception(); }
+    };
+
+    /**
+     * @brief Constructor a partir del marco de la corrutina
+     */
+    explicit TareaPRT7(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+    TareaPRT7(TareaPRT7&& otra) noexcept : handle(otra.handle) { otra.handle = nullptr; }
+    TareaPRT7(const TareaPRT7&) = delete;
+    TareaPRT7& operator=(const TareaPRT7&) = delete;
+
+    /**
+     * @brief Destructor que libera el marco de la corrutina
+     */
+    ~TareaPRT7() {
+        if (handle) handle.destroy();
+    }
+
+    /**
+     * @brief Arranca la tarea desde codigo que no es corrutina
+     */
+    void iniciar() {
+        if (handle && !handle.done()) handle.resume();
+    }
+
+    /**
+     * @brief Indica si la tarea ya termino
+     */
+    bool terminada() const {
+        return !handle || handle.done();
+    }
+
+    // Espera con co_await: arranca la tarea y continua al terminar
+    bool await_ready() const noexcept { return terminada(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> quien) noexcept {
+        handle.promise().continuacion = quien;
+        return handle;
+    }
+    void await_resume() const {
+        if (handle && handle.promise().excepcion) {
+            std::rethrow_exception(handle.promise().excepcion);
+        }
+    }
+};
+
+/**
+ * @struct MensajeDecodificado
+ * @brief Mensaje entregado por SesionAsincrona::siguienteMensaje()
+ *
+ * texto es nullptr cuando la sesion se cerro y ya no quedan mensajes. El
+ * texto es valido hasta la siguiente espera de siguienteMensaje().
+ */
+struct MensajeDecodificado {
+    const char* texto; ///< Caracteres del mensaje (no terminados en '\0')
+    int longitud;      ///< Numero de caracteres
+};
+
+/**
+ * @class SesionAsincrona
+ * @brief Decodificador que se alimenta y se consume con co_await
+ *
+ * Reemplaza los bucles bloqueantes de ejecutar()/ejecutarSerial() cuando
+ * el decodificador vive dentro de un servicio asincrono:
+ *
+ *   co_await sesion.alimentar(bytes, n);            // productor
+ *   while (true) {                                  // consumidor
+ *       MensajeDecodificado m = co_await sesion.siguienteMensaje();
+ *       if (m.texto == nullptr) break;
+ *       ...
+ *   }
+ *
+ * alimentar() decodifica el bloque completo en el hilo que lo espera; solo
+ * se suspende si hay demasiados mensajes sin consumir (contrapresion).
+ * siguienteMensaje() se suspende hasta que una trama F, el delimitador o
+ * cerrar() completen un mensaje. Cada sesion tiene su propio decodificador,
+ * asi que no comparte estado con otras sesiones del mismo hilo, y nunca
+ * escribe en la salida estandar, sea cual sea TramaBase::esVerboso().
+ */
+class SesionAsincrona : public SalidaCarga {
+private:
+    DecodificadorPRT7 decodificador;   ///< Decodificador propio de la sesion
+    EnsambladorLineas ensamblador;     ///< Lineas de los bloques alimentados
+    EjecutorPRT7* ejecutor;            ///< Quien reanuda (nullptr = en linea)
+
+    char* actual;                      ///< Mensaje en construccion
+    int longitudActual;                ///< Caracteres del mensaje en construccion
+    int capacidadActual;               ///< Capacidad del mensaje en construccion
+
+    char** mensajes;                   ///< Mensajes completos (arreglo circular)
+    int* longitudes;                   ///< Longitud de cada mensaje completo
+    int capacidadCola;                 ///< Capacidad del arreglo circular
+    int inicioCola;                    ///< Posicion del mensaje mas antiguo
+    int cantidadCola;                  ///< Mensajes completos sin consumir
+    int limitePendientes;              ///< Mensajes sin consumir antes de suspender alimentar()
+    char* entregado;                   ///< Ultimo mensaje entregado al consumidor
+
+    bool cerrada;                      ///< No llegaran mas bytes
+    std::coroutine_handle<> esperaMensaje; ///< Consumidor suspendido
+    std::coroutine_handle<> esperaEspacio; ///< Productor suspendido
+
+    /**
+     * @brief Reanuda una corrutina en el ejecutor, o en linea si no hay
+     */
+    void reanudar(std::coroutine_handle<>& h);
+
+    /**
+     * @brief Decodifica un bloque de bytes y despierta al consumidor
+     */
+    void procesarBloque(const char* datos, int longitud);
+
+    /**
+     * @brief Saca el mensaje mas antiguo de la cola
+     */
+    MensajeDecodificado tomarMensaje();
+
+public:
+    /**
+     * @brief Espera devuelta por alimentar()
+     */
+    struct EsperaAlimentar {
+        SesionAsincrona* sesion;
+        const char* datos;
+        int longitud;
+        bool await_ready() const noexcept {
+            return sesion->cantidadCola < sesion->limitePendientes;
+        }
+        void await_suspend(std::coroutine_handle<> h) noexcept {
+            sesion->esperaEspacio = h;
+        }
+        void await_resume() const {
+            sesion->procesarBloque(datos, longitud);
+        }
+    };
+
+    /**
+     * @brief Espera devuelta por siguienteMensaje()
+     */
+    struct EsperaMensaje {
+        SesionAsincrona* sesion;
+        bool await_ready() const noexcept {
+            return sesion->cantidadCola > 0 || sesion->cerrada;
+        }
+        void await_suspend(std::coroutine_handle<> h) noexcept {
+            sesion->esperaMensaje = h;
+        }
+        MensajeDecodificado await_resume() {
+            return sesion->tomarMensaje();
+        }
+    };
+
+    /**
+     * @brief Constructor que prepara el decodificador de la sesion
+     * @param ejecutor Quien reanuda las corrutinas (nullptr = en linea)
+     * @param limitePendientes Mensajes sin consumir antes de frenar al productor
+     * @param delimitador Caracter decodificado que cierra mensajes ('\0' = solo tramas F)
+     */
+    SesionAsincrona(EjecutorPRT7* ejecutor = nullptr, int limitePendientes = 64, char delimitador = '\0');
+
+    /**
+     * @brief Destructor que libera los mensajes pendientes
+     */
+    ~SesionAsincrona();
+
+    SesionAsincrona(const SesionAsincrona&) = delete;
+    SesionAsincrona& operator=(const SesionAsincrona&) = delete;
+
+    /**
+     * @brief Entrega bytes crudos (tramas) al decodificador
+     * @param datos Bytes recibidos; deben seguir validos hasta reanudar
+     * @param longitud Numero de bytes
+     * @return Objeto para usar con co_await
+     */
+    EsperaAlimentar alimentar(const char* datos, int longitud);
+
+    /**
+     * @brief Espera el siguiente mensaje completo
+     * @return Objeto para usar con co_await; da un MensajeDecodificado
+     */
+    EsperaMensaje siguienteMensaje();
+
+    /**
+     * @brief Indica que no llegaran mas bytes y cierra el ultimo mensaje
+     */
+    void cerrar();
+
+    /**
+     * @brief Acumula caracteres decodificados en el mensaje actual
+     */
+    void escribir(const char* datos, int longitud) override;
+
+    /**
+     * @brief Pasa el mensaje actual a la cola de mensajes completos
+     */
+    void finMensaje() override;
+
+    /**
+     * @brief Obtiene el numero de mensajes completos sin consumir
+     */
+    int getPendientes() const;
+};
+
+#endif // __cpp_impl_coroutine
+
+#endif // SESIONASINCRONA_H
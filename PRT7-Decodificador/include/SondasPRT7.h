@@ -0,0 +1,53 @@
+/**
+ * @file SondasPRT7.h
+ * @brief Sondas USDT (sys/sdt.h) en los puntos calientes del decodificador
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Con la opcion de CMake PRT7_USDT y sys/sdt.h disponible, cada sonda es
+ * una instruccion nop mas una nota ELF (.note.stapsdt) que bpftrace, perf
+ * y SystemTap pueden activar en caliente. Sin ellas, las macros no
+ * generan codigo. Proveedor: "prt7".
+ *
+ * Ejemplo:
+ *   bpftrace -e 'usdt:./prt7_decodificador:prt7:rotor_rotado { @[arg1] = count(); }'
+ *
+ * Sondas y argumentos:
+ *   trama_aceptada(tipo, valor)        tipo 'L','M','F' o 'B' (lote "L*n,...");
+ *                                      caracter, rotacion o longitud del lote
+ *   trama_rechazada(linea, longitud)   linea ignorada (sin '\0' final)
+ *   rotor_rotado(posiciones, desplazamiento)  giro pedido y posicion final
+ *   caracter_agregado(caracter, total) caracter y caracteres insertados
+ *   linea_leida(linea, longitud)       linea leida del puerto serial (sin '\0' final)
+ */
+
+#ifndef SONDASPRT7_H
+#define SONDASPRT7_H
+
+#if defined(PRT7_USDT) && defined(__has_include)
+    #if __has_include(<sys/sdt.h>)
+        #include <sys/sdt.h>
+        #define PRT7_SONDAS_ACTIVAS 1
+    #endif
+#endif
+
+#ifdef PRT7_SONDAS_ACTIVAS
+    #define PRT7_SONDA_TRAMA_ACEPTADA(tipo, valor) \
+        DTRACE_PROBE2(prt7, trama_aceptada, (int)(tipo), (int)(valor))
+    #define PRT7_SONDA_TRAMA_RECHAZADA(linea, longitud) \
+        DTRACE_PROBE2(prt7, trama_rechazada, (const char*)(linea), (int)(longitud))
+    #define PRT7_SONDA_ROTOR_ROTADO(posiciones, desplazamiento) \
+        DTRACE_PROBE2(prt7, rotor_rotado, (int)(posiciones), (int)(desplazamiento))
+    #define PRT7_SONDA_CARACTER_AGREGADO(caracter, total) \
+        DTRACE_PROBE2(prt7, caracter_agregado, (int)(unsigned char)(caracter), (long long)(total))
+    #define PRT7_SONDA_LINEA_LEIDA(linea, longitud) \
+        DTRACE_PROBE2(prt7, linea_leida, (const char*)(linea), (int)(longitud))
+#else
+    #define PRT7_SONDA_TRAMA_ACEPTADA(tipo, valor) ((void)0)
+    #define PRT7_SONDA_TRAMA_RECHAZADA(linea, longitud) ((void)0)
+    #define PRT7_SONDA_ROTOR_ROTADO(posiciones, desplazamiento) ((void)0)
+    #define PRT7_SONDA_CARACTER_AGREGADO(caracter, total) ((void)0)
+    #define PRT7_SONDA_LINEA_LEIDA(linea, longitud) ((void)0)
+#endif
+
+#endif // SONDASPRT7_H
@@ -12,15 +12,34 @@
 class ListaDeCarga;
 class RotorDeMapeo;
 
+/**
+ * @struct DatoTrama
+ * @brief Dato de una trama reconocida; cada tipo usa los campos de su forma
+ *
+ * Ver TipoTrama::Forma en RegistroTramas.h.
+ */
+struct DatoTrama {
+    char caracter;    ///< Forma CARACTER
+    int entero;       ///< Forma ENTERO
+    const char* lote; ///< Forma LOTE: caracteres en la linea (no se copian)
+    int longitud;     ///< Forma LOTE: numero de caracteres
+};
+
 /**
  * @class TramaBase
  * @brief Clase base abstracta que define la interfaz para todas las tramas
  * 
  * Esta clase define el comportamiento comun para todas las tramas del protocolo PRT-7.
  * Utiliza polimorfismo para permitir el procesamiento uniforme de diferentes tipos de tramas.
+ * 
+ * Cualquier trama puede llevar una marca de tiempo opcional como prefijo
+ * "@<entero> " (ej. "@1700000000123456 L,A"); la unidad la decide quien
+ * captura, solo se exige que crezca dentro de cada captura.
  */
 class TramaBase {
 public:
+    static const long long SIN_MARCA = -1; ///< La trama no trae marca de tiempo
+    
     /**
      * @brief Destructor virtual para permitir la destruccion polimorfica correcta
      * 
@@ -39,6 +58,46 @@ public:
      * definir como cada tipo de trama interactua con las estructuras de datos.
      */
     virtual void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) = 0;
+    
+    /**
+     * @brief Fija el modo verboso con el que nacen tramas y decodificadores
+     * @param activo true para mostrar cada trama procesada (valor por defecto)
+     * 
+     * Los modos de flujo continuo lo desactivan para que la salida estandar
+     * solo reciba el texto decodificado. Es un valor global: se fija una vez
+     * al arrancar, antes de crear decodificadores en otros hilos. Para un
+     * solo decodificador, ver DecodificadorPRT7::configurarVerboso.
+     */
+    static void setVerboso(bool activo) { verbosoPorDefecto = activo; }
+    
+    /**
+     * @brief Indica el modo verboso con el que nacen tramas y decodificadores
+     * @return true si el modo verboso esta activo
+     */
+    static bool esVerboso() { return verbosoPorDefecto; }
+    
+    /**
+     * @brief Elige si esta trama muestra un mensaje al procesarse
+     * @param activa true para mostrarlo
+     */
+    void setVerbosa(bool activa) { verboso = activa; }
+    
+    /**
+     * @brief Asigna la marca de tiempo leida del prefijo de la linea
+     * @param marca Marca (>= 0) o SIN_MARCA
+     */
+    void setMarcaTiempo(long long marca) { marcaTiempo = marca; }
+    
+    /**
+     * @brief Obtiene la marca de tiempo de la trama
+     * @return La marca, o SIN_MARCA si la linea no la traia
+     */
+    long long getMarcaTiempo() const { return marcaTiempo; }
+    
+protected:
+    inline static bool verbosoPorDefecto = true; ///< Modo verboso de las tramas nuevas
+    long long marcaTiempo = SIN_MARCA;  ///< Marca de tiempo del prefijo "@n"
+    bool verboso = verbosoPorDefecto;   ///< Mostrar mensajes de procesamiento
 };
 
 #endif // TRAMABASE_H
\ No newline at end of file
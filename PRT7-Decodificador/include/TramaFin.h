@@ -0,0 +1,46 @@
+/**
+ * @file TramaFin.h
+ * @brief Clase que representa una trama de fin de mensaje (FIN) del protocolo PRT-7
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef TRAMAFIN_H
+#define TRAMAFIN_H
+
+#include "TramaBase.h"
+
+/**
+ * @class TramaFin
+ * @brief Representa una trama de tipo FIN ("F,") que cierra el mensaje en curso
+ * 
+ * Las tramas FIN no llevan datos. Al procesarse, la lista de carga entrega
+ * el mensaje acumulado a su salida y libera la memoria que ocupaba, de modo
+ * que cada mensaje se emite en cuanto termina.
+ */
+class TramaFin : public TramaBase {
+public:
+    /**
+     * @brief Constructor de la trama FIN
+     */
+    TramaFin();
+    
+    /**
+     * @brief Constructor desde el registro de tramas (FIN no lleva dato)
+     */
+    explicit TramaFin(const DatoTrama& dato);
+    
+    /**
+     * @brief Destructor de la clase TramaFin
+     */
+    ~TramaFin();
+    
+    /**
+     * @brief Procesa la trama FIN cerrando el mensaje de la lista de carga
+     * @param carga Puntero a la lista cuyo mensaje se cierra
+     * @param rotor Puntero al rotor (no utilizado en FIN)
+     */
+    void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+};
+
+#endif // TRAMAFIN_H
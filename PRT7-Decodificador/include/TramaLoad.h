@@ -16,10 +16,21 @@
  * 
  * Las tramas LOAD contienen un caracter que debe ser decodificado usando
  * el estado actual del rotor de mapeo y luego almacenado en la lista de carga.
+ * 
+ * La forma por lotes "L*<n>,<n caracteres>" (ej. "L*5,HELLO") lleva varios
+ * caracteres que se decodifican todos con el mismo estado del rotor, asi
+ * que cuesta un solo parseo y una sola trama en lugar de n. Los caracteres
+ * se toman exactamente por longitud, por lo que pueden incluir espacios y
+ * comas.
  */
 class TramaLoad : public TramaBase {
+public:
+    static const int MAX_LOTE = 200; ///< Caracteres maximos de una trama por lotes
+    
 private:
-    char caracter; ///< El caracter contenido en esta trama LOAD
+    char caracter;      ///< El caracter contenido en esta trama LOAD
+    const char* lote;   ///< Caracteres de una trama por lotes (nullptr = un caracter)
+    int longitudLote;   ///< Numero de caracteres del lote
     
 public:
     /**
@@ -28,6 +39,19 @@ public:
      */
     explicit TramaLoad(char c);
     
+    /**
+     * @brief Constructor de una trama por lotes
+     * @param datos Caracteres del lote; no se copian, deben vivir hasta procesar()
+     * @param longitud Numero de caracteres (1 a MAX_LOTE)
+     */
+    TramaLoad(const char* datos, int longitud);
+    
+    /**
+     * @brief Constructor desde el registro de tramas
+     * @param dato Caracter (forma CARACTER) o lote (forma LOTE, lote != nullptr)
+     */
+    explicit TramaLoad(const DatoTrama& dato);
+    
     /**
      * @brief Destructor de la clase TramaLoad
      */
@@ -45,9 +69,15 @@ public:
     
     /**
      * @brief Obtiene el caracter almacenado en esta trama
-     * @return El caracter contenido en la trama
+     * @return El caracter contenido en la trama (el primero si es un lote)
      */
     char getCaracter() const;
+    
+    /**
+     * @brief Obtiene cuantos caracteres lleva la trama
+     * @return 1 para "L,x", n para "L*n,..."
+     */
+    int getLongitud() const;
 };
 
 #endif // TRAMALOAD_H
\ No newline at end of file
@@ -28,6 +28,12 @@ public:
      */
     explicit TramaMap(int rot);
     
+    /**
+     * @brief Constructor desde el registro de tramas
+     * @param dato Dato de forma ENTERO con la rotacion
+     */
+    explicit TramaMap(const DatoTrama& dato);
+    
     /**
      * @brief Destructor de la clase TramaMap
      */
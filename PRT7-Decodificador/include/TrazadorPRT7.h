@@ -0,0 +1,140 @@
+/**
+ * @file TrazadorPRT7.h
+ * @brief Trazas de tiempo por trama en formato Chrome Trace (chrome://tracing, Perfetto)
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef TRAZADORPRT7_H
+#define TRAZADORPRT7_H
+
+struct BufferTraza; // forward
+
+/**
+ * @class TrazadorPRT7
+ * @brief Registro opcional de tramos de tiempo con muestreo de 1 de cada N tramas
+ *
+ * Cada hilo escribe sus tramos en su propio anillo (un productor, un
+ * consumidor), asi que registrar no toma candados; el anillo se reserva
+ * la primera vez que el hilo traza. Los bucles de lectura llaman a
+ * muestrear() al empezar cada trama; solo las tramas elegidas registran
+ * tramos, las demas pagan una comparacion por tramo. Los hilos que
+ * decodifican nunca escriben el archivo: activar() lanza un hilo que cada
+ * PERIODO_VOLCADO_MS agrega los tramos pendientes de todos los anillos, y
+ * detener() hace el ultimo volcado. Si un anillo se llena entre dos
+ * volcados, los tramos nuevos se descartan y se cuentan.
+ *
+ * El archivo usa el formato de arreglo JSON de Chrome Trace, que admite
+ * omitir el corchete final, por lo que se puede volcar varias veces.
+ */
+class TrazadorPRT7 {
+public:
+    static const int EVENTOS_POR_HILO = 1 << 16;  ///< Capacidad del anillo de cada hilo
+    static constexpr int PERIODO_VOLCADO_MS = 10; ///< Pausa del hilo de volcado entre pasadas
+
+private:
+    static inline bool activo = false;                 ///< Se activo con activar()
+    static inline int periodo = 1;                     ///< Se traza 1 de cada periodo tramas
+    static inline thread_local bool muestreando = false; ///< La trama actual de este hilo se traza
+    static inline thread_local int contador = 0;       ///< Tramas desde la ultima muestra
+    static inline thread_local BufferTraza* buffer = nullptr; ///< Anillo de este hilo
+
+    /**
+     * @brief Crea y publica el anillo del hilo actual
+     */
+    static BufferTraza* bufferDelHilo();
+
+public:
+    /**
+     * @brief Activa el trazador
+     * @param ruta Archivo JSON de salida (se sobrescribe)
+     * @param muestreo Trazar 1 de cada muestreo tramas (minimo 1)
+     * @return true si se pudo crear el archivo
+     *
+     * Debe llamarse antes de lanzar los hilos que decodifican. Si ya
+     * estaba activo, primero se detiene.
+     */
+    static bool activar(const char* ruta, int muestreo);
+
+    /**
+     * @brief Detiene el hilo de volcado, vuelca lo pendiente y cierra el archivo
+     *
+     * Debe llamarse cuando ya no decodifica ningun hilo. Si el programa no
+     * lo llama, se llama al salir.
+     */
+    static void detener();
+
+    /**
+     * @brief Indica si el trazador esta activo
+     */
+    static bool estaActivo() { return activo; }
+
+    /**
+     * @brief Decide si la trama que empieza en este hilo se traza
+     */
+    static void muestrear() {
+        if (!activo) return;
+        if (++contador >= periodo) {
+            contador = 0;
+            muestreando = true;
+        } else {
+            muestreando = false;
+        }
+    }
+
+    /**
+     * @brief Indica si la trama actual de este hilo se esta trazando
+     */
+    static bool estaMuestreando() { return muestreando; }
+
+    /**
+     * @brief Obtiene nanosegundos de un reloj monotono
+     */
+    static long long ahoraNs();
+
+    /**
+     * @brief Agrega un tramo terminado al anillo del hilo actual
+     * @param nombre Nombre del tramo (literal; no se copia)
+     * @param inicioNs Inicio en ahoraNs()
+     * @param finNs Fin en ahoraNs()
+     */
+    static void registrar(const char* nombre, long long inicioNs, long long finNs);
+
+    /**
+     * @brief Escribe en el archivo los tramos pendientes de todos los hilos
+     * @return Numero de tramos escritos
+     *
+     * Lo llama el hilo de volcado; tambien se puede llamar a mano.
+     */
+    static long long volcar();
+
+    /**
+     * @brief Obtiene los tramos descartados por anillos llenos
+     */
+    static long long getDescartados();
+};
+
+/**
+ * @class TramoTraza
+ * @brief Mide el tiempo de vida de un bloque si la trama actual se esta trazando
+ *
+ * Uso: { TramoTraza t("parsearTrama"); ... }
+ */
+class TramoTraza {
+private:
+    const char* nombre; ///< Nombre del tramo
+    long long inicio;   ///< Inicio en ns, -1 si no se traza
+
+public:
+    explicit TramoTraza(const char* nombre)
+        : nombre(nombre), inicio(TrazadorPRT7::estaMuestreando() ? TrazadorPRT7::ahoraNs() : -1) {}
+
+    ~TramoTraza() {
+        if (inicio >= 0) TrazadorPRT7::registrar(nombre, inicio, TrazadorPRT7::ahoraNs());
+    }
+
+    TramoTraza(const TramoTraza&) = delete;
+    TramoTraza& operator=(const TramoTraza&) = delete;
+};
+
+#endif // TRAZADORPRT7_H
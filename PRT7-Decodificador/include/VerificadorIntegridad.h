@@ -0,0 +1,138 @@
+/**
+ * @file VerificadorIntegridad.h
+ * @brief Sufijo opcional de secuencia y CRC32C para detectar tramas corruptas o perdidas
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef VERIFICADORINTEGRIDAD_H
+#define VERIFICADORINTEGRIDAD_H
+
+/**
+ * @class VerificadorIntegridad
+ * @brief Valida el sufijo "*<secuencia>*<crc32c>" de cada trama
+ *
+ * Formato de una trama con sufijo:
+ *
+ *   L,A*17*1b2c3d4e
+ *
+ * La secuencia es un entero decimal que el emisor incrementa en cada
+ * trama (0 reinicia la cuenta) y el CRC son 8 digitos hexadecimales del
+ * CRC32C (Castagnoli) de todo lo anterior al ultimo '*' ("L,A*17"). Como
+ * el sufijo se busca desde el final, una trama "L,*" tambien se puede
+ * proteger. Cualquier otro '*' es carga: solo un final exacto
+ * "*<digitos>*<8 hex>" se toma como sufijo.
+ *
+ * Una trama con CRC invalido se descarta; un salto en la secuencia se
+ * cuenta como tramas perdidas y una secuencia repetida se descarta. El
+ * CRC usa la instruccion crc32 de SSE4.2 o ARMv8 si el procesador la
+ * tiene, y una tabla de 8 x 256 entradas en otro caso.
+ *
+ * En el caso normal (secuencia siguiente a la anterior y CRC en
+ * minuscula) la secuencia y el CRC se comparan como dos enteros de 64
+ * bits, sin decodificar digitos; prt7_bench_integridad mide el costo.
+ */
+class VerificadorIntegridad {
+public:
+    /**
+     * @brief Resultado de verificar una linea
+     */
+    enum Resultado {
+        VALIDA,        ///< Sufijo correcto: procesar el cuerpo
+        SIN_SUFIJO,    ///< La linea no termina en "*<digitos>*<8 hex>"
+        CORRUPTA,      ///< CRC distinto o secuencia de mas de 32 bits: descartar
+        DUPLICADA      ///< Secuencia ya vista: descartar
+    };
+
+    static const int MAX_SUFIJO = 20; ///< "*" + 10 digitos + "*" + 8 hex
+
+private:
+    bool exigir;               ///< Descartar tambien las tramas sin sufijo
+    bool primera;              ///< Aun no se recibio ninguna secuencia
+    unsigned int ultima;       ///< Ultima secuencia aceptada
+    long long validas;         ///< Tramas con sufijo correcto
+    long long corruptas;       ///< Tramas descartadas por CRC o secuencia fuera de rango
+    long long duplicadas;      ///< Tramas descartadas por secuencia repetida
+    long long sinSufijo;       ///< Tramas que llegaron sin sufijo
+    long long huecos;          ///< Saltos detectados en la secuencia
+    long long perdidas;        ///< Tramas que faltan segun la secuencia
+    unsigned long long textoEsperado;   ///< "*<ultima + 1>" tal como queda en los 8 bytes antes del CRC
+    unsigned long long mascaraEsperada; ///< Bytes de textoEsperado que se comparan (0: no hay)
+    int digitosEsperados;               ///< Digitos de la secuencia esperada
+
+    /**
+     * @brief Prepara textoEsperado para comparar la siguiente secuencia
+     *        sin leer sus digitos; solo hasta 7 digitos
+     */
+    void prepararEsperada(unsigned int siguiente);
+
+public:
+    /**
+     * @brief Constructor que acepta tramas sin sufijo
+     */
+    VerificadorIntegridad();
+
+    /**
+     * @brief Define si las tramas sin sufijo se descartan
+     */
+    void setExigir(bool exigirSufijo);
+
+    /**
+     * @brief Indica si las tramas sin sufijo se descartan
+     */
+    bool getExigir() const;
+
+    /**
+     * @brief Verifica el sufijo de una linea
+     * @param linea Caracteres de la linea (sin '\n')
+     * @param longitud Numero de caracteres
+     * @param longitudCuerpo Recibe la longitud de la trama sin el sufijo
+     * @return El resultado; la trama se procesa si es VALIDA, o si es
+     *         SIN_SUFIJO y no se exige el sufijo (ver aceptar())
+     */
+    Resultado verificar(const char* linea, int longitud, int& longitudCuerpo);
+
+    /**
+     * @brief Indica si una trama con el resultado dado debe procesarse
+     */
+    bool aceptar(Resultado r) const;
+
+    /**
+     * @brief Escribe el sufijo de una trama
+     * @param cuerpo Trama sin sufijo (ej. "L,A")
+     * @param longitud Longitud del cuerpo
+     * @param secuencia Numero de secuencia de la trama
+     * @param destino Donde escribir el sufijo (al menos MAX_SUFIJO bytes)
+     * @return Bytes escritos
+     */
+    static int escribirSufijo(const char* cuerpo, int longitud, unsigned int secuencia, char* destino);
+
+    /**
+     * @brief Calcula el CRC32C de un bloque
+     * @param datos Bytes a procesar
+     * @param longitud Numero de bytes
+     * @param crc CRC de los bloques anteriores (0 para empezar)
+     * @return CRC acumulado
+     */
+    static unsigned int crc32c(const char* datos, int longitud, unsigned int crc = 0);
+
+    /**
+     * @brief Indica si crc32c usa instrucciones del procesador
+     */
+    static bool usaHardware();
+
+    /** @brief Tramas con sufijo correcto */
+    long long getValidas() const;
+    /** @brief Tramas descartadas por CRC o formato */
+    long long getCorruptas() const;
+    /** @brief Tramas descartadas por secuencia repetida */
+    long long getDuplicadas() const;
+    /** @brief Tramas recibidas sin sufijo */
+    long long getSinSufijo() const;
+    /** @brief Saltos en la secuencia */
+    long long getHuecos() const;
+    /** @brief Tramas que faltan segun la secuencia */
+    long long getPerdidas() const;
+};
+
+#endif // VERIFICADORINTEGRIDAD_H
@@ -0,0 +1,144 @@
+/**
+ * @file VigilantePatrones.h
+ * @brief Automata Aho-Corasick que vigila palabras clave en el texto decodificado
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#ifndef VIGILANTEPATRONES_H
+#define VIGILANTEPATRONES_H
+
+/**
+ * @class ObservadorPatrones
+ * @brief Clase base abstracta para recibir las coincidencias del vigilante
+ */
+class ObservadorPatrones {
+public:
+    /**
+     * @brief Destructor virtual para la destruccion polimorfica
+     */
+    virtual ~ObservadorPatrones() {}
+
+    /**
+     * @brief Se invoca cada vez que un patron termina en el caracter actual
+     * @param id Identificador devuelto por VigilantePatrones::agregarPatron
+     * @param patron Texto del patron encontrado
+     * @param posicionFinal Posicion (desde 0) del ultimo caracter del patron en el flujo
+     */
+    virtual void patronEncontrado(int id, const char* patron, long long posicionFinal) = 0;
+};
+
+/**
+ * @class AlertaConsola
+ * @brief Observador que imprime cada coincidencia en la salida de errores
+ */
+class AlertaConsola : public ObservadorPatrones {
+public:
+    /**
+     * @brief Muestra la alerta con el patron y su posicion
+     */
+    void patronEncontrado(int id, const char* patron, long long posicionFinal) override;
+};
+
+/**
+ * @class VigilantePatrones
+ * @brief Automata Aho-Corasick que avanza un estado por cada caracter decodificado
+ *
+ * Los patrones se registran con agregarPatron() y se compilan con construir()
+ * en una tabla de transiciones completa (trie + enlaces de fallo resueltos),
+ * por lo que avanzar() cuesta O(1) por caracter mas el numero de
+ * coincidencias reportadas. El estado se conserva entre llamadas, asi que
+ * se detectan palabras repartidas en cualquier numero de tramas.
+ *
+ * Para mantener la tabla pequena con miles de patrones, el alfabeto se
+ * reduce a las clases de caracteres que aparecen en ellos; cualquier otro
+ * caracter comparte una unica clase "resto".
+ */
+class VigilantePatrones {
+private:
+    char** patrones;          ///< Copias de los patrones registrados
+    int numPatrones;          ///< Numero de patrones registrados
+    int capacidadPatrones;    ///< Capacidad del arreglo de patrones
+
+    int clase[256];           ///< Clase de cada byte (0 = resto)
+    int numClases;            ///< Numero de clases (incluye la clase resto)
+
+    int* transiciones;        ///< Tabla [estado * numClases + clase] -> estado
+    int* salida;              ///< Patron que termina en cada estado (-1 = ninguno)
+    int* enlaceSalida;        ///< Siguiente estado por el enlace de fallo con salida (-1 = ninguno)
+    int numEstados;           ///< Estados del automata construido
+
+    int estado;               ///< Estado actual mientras se vigila el flujo
+    long long posicion;       ///< Caracteres observados en todo el flujo (reiniciar() no la toca)
+    ObservadorPatrones* observador; ///< Receptor de las coincidencias
+
+    /**
+     * @brief Libera la tabla del automata construido
+     */
+    void liberarAutomata();
+
+public:
+    /**
+     * @brief Constructor que crea un vigilante sin patrones
+     */
+    VigilantePatrones();
+
+    /**
+     * @brief Destructor que libera patrones y automata
+     */
+    ~VigilantePatrones();
+
+    /**
+     * @brief Registra un patron a vigilar
+     * @param patron Texto del patron (no vacio)
+     * @return Identificador del patron, -1 si es invalido
+     *
+     * Los patrones agregados despues de construir() no tienen efecto
+     * hasta la siguiente llamada a construir().
+     */
+    int agregarPatron(const char* patron);
+
+    /**
+     * @brief Registra un patron por cada linea no vacia de un archivo
+     * @param ruta Ruta del archivo de patrones
+     * @return Numero de patrones cargados, -1 si no se pudo abrir
+     */
+    int cargarArchivo(const char* ruta);
+
+    /**
+     * @brief Compila los patrones registrados en la tabla de transiciones
+     * @return true si el automata quedo listo
+     */
+    bool construir();
+
+    /**
+     * @brief Avanza el automata con un caracter y reporta las coincidencias
+     * @param c El caracter decodificado
+     */
+    void avanzar(char c);
+
+    /**
+     * @brief Vuelve al estado inicial (por ejemplo al cerrar un mensaje)
+     *
+     * La posicion sigue contando desde el inicio del flujo.
+     */
+    void reiniciar();
+
+    /**
+     * @brief Define quien recibe las coincidencias
+     * @param obs Observador, o nullptr para solo avanzar
+     */
+    void setObservador(ObservadorPatrones* obs);
+
+    /**
+     * @brief Obtiene el numero de patrones registrados
+     */
+    int getNumPatrones() const;
+
+    /**
+     * @brief Obtiene el numero de estados del automata construido
+     */
+    int getNumEstados() const;
+};
+
+#endif // VIGILANTEPATRONES_H
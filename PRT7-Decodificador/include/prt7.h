@@ -0,0 +1,132 @@
+/**
+ * @file prt7.h
+ * @brief API en C de libprt7 para decodificar PRT-7 dentro de otro proceso
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Interfaz estable para enlazar la biblioteca estatica (libprt7.a) o la
+ * compartida (libprt7.so / prt7.dll) desde C, C++ u otros lenguajes con
+ * FFI. Los tipos son opacos y ninguna excepcion cruza esta frontera.
+ *
+ * Uso basico:
+ *
+ *   prt7_decodificador* d = prt7_crear();
+ *   prt7_configurar_salida(d, mi_salida, mi_contexto);
+ *   prt7_alimentar(d, bytes, n);      // tramas crudas, en cualquier corte
+ *   prt7_cerrar(d);                   // entrega el ultimo mensaje
+ *   prt7_destruir(d);
+ *
+ * Un decodificador no debe usarse desde dos hilos a la vez; decodificadores
+ * distintos son independientes.
+ */
+
+#ifndef PRT7_H
+#define PRT7_H
+
+#if defined(_WIN32)
+    #if defined(PRT7_COMPILANDO_COMPARTIDA)
+        #define PRT7_API __declspec(dllexport)
+    #elif defined(PRT7_USANDO_COMPARTIDA)
+        #define PRT7_API __declspec(dllimport)
+    #else
+        #define PRT7_API
+    #endif
+#else
+    #define PRT7_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Version de la API; cambia solo si se rompe la compatibilidad binaria */
+#define PRT7_VERSION_API 1
+
+/** Codigos de retorno */
+#define PRT7_OK 0
+#define PRT7_ERROR_ARGUMENTO (-1)
+#define PRT7_ERROR_INTERNO (-2)
+
+/** Decodificador opaco */
+typedef struct prt7_decodificador prt7_decodificador;
+
+/**
+ * @brief Recibe el texto decodificado
+ * @param contexto Puntero entregado en prt7_configurar_salida
+ * @param datos Caracteres decodificados (no terminados en '\0'), o NULL
+ * @param longitud Numero de caracteres
+ * @param fin_mensaje 1 si la llamada marca el final de un mensaje (datos es NULL)
+ */
+typedef void (*prt7_funcion_salida)(void* contexto, const char* datos, int longitud, int fin_mensaje);
+
+/**
+ * @brief Obtiene la version de la biblioteca (ej. "1.0.0")
+ */
+PRT7_API const char* prt7_version(void);
+
+/**
+ * @brief Crea un decodificador con el rotor en 'A'
+ * @return El decodificador, o NULL si no hubo memoria
+ */
+PRT7_API prt7_decodificador* prt7_crear(void);
+
+/**
+ * @brief Libera el decodificador (sin entregar el mensaje pendiente)
+ */
+PRT7_API void prt7_destruir(prt7_decodificador* d);
+
+/**
+ * @brief Define a quien se entrega el texto decodificado
+ * @param funcion Funcion de salida, o NULL para descartar el texto
+ * @param contexto Puntero que se pasa tal cual a la funcion
+ */
+PRT7_API int prt7_configurar_salida(prt7_decodificador* d, prt7_funcion_salida funcion, void* contexto);
+
+/**
+ * @brief Ajusta cuanto texto se retiene antes de entregarlo y como se cortan los mensajes
+ * @param ventana Caracteres que se conservan en memoria antes de entregar un lote
+ *                (minimo 1; el resto sale al cerrar el mensaje)
+ * @param lote Caracteres por entrega cuando se supera la ventana (minimo 1)
+ * @param delimitador Caracter decodificado que cierra mensajes ('\0' = solo tramas F)
+ *
+ * Por defecto ventana = lote = 256 y sin delimitador.
+ */
+PRT7_API int prt7_configurar(prt7_decodificador* d, int ventana, int lote, char delimitador);
+
+/**
+ * @brief Entrega bytes crudos (lineas de tramas) en cualquier corte
+ * @return Numero de tramas validas procesadas, o un codigo de error negativo
+ */
+PRT7_API int prt7_alimentar(prt7_decodificador* d, const char* datos, int longitud);
+
+/**
+ * @brief Interpreta y procesa una sola trama (ej. "L,A", "M,-2", "F,")
+ * @return 1 si la trama era valida, 0 si se ignoro, o un codigo de error negativo
+ */
+PRT7_API int prt7_procesar_trama(prt7_decodificador* d, const char* trama, int longitud);
+
+/**
+ * @brief Decodifica un caracter con la posicion actual del rotor, sin modificarla
+ */
+PRT7_API char prt7_decodificar_caracter(prt7_decodificador* d, char c);
+
+/**
+ * @brief Obtiene la posicion del rotor (0 = cabeza en 'A')
+ */
+PRT7_API int prt7_desplazamiento(const prt7_decodificador* d);
+
+/**
+ * @brief Descarta el texto pendiente, la linea incompleta y regresa el rotor a 'A'
+ */
+PRT7_API int prt7_reiniciar(prt7_decodificador* d);
+
+/**
+ * @brief Procesa la linea incompleta y entrega el ultimo mensaje abierto
+ */
+PRT7_API int prt7_cerrar(prt7_decodificador* d);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRT7_H */
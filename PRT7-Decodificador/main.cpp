@@ -6,8 +6,22 @@
  */
 
 #include "include/DecodificadorPRT7.h"
+#include "include/SalidaCarga.h"
+#include "include/VigilantePatrones.h"
+#include "include/AlmacenEmpaquetado.h"
+#include "include/ServidorPRT7.h"
+#include "include/AnilloCompartido.h"
+#include "include/TrazadorPRT7.h"
+#include "include/VerificadorIntegridad.h"
+#include "include/SerialPort.h"
+#include "include/IndiceCaptura.h"
+#include "include/MezcladorCapturas.h"
+#include "include/CacheTramos.h"
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <climits>
 
 /**
  * @brief Muestra el menu principal del programa
@@ -18,7 +32,7 @@ void mostrarMenu() {
     std::cout << "===============================================" << std::endl;
     std::cout << "1. Ejecutar simulacion Arduino (automatico)" << std::endl;
     std::cout << "2. Modo manual (ingreso de tramas)" << std::endl;
-    std::cout << "3. Leer desde puerto COM (Windows)" << std::endl;
+    std::cout << "3. Leer desde puerto serial (COM o /dev/tty*)" << std::endl;
     std::cout << "4. Salir" << std::endl;
     std::cout << "===============================================" << std::endl;
     std::cout << "Seleccione una opcion: ";
@@ -32,20 +46,581 @@ void mostrarAyuda() {
     std::cout << "El protocolo PRT-7 utiliza dos tipos de tramas:" << std::endl;
     std::cout << "- LOAD (L,X): Contiene un fragmento de datos (caracter X)" << std::endl;
     std::cout << "- MAP (M,N): Instrucciones para rotar el disco N posiciones" << std::endl;
+    std::cout << "- FIN (F,): Cierra el mensaje en curso y lo muestra" << std::endl;
     std::cout << std::endl;
     std::cout << "Ejemplos de tramas validas:" << std::endl;
     std::cout << "L,A    -> Carga el caracter 'A'" << std::endl;
     std::cout << "L,     -> Carga un espacio" << std::endl;
     std::cout << "M,5    -> Rota el disco +5 posiciones" << std::endl;
     std::cout << "M,-3   -> Rota el disco -3 posiciones" << std::endl;
+    std::cout << "F,     -> Termina el mensaje actual" << std::endl;
     std::cout << std::endl;
 }
 
+/**
+ * @brief Muestra las opciones de linea de comandos
+ */
+void mostrarUso() {
+    std::cout << "Uso: prt7_decodificador [opciones]" << std::endl;
+    std::cout << "  (sin opciones)   Menu interactivo" << std::endl;
+    std::cout << "  --flujo          Decodifica la entrada estandar sin interaccion" << std::endl;
+    std::cout << "  --ventana N      Caracteres que se conservan en memoria (por defecto el lote; 0 = todos)" << std::endl;
+    std::cout << "  --lote N         Caracteres por volcado a la salida (1 o mas, por defecto 4096)" << std::endl;
+    std::cout << "  --delimitador C  Caracter decodificado que cierra cada mensaje" << std::endl;
+    std::cout << "  --inactividad MS Cierra el mensaje tras MS milisegundos sin tramas (0 = nunca)" << std::endl;
+    std::cout << "  --patrones RUTA  Alerta cuando aparece alguna palabra del archivo" << std::endl;
+    std::cout << "  --empaquetar     Guarda el texto en 5 bits por caracter y lo muestra al final" << std::endl;
+    std::cout << "  --servidor-unix RUTA   Atiende conexiones en un socket Unix" << std::endl;
+    std::cout << "  --servidor-tcp PUERTO  Atiende conexiones en 127.0.0.1:PUERTO (1 a 65535)" << std::endl;
+    std::cout << "  --anillo NOMBRE        Decodifica desde un anillo de memoria compartida" << std::endl;
+    std::cout << "  --anillo-productor NOMBRE  Copia la entrada estandar a un anillo (captura)" << std::endl;
+    std::cout << "  --entrada RUTA         Decodifica un archivo o tty por bloques (io_uring)" << std::endl;
+    std::cout << "  --sin-uring            Con --entrada, usa read() en lugar de io_uring" << std::endl;
+    std::cout << "  --traza RUTA           Guarda una traza Chrome/Perfetto de cada trama" << std::endl;
+    std::cout << "  --traza-muestreo N     Traza solo 1 de cada N tramas (por defecto 1)" << std::endl;
+    std::cout << "  --integridad           Verifica el sufijo *secuencia*crc32c cuando existe" << std::endl;
+    std::cout << "  --integridad-estricta  Ademas descarta las tramas sin sufijo" << std::endl;
+    std::cout << "  --serial PUERTO        Decodifica desde un puerto serial (COM3, /dev/ttyUSB0)" << std::endl;
+    std::cout << "  --baud N               Velocidad del puerto serial (por defecto 115200)" << std::endl;
+    std::cout << "  --control-flujo C      ninguno | xonxoff | rtscts: pausa al emisor si la cola se llena" << std::endl;
+    std::cout << "  --baja-latencia L,D    Con --serial, sondea el puerto; fija lector y decodificador a los nucleos L y D (-1 = sin fijar)" << std::endl;
+    std::cout << "  --tiempo-real          Con --baja-latencia, ambos hilos con SCHED_FIFO (requiere privilegios)" << std::endl;
+    std::cout << "  --indexar RUTA         Con --entrada, escribe el indice de la captura en RUTA y termina" << std::endl;
+    std::cout << "  --intervalo-indice N   Tramas validas entre puntos del indice (por defecto 4096)" << std::endl;
+    std::cout << "  --indice RUTA          Con --entrada, retoma la captura desde un punto del indice" << std::endl;
+    std::cout << "  --desde-trama N        Con --indice, empieza en el punto anterior a la trama N" << std::endl;
+    std::cout << "  --desde-caracter N     Con --indice, empieza en el punto anterior al caracter N" << std::endl;
+    std::cout << "  --desborde P           volcar | nuevo | antiguos: lista de carga llena (compilacion PRT7_SIN_HEAP)" << std::endl;
+    std::cout << "  --cache RUTA           Con --entrada, reproduce desde RUTA los tramos ya decodificados" << std::endl;
+    std::cout << "  --cache-limite MB      Tamanio maximo del archivo de cache (1 a 1048576, por defecto 256)" << std::endl;
+    std::cout << "  --mezclar RUTA...      Mezcla por marca \"@n \" las capturas de varios puertos (al final)" << std::endl;
+}
+
+/**
+ * @brief Indica si un valor abrevia un nombre (prefijo no vacio, sin distinguir mayusculas)
+ */
+bool abrevia(const char* valor, const char* nombre) {
+    if (valor[0] == '\0') return false;
+    for (int i = 0; valor[i] != '\0'; i++) {
+        char c = (valor[i] >= 'A' && valor[i] <= 'Z') ? (char)(valor[i] - 'A' + 'a') : valor[i];
+        if (c != nombre[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Convierte un argumento entero completo y dentro de un rango
+ * @param texto Argumento de la linea de comandos
+ * @param minimo Valor minimo aceptado
+ * @param maximo Valor maximo aceptado
+ * @param valor Recibe el entero si es valido
+ * @return false si esta vacio, le sobran caracteres o queda fuera del rango
+ */
+bool leerNumero(const char* texto, long long minimo, long long maximo, long long& valor) {
+    char* fin = nullptr;
+    errno = 0;
+    long long leido = std::strtoll(texto, &fin, 10);
+    if (fin == texto || *fin != '\0' || errno == ERANGE || leido < minimo || leido > maximo) {
+        return false;
+    }
+    valor = leido;
+    return true;
+}
+
+/**
+ * @brief Informa un valor de opcion no valido
+ * @return Codigo de salida del programa
+ */
+int valorInvalido(const char* opcion, const char* valor) {
+    std::cerr << "Valor no valido para " << opcion << ": \"" << valor << "\"" << std::endl;
+    return 1;
+}
+
+/**
+ * @brief Convierte el nombre de un control de flujo a SerialPort::ControlFlujo
+ * @param nombre "ninguno", "xonxoff" o "rtscts" (o una abreviatura)
+ * @param control Recibe el control de flujo
+ * @return false si el nombre no es ninguno de los tres
+ */
+bool leerControlFlujo(const char* nombre, SerialPort::ControlFlujo& control) {
+    if (abrevia(nombre, "ninguno")) {
+        control = SerialPort::SIN_CONTROL;
+    } else if (abrevia(nombre, "xonxoff")) {
+        control = SerialPort::XON_XOFF;
+    } else if (abrevia(nombre, "rtscts")) {
+        control = SerialPort::RTS_CTS;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Convierte el nombre de una politica a ListaDeCarga::PoliticaDesborde
+ * @param nombre "volcar", "nuevo" o "antiguos" (o una abreviatura)
+ * @param politica Recibe la politica
+ * @return false si el nombre no es ninguna de las tres
+ */
+bool leerDesborde(const char* nombre, ListaDeCarga::PoliticaDesborde& politica) {
+    if (abrevia(nombre, "volcar")) {
+        politica = ListaDeCarga::VOLCAR_ANTIGUOS;
+    } else if (abrevia(nombre, "nuevo")) {
+        politica = ListaDeCarga::DESCARTAR_NUEVO;
+    } else if (abrevia(nombre, "antiguos")) {
+        politica = ListaDeCarga::DESCARTAR_ANTIGUOS;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Convierte "L,D" (o solo "L") en los nucleos del lector y del decodificador
+ * @param texto Argumento de --baja-latencia
+ * @param lector Recibe el nucleo del hilo lector
+ * @param decodificador Recibe el nucleo del decodificador (-1 si no se indica)
+ * @return false si algun nucleo no es un entero entre -1 y 1023
+ */
+bool leerNucleos(const char* texto, int& lector, int& decodificador) {
+    char primero[24];
+    int i = 0;
+    while (texto[i] != '\0' && texto[i] != ',') {
+        if (i + 1 >= (int)sizeof(primero)) return false;
+        primero[i] = texto[i];
+        i++;
+    }
+    primero[i] = '\0';
+    long long l = 0;
+    long long d = -1;
+    if (!leerNumero(primero, -1, 1023, l)) return false;
+    if (texto[i] == ',' && !leerNumero(texto + i + 1, -1, 1023, d)) return false;
+    lector = (int)l;
+    decodificador = (int)d;
+    return true;
+}
+
+/**
+ * @brief Atiende conexiones locales, cada una con su propio decodificador
+ * @param rutaUnix Ruta del socket Unix, o nullptr para usar TCP
+ * @param puerto Puerto TCP de loopback si no se usa socket Unix
+ * @param ventana Caracteres en memoria por conexion
+ * @param lote Caracteres por volcado
+ * @param delimitador Caracter que cierra mensajes ('\0' = ninguno)
+ * @return Codigo de salida del programa
+ */
+int ejecutarServidor(const char* rutaUnix, int puerto, int ventana, int lote, char delimitador) {
+    ServidorPRT7 servidor;
+    servidor.configurarSesiones(ventana, lote, delimitador);
+    
+    bool listo = (rutaUnix != nullptr) ? servidor.escucharUnix(rutaUnix) : servidor.escucharTcp(puerto);
+    if (!listo) {
+        std::cerr << "No se pudo abrir el servidor." << std::endl;
+        return 1;
+    }
+    
+    std::cerr << "Servidor PRT-7 escuchando. Ctrl+C para terminar." << std::endl;
+    servidor.ejecutar();
+    std::cerr << "Servidor detenido. Conexiones atendidas: " << servidor.getTotalConexiones() << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Copia la entrada estandar a un anillo compartido, como lo haria un proceso de captura
+ * @param nombre Nombre POSIX del segmento
+ * @return Codigo de salida del programa
+ */
+int ejecutarProductorAnillo(const char* nombre) {
+    AnilloCompartido anillo;
+    if (!anillo.abrir(nombre, 1 << 20)) {
+        std::cerr << "No se pudo abrir el anillo compartido " << nombre << std::endl;
+        return 1;
+    }
+    
+    static char bloque[1 << 16];
+    while (std::cin.read(bloque, sizeof(bloque)) || std::cin.gcount() > 0) {
+        anillo.escribir(bloque, (int)std::cin.gcount());
+    }
+    // El consumidor elimina el nombre cuando termina de vaciar el anillo:
+    // si lo hiciera el productor, un consumidor que llega tarde crearia un
+    // segmento nuevo y vacio y esperaria para siempre
+    anillo.cerrarEscritura();
+    return 0;
+}
+
+/**
+ * @brief Escribe el indice de una captura
+ * @param captura Archivo de captura
+ * @param rutaIndice Archivo de indice a crear
+ * @param intervalo Tramas validas entre puntos
+ * @param verificador Verificador de integridad, o nullptr
+ * @return Codigo de salida del programa
+ */
+int ejecutarIndexado(const char* captura, const char* rutaIndice, int intervalo, VerificadorIntegridad* verificador) {
+    IndiceCaptura indice;
+    if (!indice.construir(captura, rutaIndice, intervalo, verificador)) {
+        std::cerr << "No se pudo construir el indice " << rutaIndice << " de " << captura << std::endl;
+        return 1;
+    }
+    std::cerr << "Indice: " << indice.getPuntos() << " puntos cada " << indice.getIntervalo()
+              << " tramas (" << indice.getTramas() << " tramas, " << indice.getTamanioCaptura()
+              << " bytes)" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Mezcla varias capturas en una sola linea de tiempo
+ * @param rutas Archivos de captura
+ * @param cantidad Numero de capturas
+ * @param ventana Caracteres en memoria por captura
+ * @param lote Caracteres por volcado
+ * @param delimitador Caracter que cierra mensajes ('\0' = ninguno)
+ * @return Codigo de salida del programa
+ */
+int ejecutarMezcla(char* rutas[], int cantidad, int ventana, int lote, char delimitador) {
+    MezcladorCapturas mezclador;
+    SalidaLineaTiempoConsola consola;
+    mezclador.configurarSesiones(ventana, lote, delimitador);
+    mezclador.configurarSalida(&consola);
+    for (int i = 0; i < cantidad; i++) {
+        if (mezclador.agregar(rutas[i]) < 0) {
+            std::cerr << "No se pudo abrir la captura " << rutas[i] << std::endl;
+            return 1;
+        }
+    }
+    
+    mezclador.ejecutar();
+    std::cout.flush();
+    std::cerr << "Mezcla: " << mezclador.getCapturas() << " capturas, " << mezclador.getLineas()
+              << " lineas, " << mezclador.getTramas() << " tramas";
+    if (mezclador.getDesordenadas() > 0) {
+        std::cerr << ", " << mezclador.getDesordenadas() << " lineas fuera de orden";
+    }
+    std::cerr << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Ejecuta el decodificador segun los argumentos de linea de comandos
+ * @param argc Numero de argumentos
+ * @param argv Arreglo de argumentos
+ * @return Codigo de salida del programa
+ */
+int ejecutarArgumentos(int argc, char* argv[]) {
+    bool flujo = false;
+    int ventana = -1;
+    int lote = 4096;
+    char delimitador = '\0';
+    int inactividad = 0;
+    const char* rutaPatrones = nullptr;
+    bool empaquetar = false;
+    const char* servidorUnix = nullptr;
+    int servidorTcp = 0;
+    const char* anillo = nullptr;
+    const char* entrada = nullptr;
+    bool permitirUring = true;
+    const char* rutaTraza = nullptr;
+    int muestreoTraza = 1;
+    bool integridad = false;
+    bool integridadEstricta = false;
+    const char* serial = nullptr;
+    unsigned long baud = 115200;
+    SerialPort::ControlFlujo controlFlujo = SerialPort::SIN_CONTROL;
+    bool bajaLatencia = false;
+    int nucleoLector = -1;
+    int nucleoDecodificador = -1;
+    bool tiempoReal = false;
+    const char* rutaIndexar = nullptr;
+    int intervaloIndice = IndiceCaptura::INTERVALO_DEFECTO;
+    const char* rutaIndice = nullptr;
+    long long desdeTrama = -1;
+    long long desdeCaracter = -1;
+    int primeraMezcla = 0;
+    ListaDeCarga::PoliticaDesborde desborde = ListaDeCarga::VOLCAR_ANTIGUOS;
+    const char* rutaCache = nullptr;
+    long long limiteCache = CacheTramos::LIMITE_DEFECTO;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool tieneValor = (i + 1 < argc);
+        if (std::strcmp(arg, "--flujo") == 0) {
+            flujo = true;
+        } else if (std::strcmp(arg, "--ventana") == 0 && tieneValor) {
+            long long valor = 0;
+            if (!leerNumero(argv[++i], 0, 1 << 30, valor)) return valorInvalido(arg, argv[i]);
+            ventana = (int)valor;
+        } else if (std::strcmp(arg, "--lote") == 0 && tieneValor) {
+            long long valor = 0;
+            if (!leerNumero(argv[++i], 1, 1 << 30, valor)) return valorInvalido(arg, argv[i]);
+            lote = (int)valor;
+        } else if (std::strcmp(arg, "--delimitador") == 0 && tieneValor) {
+            delimitador = argv[++i][0];
+        } else if (std::strcmp(arg, "--inactividad") == 0 && tieneValor) {
+            long long valor = 0;
+            if (!leerNumero(argv[++i], 0, INT_MAX, valor)) return valorInvalido(arg, argv[i]);
+            inactividad = (int)valor;
+        } else if (std::strcmp(arg, "--patrones") == 0 && tieneValor) {
+            rutaPatrones = argv[++i];
+        } else if (std::strcmp(arg, "--empaquetar") == 0) {
+            empaquetar = true;
+        } else if (std::strcmp(arg, "--servidor-unix") == 0 && tieneValor) {
+            servidorUnix = argv[++i];
+        } else if (std::strcmp(arg, "--servidor-tcp") == 0 && tieneValor) {
+            long long valor = 0;
+            if (!leerNumero(argv[++i], 1, 65535, valor)) return valorInvalido(arg, argv[i]);
+            servidorTcp = (int)valor;
+        } else if (std::strcmp(arg, "--anillo") == 0 && tieneValor) {
+            anillo = argv[++i];
+        } else if (std::strcmp(arg, "--anillo-productor") == 0 && tieneValor) {
+            return ejecutarProductorAnillo(argv[++i]);
+        } else if (std::strcmp(arg, "--entrada") == 0 && tieneValor) {
+            entrada = argv[++i];
+        } else if (std::strcmp(arg, "--sin-uring") == 0) {
+            permitirUring = false;
+        } else if (std::strcmp(arg, "--traza") == 0 && tieneValor) {
+            rutaTraza = argv[++i];
+        } else if (std::strcmp(arg, "--traza-muestreo") == 0 && tieneValor) {
+            long long valor = 0;
+            if (!leerNumero(argv[++i], 1, INT_MAX, valor)) return valorInvalido(arg, argv[i]);
+            muestreoTraza = (int)valor;
+        } else if (std::strcmp(arg, "--integridad") == 0) {
+            integridad = true;
+        } else if (std::strcmp(arg, "--integridad-estricta") == 0) {
+            integridad = true;
+            integridadEstricta = true;
+        } else if (std::strcmp(arg, "--serial") == 0 && tieneValor) {
+            serial = argv[++i];
+        } else if (std::strcmp(arg, "--baud") == 0 && tieneValor) {
+            long long valor = 0;
+            if (!leerNumero(argv[++i], 1, 4000000, valor)) return valorInvalido(arg, argv[i]);
+            baud = (unsigned long)valor;
+        } else if (std::strcmp(arg, "--control-flujo") == 0 && tieneValor) {
+            if (!leerControlFlujo(argv[++i], controlFlujo)) return valorInvalido(arg, argv[i]);
+        } else if (std::strcmp(arg, "--baja-latencia") == 0 && tieneValor) {
+            // "L,D"; sin coma, D = -1
+            bajaLatencia = true;
+            if (!leerNucleos(argv[++i], nucleoLector, nucleoDecodificador)) return valorInvalido(arg, argv[i]);
+        } else if (std::strcmp(arg, "--tiempo-real") == 0) {
+            tiempoReal = true;
+        } else if (std::strcmp(arg, "--indexar") == 0 && tieneValor) {
+            rutaIndexar = argv[++i];
+        } else if (std::strcmp(arg, "--intervalo-indice") == 0 && tieneValor) {
+            long long valor = 0;
+            if (!leerNumero(argv[++i], 1, INT_MAX, valor)) return valorInvalido(arg, argv[i]);
+            intervaloIndice = (int)valor;
+        } else if (std::strcmp(arg, "--indice") == 0 && tieneValor) {
+            rutaIndice = argv[++i];
+        } else if (std::strcmp(arg, "--desde-trama") == 0 && tieneValor) {
+            if (!leerNumero(argv[++i], 0, LLONG_MAX, desdeTrama)) return valorInvalido(arg, argv[i]);
+        } else if (std::strcmp(arg, "--desde-caracter") == 0 && tieneValor) {
+            if (!leerNumero(argv[++i], 0, LLONG_MAX, desdeCaracter)) return valorInvalido(arg, argv[i]);
+        } else if (std::strcmp(arg, "--desborde") == 0 && tieneValor) {
+            if (!leerDesborde(argv[++i], desborde)) return valorInvalido(arg, argv[i]);
+        } else if (std::strcmp(arg, "--cache") == 0 && tieneValor) {
+            rutaCache = argv[++i];
+        } else if (std::strcmp(arg, "--cache-limite") == 0 && tieneValor) {
+            long long valor = 0;
+            if (!leerNumero(argv[++i], 1, 1024 * 1024, valor)) return valorInvalido(arg, argv[i]);
+            limiteCache = valor * 1024 * 1024;
+        } else if (std::strcmp(arg, "--mezclar") == 0 && tieneValor) {
+            // El resto de los argumentos son las capturas
+            primeraMezcla = i + 1;
+            break;
+        } else {
+            mostrarUso();
+            return (std::strcmp(arg, "--ayuda") == 0) ? 0 : 1;
+        }
+    }
+    
+    // Sin --ventana la memoria queda acotada igual: 0 hay que pedirlo
+    if (ventana < 0) ventana = lote;
+    
+    std::ios::sync_with_stdio(false);
+    TramaBase::setVerboso(false);
+    
+    if (rutaTraza != nullptr && !TrazadorPRT7::activar(rutaTraza, muestreoTraza)) {
+        std::cerr << "No se pudo crear el archivo de traza: " << rutaTraza << std::endl;
+        return 1;
+    }
+    
+    if (servidorUnix != nullptr || servidorTcp > 0) {
+        return ejecutarServidor(servidorUnix, servidorTcp, ventana > 0 ? ventana : lote, lote, delimitador);
+    }
+    
+    if (primeraMezcla > 0) {
+        return ejecutarMezcla(argv + primeraMezcla, argc - primeraMezcla, ventana > 0 ? ventana : lote, lote, delimitador);
+    }
+    
+    if (serial != nullptr) {
+        // Muestra cada trama como la opcion 3 del menu
+        TramaBase::setVerboso(true);
+    }
+    
+    if (!flujo && anillo == nullptr && entrada == nullptr && serial == nullptr) {
+        mostrarUso();
+        return 1;
+    }
+    if ((rutaIndexar != nullptr || rutaIndice != nullptr) && entrada == nullptr) {
+        std::cerr << "--indexar e --indice requieren --entrada con el archivo de captura." << std::endl;
+        return 1;
+    }
+    if (rutaCache != nullptr && entrada == nullptr) {
+        std::cerr << "--cache requiere --entrada con el archivo de captura." << std::endl;
+        return 1;
+    }
+    
+    SalidaConsola consola;
+    AlmacenEmpaquetado almacen;
+    SalidaCarga* salida = &consola;
+    if (empaquetar) {
+        // El texto antiguo pasa al almacen; solo la ventana queda en la lista
+        salida = &almacen;
+        if (ventana == 0) ventana = lote;
+    }
+    
+    AlertaConsola alertas;
+    VigilantePatrones vigilante;
+    if (rutaPatrones != nullptr) {
+        if (vigilante.cargarArchivo(rutaPatrones) < 0) {
+            std::cerr << "No se pudo abrir el archivo de patrones: " << rutaPatrones << std::endl;
+            return 1;
+        }
+        vigilante.construir();
+        vigilante.setObservador(&alertas);
+    }
+    
+    DecodificadorPRT7 decodificador;
+    if (!decodificador.inicializar()) {
+        std::cerr << "Error critico: No se pudo inicializar el decodificador." << std::endl;
+        return 1;
+    }
+    decodificador.configurarVentana(salida, ventana, lote);
+    decodificador.configurarSegmentacion(delimitador, inactividad);
+    decodificador.configurarDesborde(desborde);
+    if (rutaPatrones != nullptr) {
+        decodificador.configurarVigilante(&vigilante);
+    }
+    VerificadorIntegridad verificador;
+    if (integridad) {
+        verificador.setExigir(integridadEstricta);
+        decodificador.configurarIntegridad(&verificador);
+    }
+    if (rutaIndexar != nullptr) {
+        return ejecutarIndexado(entrada, rutaIndexar, intervaloIndice, integridad ? &verificador : nullptr);
+    }
+    
+    // Punto del indice desde el que se retoma la captura
+    long long desdeByte = 0;
+    if (rutaIndice != nullptr) {
+        IndiceCaptura indice;
+        if (!indice.abrir(rutaIndice)) {
+            std::cerr << "No se pudo abrir el indice " << rutaIndice << std::endl;
+            return 1;
+        }
+        if (!indice.coincideCaptura(entrada)) {
+            std::cerr << "El indice " << rutaIndice << " es de una captura de " << indice.getTamanioCaptura()
+                      << " bytes y " << entrada << " no tiene ese tamanio; reconstruyalo con --indexar." << std::endl;
+            return 1;
+        }
+        long long numero = 0;
+        if (desdeCaracter >= 0) {
+            numero = indice.buscarCaracter(desdeCaracter);
+        } else if (desdeTrama >= 0) {
+            numero = indice.buscarTrama(desdeTrama);
+        }
+        PuntoIndice punto;
+        if (numero < 0 || !indice.leerPunto(numero, punto)) {
+            std::cerr << "El indice " << rutaIndice << " esta danado." << std::endl;
+            return 1;
+        }
+        decodificador.posicionarRotor(punto.rotor);
+        desdeByte = punto.entrada;
+        std::cerr << "Retomando en el punto " << numero << ": trama " << numero * indice.getIntervalo()
+                  << ", caracter " << punto.caracteres << ", byte " << punto.entrada << std::endl;
+    }
+    CacheTramos cache;
+    if (rutaCache != nullptr) {
+        if (integridad) {
+            std::cerr << "--cache no se usa con --integridad: cada trama depende de la secuencia anterior." << std::endl;
+        } else if (!cache.abrir(rutaCache, limiteCache)) {
+            if (cache.getOcupada()) {
+                std::cerr << "La cache " << rutaCache << " esta en uso por otro proceso." << std::endl;
+            } else {
+                std::cerr << "No se pudo abrir la cache " << rutaCache << " (o no es un archivo de cache)." << std::endl;
+            }
+            return 1;
+        } else {
+            decodificador.configurarCache(&cache);
+        }
+    }
+    if (serial != nullptr) {
+        if (bajaLatencia) {
+            decodificador.configurarBajaLatencia(nucleoLector, nucleoDecodificador, tiempoReal);
+        }
+        decodificador.ejecutarSerial(serial, baud, controlFlujo);
+    } else if (anillo != nullptr) {
+        decodificador.ejecutarAnillo(anillo);
+    } else if (entrada != nullptr) {
+        decodificador.ejecutarArchivo(entrada, permitirUring, desdeByte);
+    } else {
+        decodificador.ejecutarFlujo();
+    }
+    decodificador.finalizar();
+    
+    if (rutaCache != nullptr && !integridad) {
+        bool guardada = cache.cerrar();
+        long long consultas = cache.getConsultas();
+        long long bytes = cache.getBytesConsultados();
+        std::cerr << "Cache: " << cache.getAciertos() << " de " << consultas << " tramos ("
+                  << (consultas > 0 ? cache.getAciertos() * 100 / consultas : 0) << "%), "
+                  << cache.getBytesAcertados() << " de " << bytes << " bytes ("
+                  << (bytes > 0 ? cache.getBytesAcertados() * 100 / bytes : 0) << "%) desde la cache; "
+                  << cache.getAgregadas() << " agregados, " << cache.getRechazadas() << " sin lugar, "
+                  << cache.getEliminadas() << " desalojados; " << cache.getEntradas() << " tramos en "
+                  << cache.getTamanioArchivo() << " bytes" << (guardada ? "" : " (error al escribir)")
+                  << std::endl;
+    }
+    
+    if (integridad) {
+        std::cerr << "Integridad: " << verificador.getValidas() << " validas, "
+                  << verificador.getCorruptas() << " corruptas, "
+                  << verificador.getDuplicadas() << " duplicadas, "
+                  << verificador.getSinSufijo() << " sin sufijo, "
+                  << verificador.getHuecos() << " huecos (" << verificador.getPerdidas()
+                  << " tramas perdidas)" << std::endl;
+    }
+    
+    if (decodificador.getTotalDescartados() > 0) {
+        std::cerr << "Desborde: " << decodificador.getTotalDescartados()
+                  << " caracteres descartados (lista de " << ListaDeCarga::getCapacidad()
+                  << " nodos)" << std::endl;
+    }
+    
+    TrazadorPRT7::detener();
+    if (TrazadorPRT7::getDescartados() > 0) {
+        std::cerr << "Traza: " << TrazadorPRT7::getDescartados()
+                  << " tramos descartados (aumente --traza-muestreo)" << std::endl;
+    }
+    
+    if (empaquetar) {
+        almacen.imprimir();
+        std::cerr << "Empaquetado: " << almacen.getTamanio() << " caracteres en "
+                  << almacen.getBytesUsados() << " bytes (" << almacen.getRazonCompresion()
+                  << " veces menos que ListaDeCarga)" << std::endl;
+    }
+    return 0;
+}
+
 /**
  * @brief Funcion principal del programa
+ * @param argc Numero de argumentos
+ * @param argv Arreglo de argumentos
  * @return Codigo de salida del programa
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return ejecutarArgumentos(argc, argv);
+    }
+    
     std::cout << "Iniciando sistema..." << std::endl << std::endl;
     
     // Crear instancia del decodificador
@@ -83,7 +658,7 @@ int main() {
             case 3: {
                 char puerto[32];
                 char baudStr[32];
-                std::cout << "Ingrese puerto (ej. COM3): ";
+                std::cout << "Ingrese puerto (ej. COM3 o /dev/ttyUSB0): ";
                 std::cin.getline(puerto, sizeof(puerto));
                 if (puerto[0] == '\0') {
                     std::cout << "Puerto invalido." << std::endl;
@@ -93,7 +668,15 @@ int main() {
                 std::cin.getline(baudStr, sizeof(baudStr));
                 int baud = std::atoi(baudStr);
                 if (baud <= 0) baud = 9600;
-                decodificador.ejecutarSerial(puerto, (unsigned long)baud);
+                char controlStr[32];
+                std::cout << "Control de flujo (enter=ninguno, x=XON/XOFF, r=RTS/CTS): ";
+                std::cin.getline(controlStr, sizeof(controlStr));
+                SerialPort::ControlFlujo control = SerialPort::SIN_CONTROL;
+                if (controlStr[0] != '\0' && !leerControlFlujo(controlStr, control)) {
+                    std::cout << "Control de flujo invalido." << std::endl;
+                    break;
+                }
+                decodificador.ejecutarSerial(puerto, (unsigned long)baud, control);
                 decodificador.finalizar();
                 break; }
 
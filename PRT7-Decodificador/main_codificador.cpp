@@ -0,0 +1,95 @@
+/**
+ * @file main_codificador.cpp
+ * @brief Punto de entrada del codificador PRT-7 (texto plano -> tramas)
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "include/CodificadorPRT7.h"
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @brief Muestra las opciones de linea de comandos
+ */
+void mostrarUso() {
+    std::cerr << "Uso: prt7_codificador [opciones] < texto > tramas" << std::endl;
+    std::cerr << "  --politica P   ninguna | fija | aleatoria (por defecto ninguna)" << std::endl;
+    std::cerr << "  --cada N       Caracteres entre tramas MAP (por defecto 8)" << std::endl;
+    std::cerr << "  --paso N       Posiciones por rotacion con politica fija (por defecto 3)" << std::endl;
+    std::cerr << "  --semilla N    Semilla de la politica aleatoria (por defecto 1)" << std::endl;
+    std::cerr << "  --integridad   Agrega a cada trama el sufijo *secuencia*crc32c" << std::endl;
+    std::cerr << "  --lote N       Hasta N caracteres por trama LOAD, \"L*n,...\" (por defecto 1)" << std::endl;
+}
+
+/**
+ * @brief Funcion principal del codificador
+ * @param argc Numero de argumentos
+ * @param argv Arreglo de argumentos
+ * @return Codigo de salida del programa
+ */
+int main(int argc, char* argv[]) {
+    CodificadorPRT7::PoliticaRotacion politica = CodificadorPRT7::SIN_ROTACION;
+    int cada = 8;
+    int paso = 3;
+    unsigned int semilla = 1;
+    bool integridad = false;
+    int lote = 1;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool tieneValor = (i + 1 < argc);
+        if (std::strcmp(arg, "--politica") == 0 && tieneValor) {
+            const char* valor = argv[++i];
+            if (std::strcmp(valor, "ninguna") == 0) {
+                politica = CodificadorPRT7::SIN_ROTACION;
+            } else if (std::strcmp(valor, "fija") == 0) {
+                politica = CodificadorPRT7::FIJA;
+            } else if (std::strcmp(valor, "aleatoria") == 0) {
+                politica = CodificadorPRT7::ALEATORIA;
+            } else {
+                mostrarUso();
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--cada") == 0 && tieneValor) {
+            cada = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--paso") == 0 && tieneValor) {
+            paso = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--semilla") == 0 && tieneValor) {
+            semilla = (unsigned int)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--integridad") == 0) {
+            integridad = true;
+        } else if (std::strcmp(arg, "--lote") == 0 && tieneValor) {
+            lote = std::atoi(argv[++i]);
+        } else {
+            mostrarUso();
+            return (std::strcmp(arg, "--ayuda") == 0) ? 0 : 1;
+        }
+    }
+    
+    std::ios::sync_with_stdio(false);
+    
+    CodificadorPRT7 codificador;
+    codificador.configurar(politica, cada, paso, semilla);
+    codificador.configurarIntegridad(integridad);
+    codificador.configurarLote(lote);
+    
+    // Bloques grandes para que el costo por llamada sea despreciable
+    const int TAM_BLOQUE = 1 << 16;
+    static char entrada[TAM_BLOQUE];
+    static char salida[TAM_BLOQUE * CodificadorPRT7::MAX_BYTES_POR_CARACTER];
+    
+    while (std::cin.read(entrada, TAM_BLOQUE) || std::cin.gcount() > 0) {
+        int leidos = (int)std::cin.gcount();
+        int escritos = codificador.codificar(entrada, leidos, salida);
+        std::cout.write(salida, escritos);
+    }
+    std::cout.flush();
+    
+    if (codificador.getOmitidos() > 0) {
+        std::cerr << "Aviso: " << codificador.getOmitidos()
+                  << " caracteres no transportables omitidos." << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file AlmacenEmpaquetado.cpp
+ * @brief Implementacion del almacen empaquetado de 5 bits
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/AlmacenEmpaquetado.h"
+#include "../include/ListaDeCarga.h"
+#include <iostream>
+
+// Simbolos con codigo propio, en el orden de su codigo (0-30)
+static const char SIMBOLOS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ .,!?";
+
+IteradorEmpaquetado::IteradorEmpaquetado(const AlmacenEmpaquetado* a)
+    : almacen(a), bit(0), restantes(a->tamanio) {
+}
+
+bool IteradorEmpaquetado::siguiente(char& c) {
+    if (restantes <= 0) return false;
+    
+    unsigned int cod = almacen->leerBits(bit, AlmacenEmpaquetado::BITS_CODIGO);
+    bit += AlmacenEmpaquetado::BITS_CODIGO;
+    
+    if (cod == AlmacenEmpaquetado::CODIGO_ESCAPE) {
+        c = (char)almacen->leerBits(bit, 8);
+        bit += 8;
+    } else {
+        c = SIMBOLOS[cod];
+    }
+    
+    restantes--;
+    return true;
+}
+
+AlmacenEmpaquetado::AlmacenEmpaquetado()
+    : palabras(nullptr), capacidadPalabras(0), bitsUsados(0), tamanio(0) {
+    for (int i = 0; i < 256; i++) {
+        codigo[i] = CODIGO_ESCAPE;
+    }
+    for (int i = 0; i < CODIGO_ESCAPE; i++) {
+        codigo[(unsigned char)SIMBOLOS[i]] = (unsigned char)i;
+    }
+}
+
+AlmacenEmpaquetado::~AlmacenEmpaquetado() {
+    delete[] palabras;
+}
+
+void AlmacenEmpaquetado::escribirBits(unsigned long long valor, int n) {
+    // Reservar con una palabra de holgura para escrituras que cruzan el limite
+    long long necesarias = ((bitsUsados + n) >> 6) + 2;
+    if (necesarias > capacidadPalabras) {
+        long long nuevaCapacidad = (capacidadPalabras == 0) ? 1024 : capacidadPalabras * 2;
+        while (nuevaCapacidad < necesarias) nuevaCapacidad *= 2;
+        
+        unsigned long long* nuevas = new unsigned long long[nuevaCapacidad];
+        for (long long i = 0; i < capacidadPalabras; i++) nuevas[i] = palabras[i];
+        for (long long i = capacidadPalabras; i < nuevaCapacidad; i++) nuevas[i] = 0;
+        
+        delete[] palabras;
+        palabras = nuevas;
+        capacidadPalabras = nuevaCapacidad;
+    }
+    
+    long long indice = bitsUsados >> 6;
+    int desplazamiento = (int)(bitsUsados & 63);
+    palabras[indice] |= valor << desplazamiento;
+    if (desplazamiento + n > 64) {
+        palabras[indice + 1] |= valor >> (64 - desplazamiento);
+    }
+    bitsUsados += n;
+}
+
+unsigned int AlmacenEmpaquetado::leerBits(long long posicion, int n) const {
+    long long indice = posicion >> 6;
+    int desplazamiento = (int)(posicion & 63);
+    unsigned long long valor = palabras[indice] >> desplazamiento;
+    if (desplazamiento + n > 64) {
+        valor |= palabras[indice + 1] << (64 - desplazamiento);
+    }
+    return (unsigned int)(valor & ((1u << n) - 1));
+}
+
+void AlmacenEmpaquetado::agregar(char c) {
+    unsigned char byte = (unsigned char)c;
+    unsigned int cod = codigo[byte];
+    
+    if (cod == CODIGO_ESCAPE) {
+        // Escape y byte literal en una sola escritura de 13 bits
+        escribirBits(CODIGO_ESCAPE | ((unsigned long long)byte << BITS_CODIGO), BITS_CODIGO + 8);
+    } else {
+        escribirBits(cod, BITS_CODIGO);
+    }
+    tamanio++;
+}
+
+void AlmacenEmpaquetado::escribir(const char* datos, int longitud) {
+    for (int i = 0; i < longitud; i++) {
+        agregar(datos[i]);
+    }
+}
+
+void AlmacenEmpaquetado::finMensaje() {
+    agregar('\n');
+}
+
+IteradorEmpaquetado AlmacenEmpaquetado::iterador() const {
+    return IteradorEmpaquetado(this);
+}
+
+void AlmacenEmpaquetado::imprimir() const {
+    char bloque[4096];
+    int usados = 0;
+    
+    IteradorEmpaquetado it = iterador();
+    char c;
+    while (it.siguiente(c)) {
+        bloque[usados++] = c;
+        if (usados == (int)sizeof(bloque)) {
+            std::cout.write(bloque, usados);
+            usados = 0;
+        }
+    }
+    std::cout.write(bloque, usados);
+    std::cout.flush();
+}
+
+long long AlmacenEmpaquetado::getTamanio() const {
+    return tamanio;
+}
+
+long long AlmacenEmpaquetado::getBytesUsados() const {
+    return (bitsUsados + 7) / 8;
+}
+
+double AlmacenEmpaquetado::getRazonCompresion() const {
+    long long bytes = getBytesUsados();
+    if (bytes == 0) return 0.0;
+    return (double)(tamanio * (long long)sizeof(NodoCarga)) / (double)bytes;
+}
+
+void AlmacenEmpaquetado::limpiar() {
+    long long usadas = (bitsUsados >> 6) + 2;
+    if (usadas > capacidadPalabras) usadas = capacidadPalabras;
+    for (long long i = 0; i < usadas; i++) palabras[i] = 0;
+    bitsUsados = 0;
+    tamanio = 0;
+}
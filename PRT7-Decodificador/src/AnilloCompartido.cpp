@@ -0,0 +1,275 @@
+/**
+ * @file AnilloCompartido.cpp
+ * @brief Implementacion de la clase AnilloCompartido
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/AnilloCompartido.h"
+#include <atomic>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#endif
+
+static const unsigned int MAGIA_ANILLO = 0x50525437; // "PRT7"
+static const unsigned int VERSION_ANILLO = 1;
+static const unsigned long long TAM_CABECERA = 256;
+
+/**
+ * @struct CabeceraAnillo
+ * @brief Formato compartido al inicio del segmento
+ * 
+ * Los contadores de escritura y lectura crecen sin limite (64 bits) y la
+ * posicion real es contador & (capacidad - 1). Cada lado tiene una
+ * secuencia de 32 bits que sirve de palabra futex y una bandera que indica
+ * si esta dormido esperando al otro.
+ */
+struct CabeceraAnillo {
+    std::atomic<unsigned int> magia;            ///< MAGIA_ANILLO cuando ya esta inicializada
+    unsigned int version;                       ///< VERSION_ANILLO
+    unsigned long long capacidad;               ///< Bytes de datos (potencia de 2)
+    
+    alignas(64) std::atomic<unsigned long long> escritos; ///< Bytes publicados por el productor
+    std::atomic<unsigned int> secuenciaDatos;   ///< Futex: cambia al publicar datos o cerrar
+    std::atomic<unsigned int> consumidorDormido; ///< El consumidor espera en secuenciaDatos
+    std::atomic<unsigned int> cerrado;          ///< El productor termino el flujo
+    
+    alignas(64) std::atomic<unsigned long long> leidos; ///< Bytes liberados por el consumidor
+    std::atomic<unsigned int> secuenciaEspacio; ///< Futex: cambia al liberar espacio
+    std::atomic<unsigned int> productorDormido; ///< El productor espera en secuenciaEspacio
+};
+
+static_assert(sizeof(CabeceraAnillo) <= TAM_CABECERA, "La cabecera debe caber en 256 bytes");
+
+#ifdef __linux__
+/**
+ * @brief Duerme en la palabra futex mientras conserve el valor esperado
+ */
+static void esperarFutex(std::atomic<unsigned int>* palabra, unsigned int esperado) {
+    // Tiempo maximo para revisar periodicamente aunque se pierda un aviso
+    timespec limite;
+    limite.tv_sec = 0;
+    limite.tv_nsec = 100 * 1000 * 1000;
+    syscall(SYS_futex, (unsigned int*)palabra, FUTEX_WAIT, esperado, &limite, nullptr, 0);
+}
+
+/**
+ * @brief Avanza la secuencia y despierta al otro lado solo si esta dormido
+ */
+static void avisarFutex(std::atomic<unsigned int>* palabra, std::atomic<unsigned int>* dormido) {
+    palabra->fetch_add(1);
+    if (dormido->load() != 0) {
+        syscall(SYS_futex, (unsigned int*)palabra, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+    }
+}
+#endif
+
+AnilloCompartido::AnilloCompartido()
+    : cabecera(nullptr), datos(nullptr), mascara(0), bytesMapeados(0) {
+}
+
+AnilloCompartido::~AnilloCompartido() {
+    cerrar();
+}
+
+bool AnilloCompartido::abrir(const char* nombre, unsigned long long capacidad) {
+#ifdef __linux__
+    cerrar();
+    
+    int fd = shm_open(nombre, O_RDWR | O_CREAT | O_EXCL, 0600);
+    bool creador = (fd >= 0);
+    
+    if (creador) {
+        // Redondear a potencia de 2 para que la posicion sea una mascara
+        unsigned long long cap = 4096;
+        while (cap < capacidad) cap <<= 1;
+        
+        bytesMapeados = TAM_CABECERA + cap;
+        if (ftruncate(fd, (off_t)bytesMapeados) < 0) {
+            close(fd);
+            shm_unlink(nombre);
+            return false;
+        }
+    } else {
+        if (errno != EEXIST) return false;
+        fd = shm_open(nombre, O_RDWR, 0);
+        if (fd < 0) return false;
+        
+        // Esperar a que el creador fije el tamanio del segmento
+        struct stat info;
+        int intentos = 0;
+        while (fstat(fd, &info) == 0 && (unsigned long long)info.st_size <= TAM_CABECERA && intentos < 5000) {
+            usleep(1000);
+            intentos++;
+        }
+        if ((unsigned long long)info.st_size <= TAM_CABECERA) {
+            close(fd);
+            return false;
+        }
+        bytesMapeados = (unsigned long long)info.st_size;
+    }
+    
+    void* mapeo = mmap(nullptr, bytesMapeados, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapeo == MAP_FAILED) {
+        bytesMapeados = 0;
+        return false;
+    }
+    
+    cabecera = (CabeceraAnillo*)mapeo;
+    datos = (char*)mapeo + TAM_CABECERA;
+    
+    if (creador) {
+        // ftruncate deja el segmento en ceros: solo faltan los campos fijos
+        cabecera->version = VERSION_ANILLO;
+        cabecera->capacidad = bytesMapeados - TAM_CABECERA;
+        cabecera->magia.store(MAGIA_ANILLO, std::memory_order_release);
+    } else {
+        int intentos = 0;
+        while (cabecera->magia.load(std::memory_order_acquire) != MAGIA_ANILLO && intentos < 5000) {
+            usleep(1000);
+            intentos++;
+        }
+        if (cabecera->magia.load(std::memory_order_acquire) != MAGIA_ANILLO ||
+            cabecera->version != VERSION_ANILLO) {
+            cerrar();
+            return false;
+        }
+    }
+    
+    mascara = cabecera->capacidad - 1;
+    return true;
+#else
+    (void)nombre; (void)capacidad;
+    return false;
+#endif
+}
+
+int AnilloCompartido::escribir(const char* bytes, int longitud) {
+#ifdef __linux__
+    if (cabecera == nullptr) return 0;
+    
+    unsigned long long capacidad = mascara + 1;
+    int total = 0;
+    while (total < longitud) {
+        unsigned long long w = cabecera->escritos.load(std::memory_order_relaxed);
+        unsigned long long r = cabecera->leidos.load(std::memory_order_acquire);
+        unsigned long long libre = capacidad - (w - r);
+        
+        if (libre == 0) {
+            // Lleno: dormir hasta que el consumidor libere espacio
+            unsigned int secuencia = cabecera->secuenciaEspacio.load();
+            cabecera->productorDormido.store(1);
+            if (cabecera->leidos.load() == r) {
+                esperarFutex(&cabecera->secuenciaEspacio, secuencia);
+            }
+            cabecera->productorDormido.store(0);
+            continue;
+        }
+        
+        unsigned long long n = (unsigned long long)(longitud - total);
+        if (n > libre) n = libre;
+        
+        // Copiar en uno o dos tramos segun si se da la vuelta al anillo
+        unsigned long long inicio = w & mascara;
+        unsigned long long primero = capacidad - inicio;
+        if (primero > n) primero = n;
+        std::memcpy(datos + inicio, bytes + total, primero);
+        std::memcpy(datos, bytes + total + primero, n - primero);
+        
+        cabecera->escritos.store(w + n);
+        avisarFutex(&cabecera->secuenciaDatos, &cabecera->consumidorDormido);
+        total += (int)n;
+    }
+    return total;
+#else
+    (void)bytes; (void)longitud;
+    return 0;
+#endif
+}
+
+bool AnilloCompartido::obtenerBloque(const char*& bloque, int& longitud) {
+#ifdef __linux__
+    if (cabecera == nullptr) return false;
+    
+    while (true) {
+        unsigned long long r = cabecera->leidos.load(std::memory_order_relaxed);
+        unsigned long long w = cabecera->escritos.load(std::memory_order_acquire);
+        
+        if (w != r) {
+            unsigned long long inicio = r & mascara;
+            unsigned long long contiguo = mascara + 1 - inicio;
+            if (contiguo > w - r) contiguo = w - r;
+            if (contiguo > (1u << 30)) contiguo = 1u << 30;
+            
+            bloque = datos + inicio;
+            longitud = (int)contiguo;
+            return true;
+        }
+        
+        if (cabecera->cerrado.load() != 0) {
+            // Revisar una ultima vez por datos publicados antes del cierre
+            if (cabecera->escritos.load() != r) continue;
+            return false;
+        }
+        
+        // Vacio: dormir hasta que el productor publique o cierre
+        unsigned int secuencia = cabecera->secuenciaDatos.load();
+        cabecera->consumidorDormido.store(1);
+        if (cabecera->escritos.load() == r && cabecera->cerrado.load() == 0) {
+            esperarFutex(&cabecera->secuenciaDatos, secuencia);
+        }
+        cabecera->consumidorDormido.store(0);
+    }
+#else
+    (void)bloque; (void)longitud;
+    return false;
+#endif
+}
+
+void AnilloCompartido::liberar(int longitud) {
+#ifdef __linux__
+    if (cabecera == nullptr || longitud <= 0) return;
+    cabecera->leidos.store(cabecera->leidos.load(std::memory_order_relaxed) + (unsigned long long)longitud);
+    avisarFutex(&cabecera->secuenciaEspacio, &cabecera->productorDormido);
+#else
+    (void)longitud;
+#endif
+}
+
+void AnilloCompartido::cerrarEscritura() {
+#ifdef __linux__
+    if (cabecera == nullptr) return;
+    cabecera->cerrado.store(1);
+    avisarFutex(&cabecera->secuenciaDatos, &cabecera->consumidorDormido);
+#endif
+}
+
+void AnilloCompartido::cerrar() {
+#ifdef __linux__
+    if (cabecera != nullptr) {
+        munmap((void*)cabecera, bytesMapeados);
+    }
+#endif
+    cabecera = nullptr;
+    datos = nullptr;
+    mascara = 0;
+    bytesMapeados = 0;
+}
+
+void AnilloCompartido::eliminar(const char* nombre) {
+#ifdef __linux__
+    shm_unlink(nombre);
+#else
+    (void)nombre;
+#endif
+}
@@ -0,0 +1,300 @@
+/**
+ * @file AutomataTramas.cpp
+ * @brief Implementacion de AutomataTramas y generacion de su tabla
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/AutomataTramas.h"
+#include "../include/RegistroTramas.h"
+
+static const int MAX_ETIQUETAS = 10; ///< Etiquetas distintas admitidas en el registro
+static const int MAX_TIPOS = 16;     ///< Filas admitidas en el registro
+
+/**
+ * @brief Clases de caracter; cada etiqueta registrada tiene la suya a partir de PRIMERA_ETIQUETA
+ */
+enum ClaseCaracter { OTRO, LETRA, ESPACIO, COMA, ASTERISCO, DIGITO, PRIMERA_ETIQUETA };
+static const int NUM_CLASES = PRIMERA_ETIQUETA + MAX_ETIQUETAS;
+
+/*
+ * Estados: INICIO (el caracter anterior no es letra), TRAS_LETRA, cuatro
+ * por etiqueta (etiqueta, espacios, asterisco, digitos) y uno de
+ * aceptacion por fila del registro.
+ */
+static const int INICIO = 0;
+static const int TRAS_LETRA = 1;
+static const int ESTADOS_POR_ETIQUETA = 4;
+static const int PRIMER_ESTADO_ACEPTACION = 2 + ESTADOS_POR_ETIQUETA * MAX_ETIQUETAS;
+static const int NUM_ESTADOS = PRIMER_ESTADO_ACEPTACION + MAX_TIPOS;
+
+/**
+ * @brief Lo que hace el reconocedor al entrar en un estado
+ */
+enum AccionEstado { NINGUNA, EMPEZAR_LOTE, ACUMULAR, ACEPTAR };
+
+/**
+ * @struct TablaAutomata
+ * @brief Tablas del automata, generadas en compilacion
+ */
+struct TablaAutomata {
+    unsigned char clase[256];                         ///< Clase de cada byte
+    unsigned char siguiente[NUM_ESTADOS][NUM_CLASES]; ///< Transiciones
+    unsigned char accion[NUM_ESTADOS];                ///< AccionEstado al entrar
+    signed char tipo[NUM_ESTADOS];                    ///< Fila aceptada, o -1
+};
+
+static constexpr int estadoEtiqueta(int k) { return 2 + ESTADOS_POR_ETIQUETA * k; }
+static constexpr int estadoEspacio(int k) { return estadoEtiqueta(k) + 1; }
+static constexpr int estadoAsterisco(int k) { return estadoEtiqueta(k) + 2; }
+static constexpr int estadoDigitos(int k) { return estadoEtiqueta(k) + 3; }
+
+/**
+ * @brief Transicion de la busqueda cuando no hay candidato en curso
+ * @param trasLetra El caracter anterior es una letra
+ * @param clase Clase del caracter leido
+ */
+static constexpr int transicionBase(bool trasLetra, int clase) {
+    if (clase >= PRIMERA_ETIQUETA) return trasLetra ? TRAS_LETRA : estadoEtiqueta(clase - PRIMERA_ETIQUETA);
+    return (clase == LETRA) ? TRAS_LETRA : INICIO;
+}
+
+/**
+ * @brief Cuenta las etiquetas distintas del registro, o -1 si alguna no es A-Z
+ */
+static constexpr int contarEtiquetas() {
+    int distintas = 0;
+    for (int f = 0; f < NUM_TIPOS_TRAMA; f++) {
+        char e = REGISTRO_TRAMAS[f].etiqueta;
+        if (e < 'A' || e > 'Z') return -1;
+        bool nueva = true;
+        for (int g = 0; g < f; g++) {
+            if (REGISTRO_TRAMAS[g].etiqueta == e) nueva = false;
+        }
+        if (nueva) distintas++;
+    }
+    return distintas;
+}
+
+static_assert(NUM_TIPOS_TRAMA <= MAX_TIPOS, "Demasiadas filas en REGISTRO_TRAMAS");
+static_assert(contarEtiquetas() >= 0, "Las etiquetas del registro deben ser letras A-Z");
+static_assert(contarEtiquetas() <= MAX_ETIQUETAS, "Demasiadas etiquetas distintas en REGISTRO_TRAMAS");
+
+/**
+ * @brief Genera las tablas a partir de REGISTRO_TRAMAS
+ */
+static constexpr TablaAutomata construirTabla() {
+    TablaAutomata t{};
+
+    // Etiquetas distintas y la fila que acepta cada una con coma o como lote
+    char etiquetas[MAX_ETIQUETAS] = {};
+    int filaComa[MAX_ETIQUETAS] = {};
+    int filaLote[MAX_ETIQUETAS] = {};
+    int numEtiquetas = 0;
+    for (int f = 0; f < NUM_TIPOS_TRAMA; f++) {
+        int k = 0;
+        while (k < numEtiquetas && etiquetas[k] != REGISTRO_TRAMAS[f].etiqueta) k++;
+        if (k == numEtiquetas) {
+            etiquetas[k] = REGISTRO_TRAMAS[f].etiqueta;
+            filaComa[k] = -1;
+            filaLote[k] = -1;
+            numEtiquetas++;
+        }
+        if (REGISTRO_TRAMAS[f].forma == TipoTrama::LOTE) {
+            if (filaLote[k] < 0) filaLote[k] = f;
+        } else {
+            if (filaComa[k] < 0) filaComa[k] = f;
+        }
+    }
+
+    for (int c = 0; c < 256; c++) {
+        int clase = OTRO;
+        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) clase = LETRA;
+        else if (c == ' ' || c == '\t') clase = ESPACIO;
+        else if (c == ',') clase = COMA;
+        else if (c == '*') clase = ASTERISCO;
+        else if (c >= '0' && c <= '9') clase = DIGITO;
+        t.clase[c] = (unsigned char)clase;
+    }
+    for (int k = 0; k < numEtiquetas; k++) {
+        t.clase[(unsigned char)etiquetas[k]] = (unsigned char)(PRIMERA_ETIQUETA + k);
+        t.clase[(unsigned char)(etiquetas[k] - 'A' + 'a')] = (unsigned char)(PRIMERA_ETIQUETA + k);
+    }
+
+    // Por defecto cada estado sigue buscando como si el anterior no fuera letra
+    for (int s = 0; s < NUM_ESTADOS; s++) {
+        t.tipo[s] = -1;
+        for (int clase = 0; clase < NUM_CLASES; clase++) {
+            t.siguiente[s][clase] = (unsigned char)transicionBase(s == TRAS_LETRA, clase);
+        }
+    }
+
+    for (int k = 0; k < numEtiquetas; k++) {
+        // Un candidato que falla tras la etiqueta sigue con la etiqueta como letra previa
+        for (int clase = 0; clase < NUM_CLASES; clase++) {
+            t.siguiente[estadoEtiqueta(k)][clase] = (unsigned char)transicionBase(true, clase);
+        }
+        t.siguiente[estadoEtiqueta(k)][ESPACIO] = (unsigned char)estadoEspacio(k);
+        t.siguiente[estadoEspacio(k)][ESPACIO] = (unsigned char)estadoEspacio(k);
+        if (filaComa[k] >= 0) {
+            t.siguiente[estadoEtiqueta(k)][COMA] = (unsigned char)(PRIMER_ESTADO_ACEPTACION + filaComa[k]);
+            t.siguiente[estadoEspacio(k)][COMA] = (unsigned char)(PRIMER_ESTADO_ACEPTACION + filaComa[k]);
+        }
+        if (filaLote[k] >= 0) {
+            t.siguiente[estadoEtiqueta(k)][ASTERISCO] = (unsigned char)estadoAsterisco(k);
+            t.siguiente[estadoAsterisco(k)][DIGITO] = (unsigned char)estadoDigitos(k);
+            t.siguiente[estadoDigitos(k)][DIGITO] = (unsigned char)estadoDigitos(k);
+            t.siguiente[estadoDigitos(k)][COMA] = (unsigned char)(PRIMER_ESTADO_ACEPTACION + filaLote[k]);
+            t.accion[estadoAsterisco(k)] = EMPEZAR_LOTE;
+            t.accion[estadoDigitos(k)] = ACUMULAR;
+        }
+    }
+
+    for (int f = 0; f < NUM_TIPOS_TRAMA; f++) {
+        t.accion[PRIMER_ESTADO_ACEPTACION + f] = ACEPTAR;
+        t.tipo[PRIMER_ESTADO_ACEPTACION + f] = (signed char)f;
+    }
+    return t;
+}
+
+static constexpr TablaAutomata TABLA = construirTabla();
+
+int AutomataTramas::recortar(const char* linea, int longitud, int& fin) {
+    // Recortar espacios al inicio y final
+    int inicio = 0;
+    while (inicio < longitud && (linea[inicio] == ' ' || linea[inicio] == '\t' || linea[inicio] == '[')) inicio++;
+    fin = longitud;
+    while (fin > inicio && (linea[fin - 1] == ' ' || linea[fin - 1] == '\t' || linea[fin - 1] == '\r' || linea[fin - 1] == ']')) fin--;
+
+    // Saltar prefijo "TX:" si existe
+    if (fin - inicio >= 3 &&
+        (linea[inicio] == 'T' || linea[inicio] == 't') &&
+        (linea[inicio + 1] == 'X' || linea[inicio + 1] == 'x') &&
+        linea[inicio + 2] == ':') {
+        inicio += 3;
+        if (inicio < fin && linea[inicio] == ' ') inicio++;
+    }
+    return inicio;
+}
+
+int AutomataTramas::leerMarcaTiempo(const char* linea, int longitud, long long& marca) {
+    int i = 0;
+    while (i < longitud && (linea[i] == ' ' || linea[i] == '\t')) i++;
+    if (i >= longitud || linea[i] != '@') return 0;
+
+    int digitos = i + 1;
+    long long valor = 0;
+    int j = digitos;
+    while (j < longitud && linea[j] >= '0' && linea[j] <= '9' && j - digitos < 18) {
+        valor = valor * 10 + (linea[j] - '0');
+        j++;
+    }
+    if (j == digitos || (j < longitud && linea[j] != ' ' && linea[j] != '\t')) return 0;
+
+    while (j < longitud && (linea[j] == ' ' || linea[j] == '\t')) j++;
+    marca = valor;
+    return j;
+}
+
+bool AutomataTramas::reconocer(const char* linea, int longitud, TramaReconocida& r) {
+    if (linea == nullptr || longitud <= 0) {
+        return false;
+    }
+
+    // Se trabaja sobre la vista [inicio, fin) sin copiar ni modificar la linea
+    int fin = 0;
+    int inicio = recortar(linea, longitud, fin);
+
+    // Marca de tiempo opcional "@<entero> " antes de la trama
+    long long marca = TramaBase::SIN_MARCA;
+    inicio += leerMarcaTiempo(linea + inicio, fin - inicio, marca);
+
+    int estado = INICIO;
+    int n = 0;
+    for (int i = inicio; i < fin; i++) {
+        unsigned char c = (unsigned char)linea[i];
+        estado = TABLA.siguiente[estado][TABLA.clase[c]];
+        switch (TABLA.accion[estado]) {
+            case NINGUNA:
+                break;
+            case EMPEZAR_LOTE:
+                n = 0;
+                break;
+            case ACUMULAR:
+                n = n * 10 + (c - '0');
+                // Un lote demasiado largo deja de ser candidato
+                if (n > TramaLoad::MAX_LOTE) estado = INICIO;
+                break;
+            case ACEPTAR: {
+                const TipoTrama& tipo = REGISTRO_TRAMAS[TABLA.tipo[estado]];
+                DatoTrama dato = {' ', 0, nullptr, 0};
+                int valor = 0;
+                if (tipo.forma == TipoTrama::LOTE) {
+                    // El lote se mide sobre la linea sin recortar: puede terminar en espacios
+                    if (n < 1 || i + 1 + n > longitud) {
+                        estado = INICIO;
+                        break;
+                    }
+                    dato.lote = linea + i + 1;
+                    dato.longitud = n;
+                    valor = n;
+                } else {
+                    int p = i + 1;
+                    while (p < fin && (linea[p] == ' ' || linea[p] == '\t')) p++;
+                    if (tipo.forma == TipoTrama::CARACTER) {
+                        // Sin dato se considera espacio
+                        dato.caracter = (p >= fin) ? ' ' : linea[p];
+                        valor = dato.caracter;
+                    } else if (tipo.forma == TipoTrama::ENTERO) {
+                        dato.entero = leerEntero(linea + p, fin - p);
+                        valor = dato.entero;
+                    }
+                }
+                r.tipo = TABLA.tipo[estado];
+                r.dato = dato;
+                r.valor = valor;
+                r.marca = marca;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool AutomataTramas::pareceTrama(const char* linea, int longitud) {
+    int estado = INICIO;
+    for (int i = 0; i < longitud; i++) {
+        estado = TABLA.siguiente[estado][TABLA.clase[(unsigned char)linea[i]]];
+        if (TABLA.accion[estado] == EMPEZAR_LOTE || TABLA.accion[estado] == ACEPTAR) return true;
+    }
+    return false;
+}
+
+int AutomataTramas::leerEntero(const char* str, int longitud) {
+    if (str == nullptr || longitud <= 0) return 0;
+
+    int resultado = 0;
+    int signo = 1;
+    int i = 0;
+
+    // Manejar signo negativo
+    if (str[0] == '-') {
+        signo = -1;
+        i = 1;
+    } else if (str[0] == '+') {
+        i = 1;
+    }
+
+    // Convertir digitos (un numero demasiado largo se satura en vez de desbordar)
+    while (i < longitud && str[i] >= '0' && str[i] <= '9') {
+        int digito = str[i] - '0';
+        if (resultado > (2147483647 - digito) / 10) {
+            resultado = 2147483647;
+            break;
+        }
+        resultado = resultado * 10 + digito;
+        i++;
+    }
+
+    return resultado * signo;
+}
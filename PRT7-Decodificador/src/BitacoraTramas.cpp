@@ -0,0 +1,57 @@
+/**
+ * @file BitacoraTramas.cpp
+ * @brief Implementacion de la clase BitacoraTramas
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/BitacoraTramas.h"
+
+BitacoraTramas::BitacoraTramas(int cap)
+    : entradas(nullptr), capacidad(cap > 0 ? cap : 1), inicio(0), cantidad(0) {
+    entradas = new unsigned short[capacidad];
+}
+
+BitacoraTramas::~BitacoraTramas() {
+    delete[] entradas;
+}
+
+void BitacoraTramas::registrar(TipoEntrada tipo, int valor) {
+    // El valor se limita a los 14 bits disponibles
+    if (valor < 0) valor = 0;
+    if (valor > 0x3FFF) valor = 0x3FFF;
+    unsigned short entrada = (unsigned short)((tipo << 14) | valor);
+    
+    if (cantidad < capacidad) {
+        entradas[(inicio + cantidad) % capacidad] = entrada;
+        cantidad++;
+    } else {
+        // Llena: sobrescribir la mas antigua
+        entradas[inicio] = entrada;
+        inicio = (inicio + 1) % capacidad;
+    }
+}
+
+bool BitacoraTramas::verUltima(TipoEntrada& tipo, int& valor) const {
+    if (cantidad == 0) return false;
+    
+    unsigned short entrada = entradas[(inicio + cantidad - 1) % capacidad];
+    tipo = (TipoEntrada)(entrada >> 14);
+    valor = entrada & 0x3FFF;
+    return true;
+}
+
+void BitacoraTramas::descartarUltima() {
+    if (cantidad > 0) {
+        cantidad--;
+    }
+}
+
+int BitacoraTramas::getCantidad() const {
+    return cantidad;
+}
+
+void BitacoraTramas::vaciar() {
+    inicio = 0;
+    cantidad = 0;
+}
@@ -0,0 +1,607 @@
+/**
+ * @file CacheTramos.cpp
+ * @brief Implementacion de la clase CacheTramos
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/CacheTramos.h"
+#include "../include/DecodificadorPRT7.h"
+#include "../include/ListaDeCarga.h"
+#include "../include/TramaBase.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char MAGICO[8] = { 'P', 'R', 'T', '7', 'C', 'C', 'H', '1' };
+static const char MARCA_REGISTRO[4] = { 'T', 'R', 'M', 'O' };
+
+/*
+ * Eventos grabados: cada byte distinto de '\0' es un caracter insertado;
+ * '\0' va seguido de un codigo.
+ */
+static const char EVENTO_NULO = 0;   ///< Se inserto el caracter '\0'
+static const char EVENTO_FIN = 1;    ///< cerrarMensaje(true)
+static const char EVENTO_CIERRE = 2; ///< cerrarMensaje(false)
+
+static const int CAPACIDAD_TRAMO = CacheTramos::TAM_MAX_TRAMO + EnsambladorLineas::CAPACIDAD + 1;
+static const unsigned long long BASE_HUELLA = 1469598103934665603ULL;
+static const unsigned long long PRIMO_HUELLA = 0x9e3779b97f4a7c15ULL;
+
+/**
+ * @brief Escribe un entero en little-endian con el numero de bytes indicado
+ */
+static void escribirEntero(unsigned char* destino, unsigned long long valor, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        destino[i] = (unsigned char)(valor >> (8 * i));
+    }
+}
+
+/**
+ * @brief Lee un entero little-endian de hasta 64 bits
+ */
+static unsigned long long leerEntero(const unsigned char* origen, int bytes) {
+    unsigned long long valor = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        valor = (valor << 8) | origen[i];
+    }
+    return valor;
+}
+
+/**
+ * @brief Finalizador de splitmix64: reparte cada bit de x en toda la palabra
+ */
+static unsigned long long mezclar(unsigned long long x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief Huella de una linea, de a 8 bytes
+ *
+ * Las lineas de una captura son cortas: casi siempre es una sola vuelta
+ * mas mezclar(). Igual en cualquier arquitectura, para que el archivo de
+ * la cache sirva en otra maquina.
+ */
+static unsigned long long huellaLinea(const char* linea, int longitud) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(linea);
+    unsigned long long h = BASE_HUELLA ^ ((unsigned long long)longitud * PRIMO_HUELLA);
+    int i = 0;
+    for (; i + 8 <= longitud; i += 8) {
+        h = (h ^ leerEntero(p + i, 8)) * PRIMO_HUELLA;
+        h ^= h >> 32;
+    }
+    if (i < longitud) {
+        h = (h ^ leerEntero(p + i, longitud - i)) * PRIMO_HUELLA;
+    }
+    return mezclar(h);
+}
+
+/**
+ * @brief FNV-1a de 32 bits de los eventos de un tramo
+ */
+static unsigned int controlEventos(const char* datos, int longitud) {
+    unsigned int h = 2166136261u;
+    for (int i = 0; i < longitud; i++) {
+        h = (h ^ (unsigned char)datos[i]) * 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Serializa la cabecera fija de un tramo
+ */
+static void escribirRegistro(unsigned char* r, const EntradaCache& e) {
+    escribirEntero(r, e.hash, 8);
+    escribirEntero(r + 8, (unsigned long long)e.longitud, 4);
+    escribirEntero(r + 12, (unsigned long long)e.rotorEntrada, 2);
+    escribirEntero(r + 14, (unsigned long long)e.rotorSalida, 2);
+    escribirEntero(r + 16, (unsigned long long)e.eventos, 4);
+    escribirEntero(r + 20, e.control, 4);
+    escribirEntero(r + 24, (unsigned long long)e.marca, 8);
+    escribirEntero(r + 32, (unsigned long long)e.uso, 8);
+    std::memcpy(r + 40, MARCA_REGISTRO, sizeof(MARCA_REGISTRO));
+    escribirEntero(r + 44, 0, 4);
+}
+
+/**
+ * @brief Toma sin esperar el bloqueo exclusivo del archivo abierto
+ * @return false si otro proceso lo tiene o si la ruta ya no es este
+ *         archivo (otro proceso lo reemplazo al compactar)
+ *
+ * El bloqueo se suelta al cerrar el archivo.
+ */
+static bool bloquearArchivo(std::FILE* f, const char* ruta) {
+#ifdef _WIN32
+    (void)ruta;
+    HANDLE h = (HANDLE)_get_osfhandle(_fileno(f));
+    OVERLAPPED zona = {};
+    return LockFileEx(h, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, MAXDWORD, MAXDWORD, &zona) != 0;
+#else
+    if (flock(fileno(f), LOCK_EX | LOCK_NB) != 0) return false;
+    struct stat abierto;
+    struct stat actual;
+    return fstat(fileno(f), &abierto) == 0 && stat(ruta, &actual) == 0 && abierto.st_dev == actual.st_dev &&
+           abierto.st_ino == actual.st_ino;
+#endif
+}
+
+/**
+ * @brief Deja el archivo abierto en cero bytes
+ */
+static bool vaciarArchivo(std::FILE* f) {
+    if (std::fflush(f) != 0 || std::fseek(f, 0, SEEK_SET) != 0) return false;
+#ifdef _WIN32
+    return _chsize_s(_fileno(f), 0) == 0;
+#else
+    return ftruncate(fileno(f), 0) == 0;
+#endif
+}
+
+CacheTramos::CacheTramos()
+    : archivo(nullptr), ruta(nullptr), ocupada(false), limite(LIMITE_DEFECTO), generacion(0), tamanioArchivo(0),
+      bytesViejos(0), entradas(nullptr), numEntradas(0), capacidadEntradas(0), tabla(nullptr),
+      capacidadTabla(0), decodificador(nullptr), tramo(nullptr), usados(0), hashTramo(BASE_HUELLA),
+      eventos(nullptr), numEventos(0), capacidadEventos(0), consultas(0), aciertos(0),
+      bytesConsultados(0), bytesAcertados(0), agregadas(0), rechazadas(0), eliminadas(0) {
+}
+
+CacheTramos::~CacheTramos() {
+    cerrar();
+    delete[] entradas;
+    delete[] tabla;
+    delete[] tramo;
+    delete[] eventos;
+}
+
+bool CacheTramos::abrir(const char* rutaArchivo, long long limiteBytes) {
+    cerrar();
+    ruta = rutaArchivo;
+    limite = limiteBytes;
+    numEntradas = 0;
+    for (int i = 0; i < capacidadTabla; i++) tabla[i] = -1;
+    bytesViejos = 0;
+    consultas = aciertos = bytesConsultados = bytesAcertados = 0;
+    agregadas = rechazadas = eliminadas = 0;
+    ocupada = false;
+
+    // Crear el archivo si no existe sin truncarlo: otro proceso puede
+    // tenerlo abierto, y solo se vacia despues de tomar el bloqueo
+    std::FILE* creado = std::fopen(ruta, "ab");
+    if (creado != nullptr) std::fclose(creado);
+    archivo = std::fopen(ruta, "r+b");
+    if (archivo == nullptr) return false;
+    if (!bloquearArchivo(archivo, ruta)) {
+        // Dos procesos escribiendo la misma cache la corromperian
+        std::fclose(archivo);
+        archivo = nullptr;
+        ocupada = true;
+        return false;
+    }
+
+    unsigned char cabecera[TAM_CABECERA];
+    std::size_t leidos = std::fread(cabecera, 1, sizeof(cabecera), archivo);
+    if (leidos > 0 && (leidos < 8 || std::memcmp(cabecera, MAGICO, 7) != 0)) {
+        // No es una cache: no se pisa un archivo ajeno
+        std::fclose(archivo);
+        archivo = nullptr;
+        return false;
+    }
+    bool valida = leidos == sizeof(cabecera) && cargar();
+    if (!valida) {
+        // Vacio o de otra version: se empieza de nuevo en el mismo archivo bloqueado
+        numEntradas = 0;
+        for (int i = 0; i < capacidadTabla; i++) tabla[i] = -1;
+        bytesViejos = 0;
+        if (!vaciarArchivo(archivo)) {
+            std::fclose(archivo);
+            archivo = nullptr;
+            return false;
+        }
+        generacion = 1;
+        tamanioArchivo = TAM_CABECERA;
+        std::memcpy(cabecera, MAGICO, sizeof(MAGICO));
+        escribirEntero(cabecera + 8, (unsigned long long)VERSION, 4);
+        escribirEntero(cabecera + 12, 0, 4);
+        escribirEntero(cabecera + 16, (unsigned long long)generacion, 8);
+        if (std::fwrite(cabecera, sizeof(cabecera), 1, archivo) != 1) {
+            std::fclose(archivo);
+            archivo = nullptr;
+            return false;
+        }
+    }
+
+    if (tramo == nullptr) tramo = new char[CAPACIDAD_TRAMO];
+    usados = 0;
+    hashTramo = BASE_HUELLA;
+    return true;
+}
+
+bool CacheTramos::cargar() {
+    unsigned char cabecera[TAM_CABECERA];
+    if (std::fseek(archivo, 0, SEEK_SET) != 0 || std::fread(cabecera, sizeof(cabecera), 1, archivo) != 1) {
+        return false;
+    }
+    if (std::memcmp(cabecera, MAGICO, sizeof(MAGICO)) != 0 || (int)leerEntero(cabecera + 8, 4) != VERSION) {
+        return false;
+    }
+    generacion = (long long)leerEntero(cabecera + 16, 8) + 1;
+    if (std::fseek(archivo, 0, SEEK_END) != 0) return false;
+    long long tamanio = (long long)std::ftell(archivo);
+
+    // Un registro incompleto (ejecucion interrumpida) termina la lectura:
+    // lo que sigue se sobrescribe con los tramos nuevos
+    long long posicion = TAM_CABECERA;
+    std::fseek(archivo, posicion, SEEK_SET);
+    while (posicion + TAM_REGISTRO <= tamanio) {
+        unsigned char r[TAM_REGISTRO];
+        if (std::fread(r, sizeof(r), 1, archivo) != 1) break;
+        EntradaCache e;
+        e.hash = leerEntero(r, 8);
+        e.longitud = (int)leerEntero(r + 8, 4);
+        e.rotorEntrada = (int)leerEntero(r + 12, 2);
+        e.rotorSalida = (int)leerEntero(r + 14, 2);
+        e.eventos = (int)leerEntero(r + 16, 4);
+        e.control = (unsigned int)leerEntero(r + 20, 4);
+        e.marca = (long long)leerEntero(r + 24, 8);
+        e.uso = (long long)leerEntero(r + 32, 8);
+        e.posicion = posicion;
+        e.tocada = false;
+        bool correcto = std::memcmp(r + 40, MARCA_REGISTRO, sizeof(MARCA_REGISTRO)) == 0 &&
+                        e.longitud > 0 && e.longitud <= CAPACIDAD_TRAMO &&
+                        e.eventos >= 0 && e.eventos <= 2 * CAPACIDAD_TRAMO &&
+                        e.rotorEntrada < 26 && e.rotorSalida < 26 &&
+                        posicion + TAM_REGISTRO + e.eventos <= tamanio;
+        if (!correcto) break;
+        nuevaEntrada(e);
+        bytesViejos += TAM_REGISTRO + e.eventos;
+        posicion += TAM_REGISTRO + e.eventos;
+        if (std::fseek(archivo, posicion, SEEK_SET) != 0) break;
+    }
+    tamanioArchivo = posicion;
+    return true;
+}
+
+void CacheTramos::iniciar(DecodificadorPRT7* d) {
+    decodificador = d;
+    usados = 0;
+    hashTramo = BASE_HUELLA;
+}
+
+void CacheTramos::lineaCompleta(const char* linea, int longitud) {
+    if (archivo == nullptr) {
+        decodificador->lineaCompleta(linea, longitud);
+        return;
+    }
+    if (usados + longitud + 1 > CAPACIDAD_TRAMO) {
+        // Solo con lineas mas largas que EnsambladorLineas::CAPACIDAD
+        cerrarTramo();
+        if (longitud + 1 > CAPACIDAD_TRAMO) {
+            decodificador->lineaCompleta(linea, longitud);
+            return;
+        }
+    }
+
+    if (longitud > 0) std::memcpy(tramo + usados, linea, (std::size_t)longitud);
+    tramo[usados + longitud] = '\n';
+    usados += longitud + 1;
+
+    // La huella de la linea incluye su longitud: el tramo no depende de los '\n'
+    unsigned long long m = huellaLinea(linea, longitud);
+    hashTramo = (hashTramo ^ m) * PRIMO_HUELLA;
+    hashTramo ^= hashTramo >> 29;
+    if (usados >= TAM_MAX_TRAMO || (usados >= TAM_MIN_TRAMO && (m & MASCARA_CORTE) == 0)) {
+        cerrarTramo();
+    }
+}
+
+void CacheTramos::terminar() {
+    cerrarTramo();
+}
+
+void CacheTramos::cerrarTramo() {
+    if (usados == 0) return;
+    int rotor = decodificador->getDesplazamiento();
+    consultas++;
+    bytesConsultados += usados;
+
+    int n = buscar(hashTramo, usados, rotor);
+    if (n >= 0) {
+        EntradaCache& e = entradas[n];
+        numEventos = 0;
+        reservarEventos(e.eventos);
+        bool leido = std::fseek(archivo, e.posicion + TAM_REGISTRO, SEEK_SET) == 0 &&
+                     (e.eventos == 0 || std::fread(eventos, (std::size_t)e.eventos, 1, archivo) == 1) &&
+                     controlEventos(eventos, e.eventos) == e.control;
+        if (leido) {
+            aciertos++;
+            bytesAcertados += usados;
+            if (e.uso != generacion) {
+                bytesViejos -= TAM_REGISTRO + e.eventos;
+                e.uso = generacion;
+                e.tocada = true;
+            }
+            decodificador->reproducirTramo(eventos, e.eventos, e.rotorSalida, e.marca);
+            usados = 0;
+            hashTramo = BASE_HUELLA;
+            return;
+        }
+        // Eventos danados: la entrada no vuelve a coincidir y se descarta al compactar
+        if (e.uso == generacion) bytesViejos += TAM_REGISTRO + e.eventos;
+        e.longitud = -1;
+        e.uso = -1;
+    }
+
+    long long marcaAntes = decodificador->getMarcaTiempo();
+    decodificarTramo();
+    EntradaCache e;
+    e.hash = hashTramo;
+    e.longitud = usados;
+    e.rotorEntrada = rotor;
+    e.rotorSalida = decodificador->getDesplazamiento();
+    e.eventos = numEventos;
+    e.control = controlEventos(eventos, numEventos);
+    e.marca = (decodificador->getMarcaTiempo() != marcaAntes) ? decodificador->getMarcaTiempo()
+                                                                : TramaBase::SIN_MARCA;
+    e.uso = generacion;
+    e.posicion = 0;
+    e.tocada = false;
+    guardar(e);
+    usados = 0;
+    hashTramo = BASE_HUELLA;
+}
+
+void CacheTramos::decodificarTramo() {
+    numEventos = 0;
+    decodificador->configurarGrabacion(this);
+    const char* linea = tramo;
+    const char* fin = tramo + usados;
+    while (linea < fin) {
+        const char* salto = static_cast<const char*>(std::memchr(linea, '\n', (std::size_t)(fin - linea)));
+        decodificador->lineaCompleta(linea, (int)(salto - linea));
+        linea = salto + 1;
+    }
+    decodificador->configurarGrabacion(nullptr);
+}
+
+void CacheTramos::guardar(EntradaCache& e) {
+    long long bytes = TAM_REGISTRO + e.eventos;
+    // Solo si al cerrar se puede volver al limite desalojando lo no usado
+    if (tamanioArchivo - bytesViejos + bytes > limite) {
+        rechazadas++;
+        return;
+    }
+    unsigned char r[TAM_REGISTRO];
+    escribirRegistro(r, e);
+    e.posicion = tamanioArchivo;
+    bool escrito = std::fseek(archivo, tamanioArchivo, SEEK_SET) == 0 &&
+                   std::fwrite(r, sizeof(r), 1, archivo) == 1 &&
+                   (e.eventos == 0 || std::fwrite(eventos, (std::size_t)e.eventos, 1, archivo) == 1);
+    if (!escrito) {
+        // El registro a medias se descarta al cargar o se sobrescribe
+        rechazadas++;
+        return;
+    }
+    tamanioArchivo += bytes;
+    nuevaEntrada(e);
+    agregadas++;
+}
+
+void CacheTramos::grabarCaracter(char c) {
+    reservarEventos(2);
+    if (c == '\0') {
+        eventos[numEventos++] = '\0';
+        eventos[numEventos++] = EVENTO_NULO;
+    } else {
+        eventos[numEventos++] = c;
+    }
+}
+
+void CacheTramos::grabarCierre(bool aunqueVacio) {
+    reservarEventos(2);
+    eventos[numEventos++] = '\0';
+    eventos[numEventos++] = aunqueVacio ? EVENTO_FIN : EVENTO_CIERRE;
+}
+
+void CacheTramos::reproducir(const char* datos, int longitud, ListaDeCarga* carga) {
+    for (int i = 0; i < longitud; i++) {
+        if (datos[i] != '\0') {
+            carga->insertarAlFinal(datos[i]);
+            continue;
+        }
+        if (++i >= longitud) break;
+        if (datos[i] == EVENTO_NULO) {
+            carga->insertarAlFinal('\0');
+        } else {
+            carga->cerrarMensaje(datos[i] == EVENTO_FIN);
+        }
+    }
+}
+
+void CacheTramos::reservarEventos(int n) {
+    if (numEventos + n <= capacidadEventos) return;
+    int nueva = (capacidadEventos > 0) ? capacidadEventos : 64 * 1024;
+    while (nueva < numEventos + n) nueva *= 2;
+    char* arreglo = new char[nueva];
+    if (numEventos > 0) std::memcpy(arreglo, eventos, (std::size_t)numEventos);
+    delete[] eventos;
+    eventos = arreglo;
+    capacidadEventos = nueva;
+}
+
+int CacheTramos::buscar(unsigned long long hash, int longitud, int rotor) const {
+    if (capacidadTabla == 0) return -1;
+    int mascara = capacidadTabla - 1;
+    for (int i = (int)(mezclar(hash) & (unsigned long long)mascara);; i = (i + 1) & mascara) {
+        int n = tabla[i];
+        if (n < 0) return -1;
+        const EntradaCache& e = entradas[n];
+        if (e.hash == hash && e.longitud == longitud && e.rotorEntrada == rotor) return n;
+    }
+}
+
+void CacheTramos::indexar(int numero) {
+    int mascara = capacidadTabla - 1;
+    int i = (int)(mezclar(entradas[numero].hash) & (unsigned long long)mascara);
+    while (tabla[i] >= 0) i = (i + 1) & mascara;
+    tabla[i] = numero;
+}
+
+int CacheTramos::nuevaEntrada(const EntradaCache& e) {
+    if (numEntradas == capacidadEntradas) {
+        int nueva = (capacidadEntradas > 0) ? capacidadEntradas * 2 : 256;
+        EntradaCache* arreglo = new EntradaCache[nueva];
+        for (int i = 0; i < numEntradas; i++) arreglo[i] = entradas[i];
+        delete[] entradas;
+        entradas = arreglo;
+        capacidadEntradas = nueva;
+    }
+    entradas[numEntradas] = e;
+    int numero = numEntradas++;
+
+    // Carga maxima de la tabla: la mitad
+    if (numEntradas * 2 > capacidadTabla) {
+        delete[] tabla;
+        capacidadTabla = (capacidadTabla > 0) ? capacidadTabla * 2 : 1024;
+        tabla = new int[capacidadTabla];
+        for (int i = 0; i < capacidadTabla; i++) tabla[i] = -1;
+        for (int i = 0; i < numEntradas; i++) indexar(i);
+    } else {
+        indexar(numero);
+    }
+    return numero;
+}
+
+bool CacheTramos::compactar() {
+    bool* conservar = new bool[numEntradas > 0 ? numEntradas : 1];
+    long long total = TAM_CABECERA;
+    for (int i = 0; i < numEntradas; i++) {
+        conservar[i] = entradas[i].longitud > 0;
+        if (conservar[i]) total += TAM_REGISTRO + entradas[i].eventos;
+    }
+    // Desalojar por generaciones, de la mas antigua a la mas reciente, y
+    // dentro de una generacion en el orden del archivo
+    while (total > limite) {
+        long long minimo = -1;
+        for (int i = 0; i < numEntradas; i++) {
+            if (conservar[i] && (minimo < 0 || entradas[i].uso < minimo)) minimo = entradas[i].uso;
+        }
+        if (minimo < 0) break;
+        for (int i = 0; i < numEntradas && total > limite; i++) {
+            if (conservar[i] && entradas[i].uso == minimo) {
+                conservar[i] = false;
+                total -= TAM_REGISTRO + entradas[i].eventos;
+                eliminadas++;
+            }
+        }
+    }
+
+    int largo = (int)std::strlen(ruta);
+    char* temporal = new char[largo + 5];
+    std::memcpy(temporal, ruta, (std::size_t)largo);
+    std::memcpy(temporal + largo, ".tmp", 5);
+    std::FILE* nuevo = std::fopen(temporal, "wb");
+    bool correcto = nuevo != nullptr;
+
+    unsigned char cabecera[TAM_CABECERA];
+    std::memcpy(cabecera, MAGICO, sizeof(MAGICO));
+    escribirEntero(cabecera + 8, (unsigned long long)VERSION, 4);
+    escribirEntero(cabecera + 12, 0, 4);
+    escribirEntero(cabecera + 16, (unsigned long long)generacion, 8);
+    if (correcto) correcto = std::fwrite(cabecera, sizeof(cabecera), 1, nuevo) == 1;
+
+    // Copiar registro y eventos de cada tramo conservado (el uso ya esta escrito)
+    for (int i = 0; i < numEntradas && correcto; i++) {
+        if (!conservar[i]) continue;
+        int bytes = TAM_REGISTRO + entradas[i].eventos;
+        numEventos = 0;
+        reservarEventos(bytes);
+        correcto = std::fseek(archivo, entradas[i].posicion, SEEK_SET) == 0 &&
+                   std::fread(eventos, (std::size_t)bytes, 1, archivo) == 1 &&
+                   std::fwrite(eventos, (std::size_t)bytes, 1, nuevo) == 1;
+    }
+    if (nuevo != nullptr && std::fclose(nuevo) != 0) correcto = false;
+#ifdef _WIN32
+    // rename no reemplaza un archivo existente ni abierto en Windows
+    std::fclose(archivo);
+    archivo = nullptr;
+    if (correcto) std::remove(ruta);
+#endif
+    // En POSIX el archivo viejo se cierra (y se suelta el bloqueo) despues
+    // del reemplazo: otro proceso no puede tomar la cache a medio compactar
+    if (correcto) correcto = std::rename(temporal, ruta) == 0;
+    if (archivo != nullptr) {
+        std::fclose(archivo);
+        archivo = nullptr;
+    }
+    if (correcto) {
+        tamanioArchivo = total;
+        // Las entradas quedan como en el archivo nuevo
+        int conservadas = 0;
+        long long posicion = TAM_CABECERA;
+        for (int i = 0; i < numEntradas; i++) {
+            if (!conservar[i]) continue;
+            entradas[conservadas] = entradas[i];
+            entradas[conservadas].posicion = posicion;
+            posicion += TAM_REGISTRO + entradas[i].eventos;
+            conservadas++;
+        }
+        numEntradas = conservadas;
+        for (int i = 0; i < capacidadTabla; i++) tabla[i] = -1;
+        for (int i = 0; i < numEntradas; i++) indexar(i);
+    } else {
+        std::remove(temporal);
+    }
+    delete[] temporal;
+    delete[] conservar;
+    return correcto;
+}
+
+bool CacheTramos::cerrar() {
+    if (archivo == nullptr) return true;
+    bool correcto = true;
+
+    unsigned char valor[8];
+    escribirEntero(valor, (unsigned long long)generacion, 8);
+    if (std::fseek(archivo, 16, SEEK_SET) != 0 || std::fwrite(valor, 8, 1, archivo) != 1) correcto = false;
+    for (int i = 0; i < numEntradas; i++) {
+        if (!entradas[i].tocada) continue;
+        escribirEntero(valor, (unsigned long long)entradas[i].uso, 8);
+        if (std::fseek(archivo, entradas[i].posicion + 32, SEEK_SET) != 0 ||
+            std::fwrite(valor, 8, 1, archivo) != 1) {
+            correcto = false;
+        }
+        entradas[i].tocada = false;
+    }
+    if (std::fflush(archivo) != 0) correcto = false;
+
+    if (tamanioArchivo > limite) {
+        if (!compactar()) correcto = false;
+    } else {
+        if (std::fclose(archivo) != 0) correcto = false;
+        archivo = nullptr;
+    }
+    return correcto;
+}
+
+bool CacheTramos::getOcupada() const { return ocupada; }
+long long CacheTramos::getConsultas() const { return consultas; }
+long long CacheTramos::getAciertos() const { return aciertos; }
+long long CacheTramos::getBytesConsultados() const { return bytesConsultados; }
+long long CacheTramos::getBytesAcertados() const { return bytesAcertados; }
+long long CacheTramos::getAgregadas() const { return agregadas; }
+long long CacheTramos::getRechazadas() const { return rechazadas; }
+long long CacheTramos::getEliminadas() const { return eliminadas; }
+int CacheTramos::getEntradas() const { return numEntradas; }
+long long CacheTramos::getTamanioArchivo() const { return tamanioArchivo; }
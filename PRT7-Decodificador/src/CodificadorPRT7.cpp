@@ -0,0 +1,146 @@
+/**
+ * @file CodificadorPRT7.cpp
+ * @brief Implementacion de la clase CodificadorPRT7
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/CodificadorPRT7.h"
+#include "../include/VerificadorIntegridad.h"
+
+CodificadorPRT7::CodificadorPRT7()
+    : politica(SIN_ROTACION), cada(1), paso(0), estadoAzar(1),
+      desplazamiento(0), contador(0), omitidos(0), integridad(false), secuencia(0), lote(1) {
+}
+
+void CodificadorPRT7::configurar(PoliticaRotacion p, int cadaN, int pasoN, unsigned int semilla) {
+    politica = p;
+    cada = (cadaN > 0) ? cadaN : 1;
+    paso = pasoN;
+    estadoAzar = (semilla != 0) ? semilla : 1;
+    contador = 0;
+}
+
+void CodificadorPRT7::configurarIntegridad(bool activar) {
+    integridad = activar;
+    secuencia = 0;
+}
+
+void CodificadorPRT7::configurarLote(int caracteres) {
+    if (caracteres < 1) caracteres = 1;
+    if (caracteres > TramaLoad::MAX_LOTE) caracteres = TramaLoad::MAX_LOTE;
+    lote = caracteres;
+}
+
+void CodificadorPRT7::terminarTrama(const char* inicio, char*& escritura) {
+    if (integridad) {
+        escritura += VerificadorIntegridad::escribirSufijo(inicio, (int)(escritura - inicio), secuencia++, escritura);
+    }
+    *escritura++ = '\n';
+}
+
+void CodificadorPRT7::emitirCarga(const char* datos, int longitud, char*& escritura) {
+    char* trama = escritura;
+    *escritura++ = 'L';
+    if (longitud > 1) {
+        // "L*<n>," con n de uno a tres digitos
+        *escritura++ = '*';
+        if (longitud >= 100) *escritura++ = (char)('0' + longitud / 100);
+        if (longitud >= 10) *escritura++ = (char)('0' + longitud / 10 % 10);
+        *escritura++ = (char)('0' + longitud % 10);
+    }
+    *escritura++ = ',';
+    for (int i = 0; i < longitud; i++) {
+        *escritura++ = datos[i];
+    }
+    terminarTrama(trama, escritura);
+}
+
+int CodificadorPRT7::siguienteRotacion() {
+    if (politica == FIJA) {
+        return paso;
+    }
+    
+    // Generador xorshift32: rotaciones en el rango [-25, 25]
+    estadoAzar ^= estadoAzar << 13;
+    estadoAzar ^= estadoAzar >> 17;
+    estadoAzar ^= estadoAzar << 5;
+    return (int)(estadoAzar % 51) - 25;
+}
+
+int CodificadorPRT7::codificar(const char* texto, int longitud, char* destino) {
+    char* escritura = destino;
+    char pendientes[TramaLoad::MAX_LOTE]; // Lote en curso, ya codificado
+    int enLote = 0;
+    
+    for (int i = 0; i < longitud; i++) {
+        char c = texto[i];
+        
+        if (c == '\n') {
+            if (enLote > 0) { emitirCarga(pendientes, enLote, escritura); enLote = 0; }
+            // Fin de linea: cerrar el mensaje en el receptor
+            char* trama = escritura;
+            escritura[0] = 'F'; escritura[1] = ',';
+            escritura += 2;
+            terminarTrama(trama, escritura);
+            continue;
+        }
+        if (c == '\t' || c == '\r' || c == ']' || c == '\0') {
+            omitidos++;
+            continue;
+        }
+        
+        if (politica != SIN_ROTACION && ++contador >= cada) {
+            contador = 0;
+            int rotacion = siguienteRotacion() % 26;
+            if (rotacion != 0) {
+                // El lote en curso se decodifica con el mapeo anterior
+                if (enLote > 0) { emitirCarga(pendientes, enLote, escritura); enLote = 0; }
+                // Trama MAP: "M,n" con n de uno o dos digitos
+                char* trama = escritura;
+                *escritura++ = 'M';
+                *escritura++ = ',';
+                int magnitud = rotacion;
+                if (rotacion < 0) {
+                    *escritura++ = '-';
+                    magnitud = -rotacion;
+                }
+                if (magnitud >= 10) {
+                    *escritura++ = (char)('0' + magnitud / 10);
+                }
+                *escritura++ = (char)('0' + magnitud % 10);
+                terminarTrama(trama, escritura);
+                
+                desplazamiento = (desplazamiento + rotacion + 26) % 26;
+            }
+        }
+        
+        // El receptor devuelve 'A' + (x - 'A' + desplazamiento) % 26: se envia el inverso
+        if (c >= 'A' && c <= 'Z') {
+            int x = c - 'A' - desplazamiento;
+            if (x < 0) x += 26;
+            c = (char)('A' + x);
+        }
+        
+        pendientes[enLote++] = c;
+        if (enLote == lote) { emitirCarga(pendientes, enLote, escritura); enLote = 0; }
+    }
+    if (enLote > 0) emitirCarga(pendientes, enLote, escritura);
+    
+    return (int)(escritura - destino);
+}
+
+void CodificadorPRT7::reiniciar() {
+    desplazamiento = 0;
+    secuencia = 0;
+    contador = 0;
+    omitidos = 0;
+}
+
+int CodificadorPRT7::getDesplazamiento() const {
+    return desplazamiento;
+}
+
+long long CodificadorPRT7::getOmitidos() const {
+    return omitidos;
+}
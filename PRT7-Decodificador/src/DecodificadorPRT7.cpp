@@ -6,39 +6,94 @@
  */
 
 #include "../include/DecodificadorPRT7.h"
-#include "../include/TramaLoad.h"
-#include "../include/TramaMap.h"
+#include "../include/RegistroTramas.h"
+#include "../include/AutomataTramas.h"
 #include "../include/SerialPort.h"
+#include "../include/BitacoraTramas.h"
+#include "../include/AnilloCompartido.h"
+#include "../include/LectorEntrada.h"
+#include "../include/TrazadorPRT7.h"
+#include "../include/SondasPRT7.h"
+#include "../include/VerificadorIntegridad.h"
+#include "../include/EspejoCarga.h"
+#include "../include/CacheTramos.h"
+#include "../include/PerfilMemoria.h"
 #include <iostream>
+#include <limits>
+#include <chrono>
+#include <new>
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
+/**
+ * @brief Reloj monotono en milisegundos para medir inactividad
+ */
+static long long milisegundosActuales() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Longitud de una cadena terminada en '\0' (reemplazo de strlen sin STL)
+ */
+static int longitudCadena(const char* str) {
+    int n = 0;
+    while (str[n] != '\0') n++;
+    return n;
+}
 
-DecodificadorPRT7::DecodificadorPRT7() : listaCarga(nullptr), rotor(nullptr), activo(false) {
+DecodificadorPRT7::DecodificadorPRT7()
+    : listaCarga(nullptr), rotor(nullptr), activo(false), lineasSerial(false), verboso(TramaBase::esVerboso()),
+      inactividadMs(0), ultimaActividadMs(0), bitacora(nullptr), integridad(nullptr),
+      marcaTiempo(TramaBase::SIN_MARCA), espejo(nullptr), bajaLatencia(false), nucleoLector(-1),
+      nucleoDecodificador(-1), tiempoReal(false), cache(nullptr) {
 }
 
+static_assert(DecodificadorPRT7::TAM_ESPACIO_TRAMA >= TAM_MAX_TRAMA,
+              "TAM_ESPACIO_TRAMA debe alojar cualquier trama registrada");
+
 DecodificadorPRT7::~DecodificadorPRT7() {
+    PRT7_PERFIL_FASE(REINICIO);
+#ifdef PRT7_SIN_HEAP
+    if (listaCarga != nullptr) {
+        listaCarga->~ListaDeCarga();
+    }
+    if (rotor != nullptr) {
+        rotor->~RotorDeMapeo();
+    }
+#else
     if (listaCarga != nullptr) {
         delete listaCarga;
     }
     if (rotor != nullptr) {
         delete rotor;
     }
+#endif
+    if (bitacora != nullptr) {
+        delete bitacora;
+    }
 }
 
 bool DecodificadorPRT7::inicializar() {
-    std::cout << "Iniciando Decodificador PRT-7..." << std::endl;
+    if (verboso) std::cout << "Iniciando Decodificador PRT-7..." << std::endl;
     
     // Crear las estructuras de datos
+    PRT7_PERFIL_FASE(REINICIO);
+#ifdef PRT7_SIN_HEAP
+    listaCarga = new (espacioCarga) ListaDeCarga();
+    rotor = new (espacioRotor) RotorDeMapeo();
+#else
     listaCarga = new ListaDeCarga();
     rotor = new RotorDeMapeo();
-    
-    if (listaCarga == nullptr || rotor == nullptr) {
-        std::cout << "Error: No se pudo inicializar las estructuras de datos." << std::endl;
-        return false;
-    }
+#endif
     
     activo = true;
-    std::cout << "Decodificador inicializado correctamente." << std::endl;
-    std::cout << "Rotor configurado con alfabeto A-Z, cabeza en 'A'." << std::endl;
-    std::cout << std::endl;
+    if (verboso) {
+        std::cout << "Decodificador inicializado correctamente." << std::endl;
+        std::cout << "Rotor configurado con alfabeto A-Z, cabeza en 'A'." << std::endl;
+        std::cout << std::endl;
+    }
     
     return true;
 }
@@ -50,26 +105,65 @@ void DecodificadorPRT7::ejecutar() {
     }
     
     std::cout << "=== MODO MANUAL ===" << std::endl;
-    std::cout << "Ingrese tramas en formato 'L,X' o 'M,N' (escriba 'quit' para salir):" << std::endl;
+    std::cout << "Ingrese tramas en formato 'L,X', 'M,N' o 'F,' (escriba 'quit' para salir):" << std::endl;
     
-    char buffer[100];
+    std::cout << "Comandos: 'retroceder N' deshace N tramas, 'ver I' muestra el caracter I." << std::endl;
+    
+    if (bitacora == nullptr) {
+        configurarBitacora(1024);
+    }
+    
+    char buffer[EnsambladorLineas::CAPACIDAD + 1];
     while (activo) {
         std::cout << "> ";
         std::cin.getline(buffer, sizeof(buffer));
         
+        if (std::cin.fail()) {
+            if (std::cin.eof()) break;
+            // Linea demasiado larga: no es una trama, descartar el resto
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::cout << "Linea demasiado larga: descartada." << std::endl << std::endl;
+            continue;
+        }
+        
         // Verificar comando de salida
         if (buffer[0] == 'q' && buffer[1] == 'u' && buffer[2] == 'i' && buffer[3] == 't') {
             break;
         }
         
+        // Comandos de inspeccion y retroceso
+        if (buffer[0] == 'r' && buffer[1] == 'e' && buffer[2] == 't' && buffer[3] == 'r') {
+            int pedidas = 1;
+            char* espacio = buscarCaracter(buffer, ' ');
+            if (espacio != nullptr) pedidas = stringAEntero(espacio + 1, longitudCadena(espacio + 1));
+            int deshechas = retroceder(pedidas);
+            std::cout << "Tramas deshechas: " << deshechas << " de " << pedidas << std::endl;
+            rotor->mostrarEstado();
+            listaCarga->mostrarEstado();
+            std::cout << std::endl;
+            continue;
+        }
+        if (buffer[0] == 'v' && buffer[1] == 'e' && buffer[2] == 'r' && buffer[3] == ' ') {
+            int posicion = stringAEntero(&buffer[4], longitudCadena(&buffer[4]));
+            char c = obtenerCaracter(posicion);
+            if (c == '\0') {
+                std::cout << "Posicion fuera de rango." << std::endl;
+            } else {
+                std::cout << "Caracter en " << posicion << ": '" << c << "'" << std::endl;
+            }
+            std::cout << std::endl;
+            continue;
+        }
+        
         if (buffer[0] != '\0') {
             std::cout << "Trama recibida: [" << buffer << "] -> Procesando... -> ";
             
-            TramaBase* trama = parsearTrama(buffer);
+            TramaBase* trama = parsearTrama(buffer, longitudCadena(buffer));
             if (trama != nullptr) {
                 procesarTrama(trama);
                 listaCarga->mostrarEstado();
-                delete trama;
+                liberarTrama(trama);
             } else {
                 std::cout << "Error: Formato de trama invalido." << std::endl;
             }
@@ -99,11 +193,11 @@ void DecodificadorPRT7::simularArduino() {
     for (int i = 0; i < totalTramas; i++) {
         std::cout << "Trama recibida: [" << secuencia[i] << "] -> Procesando... -> ";
         
-        TramaBase* trama = parsearTrama(secuencia[i]);
+        TramaBase* trama = parsearTrama(secuencia[i], longitudCadena(secuencia[i]));
         if (trama != nullptr) {
             procesarTrama(trama);
             listaCarga->mostrarEstado();
-            delete trama;
+            liberarTrama(trama);
         } else {
             std::cout << "Error en trama: " << secuencia[i] << std::endl;
         }
@@ -112,79 +206,415 @@ void DecodificadorPRT7::simularArduino() {
     }
 }
 
-TramaBase* DecodificadorPRT7::parsearTrama(const char* linea) {
-    if (linea == nullptr || linea[0] == '\0') {
+void DecodificadorPRT7::ejecutarFlujo() {
+    if (!activo) {
+        std::cout << "Error: Decodificador no inicializado." << std::endl;
+        return;
+    }
+    
+    // Se toman de std::cin los bytes que ya tiene en su buffer y el
+    // ensamblador separa las lineas, sin limite fijo por linea
+    EnsambladorLineas ensamblador;
+    char bloque[8192];
+    std::streambuf* entrada = std::cin.rdbuf();
+    while (activo) {
+#ifndef _WIN32
+        // Con cierre por inactividad, esperar datos sin bloquear mas alla del limite
+        if (inactividadMs > 0 && entrada->in_avail() <= 0) {
+            pollfd entrada;
+            entrada.fd = 0;
+            entrada.events = POLLIN;
+            entrada.revents = 0;
+            if (poll(&entrada, 1, inactividadMs) == 0) {
+                verificarInactividad();
+                continue;
+            }
+        }
+#endif
+        // Esperar al menos un byte; sin buffer (sync_with_stdio) se lee de a uno
+        if (entrada->sgetc() == std::char_traits<char>::eof()) break;
+        std::streamsize disponibles = entrada->in_avail();
+        if (disponibles < 1) disponibles = 1;
+        if (disponibles > (std::streamsize)sizeof(bloque)) disponibles = sizeof(bloque);
+        std::streamsize leidos = entrada->sgetn(bloque, disponibles);
+        if (leidos <= 0) break;
+        ensamblador.alimentar(bloque, (int)leidos, this);
+    }
+    ensamblador.terminar(this);
+}
+
+bool DecodificadorPRT7::procesarLinea(const char* linea, int longitud) {
+    TramoTraza tramo("trama");
+    if (integridad != nullptr && !verificarIntegridad(linea, longitud)) {
+        return false;
+    }
+    TramaBase* trama = parsearTrama(linea, longitud);
+    if (trama == nullptr) {
+        return false;
+    }
+    
+    procesarTrama(trama);
+    liberarTrama(trama);
+    return true;
+}
+
+bool DecodificadorPRT7::verificarIntegridad(const char* linea, int& longitud) {
+    int longitudCuerpo = longitud;
+    VerificadorIntegridad::Resultado r = integridad->verificar(linea, longitud, longitudCuerpo);
+    if (!integridad->aceptar(r)) {
+        return false;
+    }
+    // Quitar el sufijo para que el parser solo vea la trama
+    if (r == VerificadorIntegridad::VALIDA) {
+        longitud = longitudCuerpo;
+    }
+    return true;
+}
+
+void DecodificadorPRT7::configurarIntegridad(VerificadorIntegridad* verificador) {
+    integridad = verificador;
+}
+
+void DecodificadorPRT7::configurarDesborde(ListaDeCarga::PoliticaDesborde politica) {
+    if (listaCarga != nullptr) {
+        listaCarga->configurarDesborde(politica);
+    }
+}
+
+void DecodificadorPRT7::configurarEspejo(EspejoCarga* e) {
+    espejo = e;
+    if (listaCarga != nullptr) {
+        listaCarga->configurarEspejo(e);
+    }
+    publicarEspejo();
+}
+
+void DecodificadorPRT7::configurarBajaLatencia(int lector, int decodificador, bool fifo) {
+    bajaLatencia = true;
+    nucleoLector = lector;
+    nucleoDecodificador = decodificador;
+    tiempoReal = fifo;
+}
+
+void DecodificadorPRT7::configurarCache(CacheTramos* c) {
+    cache = c;
+}
+
+void DecodificadorPRT7::configurarGrabacion(CacheTramos* c) {
+    if (listaCarga != nullptr) {
+        listaCarga->configurarGrabador(c);
+    }
+}
+
+void DecodificadorPRT7::reproducirTramo(const char* eventos, int longitud, int desplazamiento, long long marca) {
+    if (listaCarga == nullptr || rotor == nullptr) return;
+    if (marca != TramaBase::SIN_MARCA) {
+        marcaTiempo = marca;
+    }
+    CacheTramos::reproducir(eventos, longitud, listaCarga);
+    posicionarRotor(desplazamiento);
+}
+
+void DecodificadorPRT7::publicarEspejo() {
+    if (espejo == nullptr || listaCarga == nullptr || rotor == nullptr) return;
+    espejo->publicar(listaCarga->getTamanio(), listaCarga->getTotalInsertados(),
+                     listaCarga->getTotalMensajes(), rotor->getDesplazamiento());
+}
+
+long long DecodificadorPRT7::getTotalDescartados() const {
+    return (listaCarga != nullptr) ? listaCarga->getTotalDescartados() : 0;
+}
+
+void DecodificadorPRT7::configurarSegmentacion(char delimitador, int inactividad) {
+    if (listaCarga != nullptr) {
+        listaCarga->configurarDelimitador(delimitador);
+    }
+    inactividadMs = (inactividad > 0) ? inactividad : 0;
+    ultimaActividadMs = milisegundosActuales();
+}
+
+void DecodificadorPRT7::configurarVigilante(VigilantePatrones* vigilante) {
+    if (listaCarga != nullptr) {
+        listaCarga->configurarVigilante(vigilante);
+    }
+}
+
+void DecodificadorPRT7::verificarInactividad() {
+    if (inactividadMs <= 0 || listaCarga == nullptr) return;
+    
+    long long ahora = milisegundosActuales();
+    if (ahora - ultimaActividadMs >= inactividadMs) {
+        listaCarga->cerrarMensaje();
+        publicarEspejo();
+        // El plazo vuelve a contar desde el cierre
+        ultimaActividadMs = ahora;
+    }
+}
+
+void DecodificadorPRT7::lineaCompleta(const char* linea, int longitud) {
+    TrazadorPRT7::muestrear();
+    if (lineasSerial) {
+        procesarLineaSerial(linea, longitud);
+    } else {
+        procesarLinea(linea, longitud);
+    }
+}
+
+void DecodificadorPRT7::ejecutarAnillo(const char* nombre) {
+    if (!activo) {
+        std::cout << "Error: Decodificador no inicializado." << std::endl;
+        return;
+    }
+    
+    AnilloCompartido anillo;
+    if (!anillo.abrir(nombre, 1 << 20)) {
+        std::cerr << "No se pudo abrir el anillo compartido " << nombre << std::endl;
+        return;
+    }
+    
+    EnsambladorLineas ensamblador;
+    const char* bloque = nullptr;
+    int longitud = 0;
+    while (activo && anillo.obtenerBloque(bloque, longitud)) {
+        ensamblador.alimentar(bloque, longitud, this);
+        anillo.liberar(longitud);
+    }
+    ensamblador.terminar(this);
+    
+    // El productor ya cerro (o se dejo de leer): el nombre queda libre para la proxima sesion
+    AnilloCompartido::eliminar(nombre);
+}
+
+void DecodificadorPRT7::ejecutarArchivo(const char* ruta, bool permitirUring, long long desde) {
+    if (!activo) {
+        std::cout << "Error: Decodificador no inicializado." << std::endl;
+        return;
+    }
+    
+    LectorEntrada lector;
+    if (!lector.abrir(ruta, permitirUring)) {
+        std::cerr << "No se pudo abrir la entrada " << ruta << std::endl;
+        return;
+    }
+    if (desde > 0 && !lector.posicionar(desde)) {
+        std::cerr << "La entrada " << ruta << " no admite posicionarse en el byte " << desde << std::endl;
+        return;
+    }
+    
+    // La cache no conoce el estado del verificador ni registra en la bitacora
+    ReceptorLineas* receptor = this;
+    if (cache != nullptr && integridad == nullptr && bitacora == nullptr) {
+        cache->iniciar(this);
+        receptor = cache;
+    }
+    
+    EnsambladorLineas ensamblador;
+    const char* bloque = nullptr;
+    int longitud = 0;
+    while (activo && lector.siguienteBloque(bloque, longitud)) {
+        ensamblador.alimentar(bloque, longitud, receptor);
+    }
+    ensamblador.terminar(receptor);
+    if (receptor != this) {
+        cache->terminar();
+    }
+}
+
+void DecodificadorPRT7::configurarVerboso(bool activo) {
+    verboso = activo;
+}
+
+void DecodificadorPRT7::configurarVentana(SalidaCarga* destino, int ventana, int lote) {
+    if (listaCarga != nullptr) {
+        listaCarga->configurarVentana(destino, ventana, lote);
+    }
+}
+
+void DecodificadorPRT7::liberarTrama(TramaBase* trama) {
+    {
+        PRT7_PERFIL_FASE(PARSEO);
+#ifdef PRT7_SIN_HEAP
+        trama->~TramaBase();
+#else
+        delete trama;
+#endif
+    }
+    PRT7_PERFIL_CERRAR_TRAMA();
+}
+
+TramaBase* DecodificadorPRT7::parsearTrama(const char* linea, int longitud) {
+    TramoTraza tramo("parsearTrama");
+    if (linea == nullptr || longitud <= 0) {
         return nullptr;
     }
+    PRT7_PERFIL_ABRIR_TRAMA();
+    PRT7_PERFIL_FASE(PARSEO);
     
-    // Copiar la linea para modificarla
-    char buffer[100];
-    copiarCadena(buffer, linea);
+    TramaReconocida reconocida;
+    if (!AutomataTramas::reconocer(linea, longitud, reconocida)) {
+        PRT7_SONDA_TRAMA_RECHAZADA(linea, longitud);
+        PRT7_PERFIL_CERRAR_TRAMA();
+        return nullptr;
+    }
     
-    // Recortar espacios al inicio y final
-    int start = 0; while (buffer[start] == ' ' || buffer[start] == '\t' || buffer[start] == '[') start++;
-    int end = 0; while (buffer[end] != '\0') end++; end--;
-    while (end >= start && (buffer[end] == ' ' || buffer[end] == '\t' || buffer[end] == '\r' || buffer[end] == ']')) { buffer[end] = '\0'; end--; }
+    // El automata ya dice que fila del registro acepto: su fabrica crea la trama
+    const TipoTrama& tipo = REGISTRO_TRAMAS[reconocida.tipo];
+    PRT7_SONDA_TRAMA_ACEPTADA(tipo.sonda, reconocida.valor);
+    PRT7_PERFIL_TIPO_TRAMA(tipo.sonda);
+#ifdef PRT7_SIN_HEAP
+    TramaBase* trama = tipo.fabricar(espacioTrama, reconocida.dato);
+#else
+    TramaBase* trama = tipo.fabricar(nullptr, reconocida.dato);
+#endif
+    return marcar(trama, reconocida.marca);
+}
+
+void DecodificadorPRT7::procesarTrama(TramaBase* trama) {
+    if (trama == nullptr || listaCarga == nullptr || rotor == nullptr) {
+        return;
+    }
     
-    // Saltar prefijo "TX:" si existe
-    if ((buffer[start] == 'T' || buffer[start] == 't') &&
-        (buffer[start+1] == 'X' || buffer[start+1] == 'x') &&
-        buffer[start+2] == ':') {
-        start += 3;
-        if (buffer[start] == ' ') start++;
+    TramoTraza tramo("procesar");
+    PRT7_PERFIL_FASE(PROCESO);
+    // Toda trama aceptada cuenta como actividad, llegue por donde llegue
+    if (inactividadMs > 0) {
+        ultimaActividadMs = milisegundosActuales();
+    }
+    trama->setVerbosa(verboso);
+    if (trama->getMarcaTiempo() != TramaBase::SIN_MARCA) {
+        marcaTiempo = trama->getMarcaTiempo();
+    }
+    if (bitacora == nullptr) {
+        trama->procesar(listaCarga, rotor);
+        publicarEspejo();
+        return;
     }
     
-    // Mover el contenido al inicio si start > 0
-    if (start > 0) {
-        int i = 0; while (buffer[start + i] != '\0') { buffer[i] = buffer[start + i]; i++; }
-        buffer[i] = '\0';
+    // Registrar el efecto observado para poder deshacer la trama despues
+    long long insertadosAntes = listaCarga->getTotalInsertados();
+    long long mensajesAntes = listaCarga->getTotalMensajes();
+    int desplazamientoAntes = rotor->getDesplazamiento();
+    
+    trama->procesar(listaCarga, rotor);
+    
+    int agregados = (int)(listaCarga->getTotalInsertados() - insertadosAntes);
+    int giro = (rotor->getDesplazamiento() - desplazamientoAntes + 26) % 26;
+    
+    if (listaCarga->getTotalMensajes() != mensajesAntes || (agregados > 0 && giro != 0)) {
+        bitacora->registrar(BitacoraTramas::BARRERA, 0);
+    } else if (agregados > 0) {
+        bitacora->registrar(BitacoraTramas::CARGA, agregados);
+    } else if (giro != 0) {
+        bitacora->registrar(BitacoraTramas::ROTACION, giro);
+    } else {
+        bitacora->registrar(BitacoraTramas::NINGUNO, 0);
+    }
+    publicarEspejo();
+}
+
+void DecodificadorPRT7::configurarBitacora(int capacidad) {
+    if (bitacora != nullptr) {
+        delete bitacora;
+        bitacora = nullptr;
+    }
+    if (capacidad > 0) {
+        bitacora = new BitacoraTramas(capacidad);
+    }
+}
+
+int DecodificadorPRT7::retroceder(int tramas) {
+    if (bitacora == nullptr || listaCarga == nullptr || rotor == nullptr) {
+        return 0;
     }
     
-    // Busqueda con criterio estricto: token debe ser 'L' o 'M' seguido inmediatamente de coma (permitiendo espacios)
-    int i = 0;
-    while (buffer[i] != '\0') {
-        char c = buffer[i];
-        if (c == 'L' || c == 'l' || c == 'M' || c == 'm') {
-            // Evitar falsos positivos (palabras como 'Load' o 'mode')
-            if (i > 0) {
-                char prev = buffer[i - 1];
-                bool prevAlpha = (prev >= 'A' && prev <= 'Z') || (prev >= 'a' && prev <= 'z');
-                if (prevAlpha) { i++; continue; }
-            }
-            // Tras el tipo, solo se permiten espacios antes de la coma
-            int j = i + 1;
-            while (buffer[j] == ' ' || buffer[j] == '\t') j++;
-            if (buffer[j] != ',') { i++; continue; }
-
-            // Determinar tipo y dato
-            char tipo = (c == 'l') ? 'L' : (c == 'm' ? 'M' : c);
-            int p = j + 1;
-            // Saltar espacios despues de la coma
-            while (buffer[p] == ' ' || buffer[p] == '\t') p++;
-
-            if (tipo == 'L') {
-                // Trama LOAD: si no hay dato, considerar espacio
-                char caracter = (buffer[p] == '\0') ? ' ' : buffer[p];
-                return new TramaLoad(caracter);
-            } else {
-                // Trama MAP: convertir a entero desde p
-                int rotacion = stringAEntero(&buffer[p]);
-                return new TramaMap(rotacion);
+    int deshechas = 0;
+    BitacoraTramas::TipoEntrada tipo;
+    int valor;
+    while (deshechas < tramas && bitacora->verUltima(tipo, valor)) {
+        if (tipo == BitacoraTramas::BARRERA) break;
+        // Los caracteres ya volcados a la salida no se pueden recuperar
+        if (tipo == BitacoraTramas::CARGA && listaCarga->getTamanio() < valor) break;
+        
+        if (tipo == BitacoraTramas::CARGA) {
+            for (int i = 0; i < valor; i++) {
+                listaCarga->quitarDelFinal();
             }
+        } else if (tipo == BitacoraTramas::ROTACION) {
+            rotor->rotar(-valor);
         }
-        i++;
+        
+        bitacora->descartarUltima();
+        deshechas++;
     }
-    // No se encontro un patron valido
-    return nullptr;
+    publicarEspejo();
+    return deshechas;
 }
 
-void DecodificadorPRT7::procesarTrama(TramaBase* trama) {
-    if (trama != nullptr && listaCarga != nullptr && rotor != nullptr) {
-        trama->procesar(listaCarga, rotor);
+char DecodificadorPRT7::obtenerCaracter(int posicion) const {
+    return (listaCarga != nullptr) ? listaCarga->obtenerEn(posicion) : '\0';
+}
+
+char DecodificadorPRT7::mapearCaracter(char c) {
+    return (rotor != nullptr) ? rotor->getMapeo(c) : c;
+}
+
+int DecodificadorPRT7::getDesplazamiento() const {
+    return (rotor != nullptr) ? rotor->getDesplazamiento() : 0;
+}
+
+TramaBase* DecodificadorPRT7::marcar(TramaBase* trama, long long marca) {
+    trama->setMarcaTiempo(marca);
+    return trama;
+}
+
+long long DecodificadorPRT7::getMarcaTiempo() const {
+    return marcaTiempo;
+}
+
+void DecodificadorPRT7::posicionarRotor(int desplazamiento) {
+    if (rotor != nullptr) {
+        rotor->rotar(desplazamiento - rotor->getDesplazamiento());
+        publicarEspejo();
+    }
+}
+
+long long DecodificadorPRT7::getTotalCaracteres() const {
+    return (listaCarga != nullptr) ? listaCarga->getTotalInsertados() : 0;
+}
+
+void DecodificadorPRT7::cerrarMensaje() {
+    if (listaCarga != nullptr) {
+        listaCarga->cerrarMensaje();
+        publicarEspejo();
+    }
+}
+
+void DecodificadorPRT7::reiniciar() {
+    PRT7_PERFIL_FASE(REINICIO);
+    if (listaCarga != nullptr) {
+        listaCarga->limpiar();
+    }
+    if (rotor != nullptr) {
+        rotor->rotar(-rotor->getDesplazamiento());
+    }
+    if (bitacora != nullptr) {
+        bitacora->vaciar();
     }
+    marcaTiempo = TramaBase::SIN_MARCA;
+    ultimaActividadMs = milisegundosActuales();
+    publicarEspejo();
 }
 
 void DecodificadorPRT7::finalizar() {
+    if (listaCarga != nullptr && listaCarga->enModoVentana()) {
+        // Los lotes anteriores ya se entregaron; solo falta cerrar el ultimo mensaje
+        listaCarga->cerrarMensaje();
+        publicarEspejo();
+        activo = false;
+        PRT7_PERFIL_REPORTAR();
+        return;
+    }
+    
     std::cout << "---" << std::endl;
     std::cout << "Flujo de datos terminado." << std::endl;
     
@@ -196,6 +626,7 @@ void DecodificadorPRT7::finalizar() {
     std::cout << "Liberando memoria... Sistema apagado." << std::endl;
     
     activo = false;
+    PRT7_PERFIL_REPORTAR();
 }
 
 bool DecodificadorPRT7::estaActivo() const {
@@ -206,37 +637,8 @@ void DecodificadorPRT7::detener() {
     activo = false;
 }
 
-int DecodificadorPRT7::stringAEntero(const char* str) {
-    if (str == nullptr) return 0;
-    
-    int resultado = 0;
-    int signo = 1;
-    int i = 0;
-    
-    // Manejar signo negativo
-    if (str[0] == '-') {
-        signo = -1;
-        i = 1;
-    } else if (str[0] == '+') {
-        i = 1;
-    }
-    
-    // Convertir digitos
-    while (str[i] >= '0' && str[i] <= '9') {
-        resultado = resultado * 10 + (str[i] - '0');
-        i++;
-    }
-    
-    return resultado * signo;
-}
-
-void DecodificadorPRT7::copiarCadena(char* destino, const char* origen) {
-    int i = 0;
-    while (origen[i] != '\0') {
-        destino[i] = origen[i];
-        i++;
-    }
-    destino[i] = '\0';
+int DecodificadorPRT7::stringAEntero(const char* str, int longitud) {
+    return AutomataTramas::leerEntero(str, longitud);
 }
 
 char* DecodificadorPRT7::buscarCaracter(char* str, char ch) {
@@ -250,78 +652,96 @@ char* DecodificadorPRT7::buscarCaracter(char* str, char ch) {
     return nullptr;
 }
 
-void DecodificadorPRT7::ejecutarSerial(const char* puerto, unsigned long baud) {
+void DecodificadorPRT7::ejecutarSerial(const char* puerto, unsigned long baud, int controlFlujo) {
     if (!activo) {
         std::cout << "Error: Decodificador no inicializado." << std::endl;
         return;
     }
-#ifdef _WIN32
     SerialPort sp;
     std::cout << "Iniciando Decodificador PRT-7. Conectando a puerto COM..." << std::endl;
     std::cout << "Abriendo puerto " << puerto << " a " << baud << " bps..." << std::endl;
-    if (!sp.abrir(puerto, baud)) {
+    if (!sp.abrir(puerto, baud, (SerialPort::ControlFlujo)controlFlujo)) {
         std::cout << "No se pudo abrir el puerto." << std::endl;
         return;
     }
+    // El hilo es de quien llama: su afinidad y prioridad se restauran al salir
+    SerialPort::EstadoHilo hiloAnterior;
+    hiloAnterior.guardado = false;
+    if (bajaLatencia) {
+        if (!sp.configurarBajaLatencia(nucleoLector, tiempoReal)) {
+            std::cout << "Advertencia: el puerto no admite lecturas no bloqueantes." << std::endl;
+        } else if (!SerialPort::fijarHiloActual(nucleoDecodificador, tiempoReal, &hiloAnterior)) {
+            std::cout << "Advertencia: no se pudo fijar el nucleo o la prioridad del decodificador." << std::endl;
+        }
+    }
+    // Un hilo vacia el puerto mientras se decodifica; la ocupacion de su
+    // cola decide cuando pausar al emisor
+    sp.iniciarRecepcion();
     std::cout << "Conexion establecida. Esperando tramas..." << std::endl;
 
     // Intentar activar emisor interactivo (si estuviera cargado) enviando AUTO\n
     // No afecta al emisor simple; si no existe, se ignora.
     sp.escribirLinea("AUTO");
 
-    char linea[128];
+    // Las lineas se separan con el ensamblador: el ruido mas largo que
+    // EnsambladorLineas::CAPACIDAD se descarta entero en vez de partirse
+    // en tramas falsas
+    EnsambladorLineas ensamblador;
+    char bloque[256];
     int leidos = 0;
-    int ciclosVacios = 0;
+    lineasSerial = true;
     while (activo) {
-        leidos = sp.leerLinea(linea, sizeof(linea));
+        leidos = sp.leer(bloque, sizeof(bloque));
         if (leidos > 0) {
-            ciclosVacios = 0;
-
-            // Detectar rapidamente si la linea parece PRT-7 (L, o M, con coma inmediata tras espacios)
-            bool posible = false; int ii = 0;
-            while (linea[ii] != '\0') {
-                char ch = linea[ii];
-                if (ch == 'L' || ch == 'l' || ch == 'M' || ch == 'm') {
-                    if (ii > 0) {
-                        char prev = linea[ii - 1];
-                        bool prevAlpha = (prev >= 'A' && prev <= 'Z') || (prev >= 'a' && prev <= 'z');
-                        if (prevAlpha) { ii++; continue; }
-                    }
-                    int jj = ii + 1; while (linea[jj] == ' ' || linea[jj] == '\t') jj++;
-                    if (linea[jj] == ',') { posible = true; break; }
-                }
-                ii++;
-            }
-
-            if (!posible) {
-                // Silenciosamente ignorar ruido que no es PRT-7
-                continue;
-            }
-
-            std::cout << "Trama recibida: [" << linea << "] -> Procesando... -> ";
-            TramaBase* trama = parsearTrama(linea);
-            if (trama != nullptr) {
-                procesarTrama(trama);
-                listaCarga->mostrarEstado();
-                delete trama;
-                std::cout << std::endl;
-            } else {
-                std::cout << "Error: Formato de trama invalido." << std::endl;
-            }
+            ensamblador.alimentar(bloque, leidos, this);
         } else if (leidos == 0) {
             // timeout sin datos
-            ciclosVacios++;
-            if (ciclosVacios > 3000) { // ~ varios segundos sin datos
-                // seguir esperando sin terminar; o podria romper
-                ciclosVacios = 0;
-            }
+            verificarInactividad();
         } else {
             std::cout << "Error de lectura del puerto." << std::endl;
             break;
         }
     }
-#else
-    std::cout << "Lectura de puerto COM solo disponible en Windows." << std::endl;
-    (void)puerto; (void)baud;
-#endif
-}
\ No newline at end of file
+    // La ultima linea sin '\n' tambien pasa por el filtro del puerto
+    ensamblador.terminar(this);
+    lineasSerial = false;
+    SerialPort::restaurarHiloActual(hiloAnterior);
+    
+    if (sp.getPausas() > 0 || sp.getPerdidos() > 0) {
+        std::cout << "Control de flujo: " << sp.getPausas() << " pausas del emisor, "
+                  << sp.getPerdidos() << " bytes perdidos." << std::endl;
+    }
+}
+
+void DecodificadorPRT7::procesarLineaSerial(const char* linea, int longitud) {
+    PRT7_SONDA_LINEA_LEIDA(linea, longitud);
+    
+    // Detectar rapidamente si la linea parece PRT-7 (L, M o F con coma inmediata tras espacios)
+    bool posible = false;
+    {
+        TramoTraza tramoFiltro("prefiltro");
+        posible = AutomataTramas::pareceTrama(linea, longitud);
+    }
+    
+    if (!posible) {
+        // Silenciosamente ignorar ruido que no es PRT-7
+        return;
+    }
+    
+    std::cout << "Trama recibida: [";
+    std::cout.write(linea, longitud);
+    std::cout << "] -> Procesando... -> ";
+    if (integridad != nullptr && !verificarIntegridad(linea, longitud)) {
+        std::cout << "Descartada: sufijo de integridad invalido." << std::endl;
+        return;
+    }
+    TramaBase* trama = parsearTrama(linea, longitud);
+    if (trama != nullptr) {
+        procesarTrama(trama);
+        listaCarga->mostrarEstado();
+        liberarTrama(trama);
+        std::cout << std::endl;
+    } else {
+        std::cout << "Error: Formato de trama invalido." << std::endl;
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * @file EnsambladorLineas.cpp
+ * @brief Implementacion de la clase EnsambladorLineas
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/EnsambladorLineas.h"
+#include <cstring>
+
+EnsambladorLineas::EnsambladorLineas()
+    : usados(0), descartando(false), descartadas(0), consumidos(0), finLinea(0) {
+}
+
+void EnsambladorLineas::entregar(const char* linea, int longitud, ReceptorLineas* receptor) {
+    if (longitud > 0 && linea[longitud - 1] == '\r') longitud--;
+    receptor->lineaCompleta(linea, longitud);
+}
+
+void EnsambladorLineas::alimentar(const char* datos, int longitud, ReceptorLineas* receptor) {
+    long long base = consumidos;
+    consumidos += longitud;
+    int i = 0;
+    while (i < longitud) {
+        const char* salto = static_cast<const char*>(std::memchr(datos + i, '\n', longitud - i));
+        int fin = (salto != nullptr) ? (int)(salto - datos) : longitud;
+        int tam = fin - i;
+
+        if (salto == nullptr) {
+            // Resto sin '\n': guardarlo hasta la siguiente llamada
+            if (!descartando) {
+                if (usados + tam > CAPACIDAD) {
+                    // Linea demasiado larga: saltar hasta el proximo '\n' sin copiarla
+                    descartando = true;
+                    descartadas++;
+                    usados = 0;
+                } else {
+                    std::memcpy(buffer + usados, datos + i, tam);
+                    usados += tam;
+                }
+            }
+            return;
+        }
+
+        finLinea = base + fin + 1;
+        if (descartando) {
+            descartando = false;
+        } else if (usados == 0) {
+            // Linea completa dentro del bloque: se entrega sin copiar
+            if (tam <= CAPACIDAD) {
+                entregar(datos + i, tam, receptor);
+            } else {
+                descartadas++;
+            }
+        } else if (usados + tam <= CAPACIDAD) {
+            // Final de una linea repartida entre dos bloques
+            std::memcpy(buffer + usados, datos + i, tam);
+            usados += tam;
+            entregar(buffer, usados, receptor);
+        } else {
+            descartadas++;
+        }
+        usados = 0;
+        i = fin + 1;
+    }
+}
+
+void EnsambladorLineas::terminar(ReceptorLineas* receptor) {
+    if (!descartando && usados > 0) {
+        finLinea = consumidos;
+        entregar(buffer, usados, receptor);
+    }
+    usados = 0;
+    descartando = false;
+}
+
+long long EnsambladorLineas::getDescartadas() const {
+    return descartadas;
+}
+
+int EnsambladorLineas::getPendientes() const {
+    return usados;
+}
+
+long long EnsambladorLineas::getFinLinea() const {
+    return finLinea;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file EspejoCarga.cpp
+ * @brief Implementacion de la clase EspejoCarga
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/EspejoCarga.h"
+#include <thread>
+
+EspejoCarga::EspejoCarga()
+    : frontera(0), retrocesos(0), secuencia(0), tamanio(0), totalInsertados(0), totalMensajes(0),
+      desplazamiento(0), retrocesosPublicados(0), fronteraEscritor(0), retrocesosEscritor(0),
+      secuenciaEscritor(0) {
+    for (int i = 0; i < CAPACIDAD; i++) {
+        texto[i].store('\0', std::memory_order_relaxed);
+    }
+}
+
+void EspejoCarga::retroceder() {
+    retrocesosEscritor++;
+    retrocesos.store(retrocesosEscritor, std::memory_order_relaxed);
+    // Las reescrituras posteriores quedan despues de esta marca
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void EspejoCarga::publicar(int tam, long long insertados, long long mensajes, int rotor) {
+    secuencia.store(secuenciaEscritor + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    tamanio.store(tam, std::memory_order_relaxed);
+    totalInsertados.store(insertados, std::memory_order_relaxed);
+    totalMensajes.store(mensajes, std::memory_order_relaxed);
+    desplazamiento.store(rotor, std::memory_order_relaxed);
+    retrocesosPublicados.store(retrocesosEscritor, std::memory_order_relaxed);
+
+    secuenciaEscritor += 2;
+    secuencia.store(secuenciaEscritor, std::memory_order_release);
+}
+
+bool EspejoCarga::leer(InstantaneaCarga& foto, char* destino, int capacidad, int intentos) const {
+    for (int intento = 0; intento < intentos; intento++) {
+        unsigned long long antes = secuencia.load(std::memory_order_acquire);
+        if (antes & 1) {
+            // El escritor esta a mitad de una publicacion
+            if (intento % 64 == 63) std::this_thread::yield();
+            continue;
+        }
+        int tam = tamanio.load(std::memory_order_relaxed);
+        long long insertados = totalInsertados.load(std::memory_order_relaxed);
+        long long mensajes = totalMensajes.load(std::memory_order_relaxed);
+        int rotor = desplazamiento.load(std::memory_order_relaxed);
+        long long vistos = retrocesosPublicados.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (secuencia.load(std::memory_order_relaxed) != antes) continue;
+
+        // Ultimos caracteres del mensaje: posiciones [inicio, insertados)
+        int n = tam;
+        if (n > MAX_VISIBLE) n = MAX_VISIBLE;
+        if (destino == nullptr) {
+            n = 0;
+        } else if (n > capacidad) {
+            n = capacidad;
+        }
+        long long inicio = insertados - n;
+        for (int i = 0; i < n; i++) {
+            destino[i] = texto[(inicio + i) & (CAPACIDAD - 1)].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (n > 0 && (frontera.load(std::memory_order_relaxed) > inicio + CAPACIDAD ||
+                      retrocesos.load(std::memory_order_relaxed) != vistos)) {
+            continue;
+        }
+
+        foto.version = (long long)(antes / 2);
+        foto.tamanio = tam;
+        foto.totalInsertados = insertados;
+        foto.totalMensajes = mensajes;
+        foto.desplazamiento = rotor;
+        foto.copiados = n;
+        return true;
+    }
+    return false;
+}
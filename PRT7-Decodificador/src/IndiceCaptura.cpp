@@ -0,0 +1,250 @@
+/**
+ * @file IndiceCaptura.cpp
+ * @brief Implementacion de la clase IndiceCaptura
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/IndiceCaptura.h"
+#include "../include/DecodificadorPRT7.h"
+#include "../include/EnsambladorLineas.h"
+#include "../include/LectorEntrada.h"
+#include "../include/SalidaCarga.h"
+#include <cstring>
+#include <sys/stat.h>
+
+static const char MAGICO[8] = { 'P', 'R', 'T', '7', 'I', 'D', 'X', '1' };
+
+/**
+ * @brief Escribe un entero en little-endian con el numero de bytes indicado
+ */
+static void escribirEntero(unsigned char* destino, unsigned long long valor, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        destino[i] = (unsigned char)(valor >> (8 * i));
+    }
+}
+
+/**
+ * @brief Lee un entero little-endian de hasta 64 bits
+ */
+static unsigned long long leerEntero(const unsigned char* origen, int bytes) {
+    unsigned long long valor = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        valor = (valor << 8) | origen[i];
+    }
+    return valor;
+}
+
+/**
+ * @brief Salida que descarta el texto: al construir solo interesa el estado
+ */
+class SalidaDescartada : public SalidaCarga {
+public:
+    void escribir(const char* datos, int longitud) override {
+        (void)datos;
+        (void)longitud;
+    }
+};
+
+/**
+ * @class RegistradorPuntos
+ * @brief Procesa cada linea y anota un punto cada cierto numero de tramas validas
+ */
+class RegistradorPuntos : public ReceptorLineas {
+public:
+    DecodificadorPRT7* decodificador; ///< Decodificador que lleva el estado
+    EnsambladorLineas* ensamblador;   ///< Para saber donde termina cada linea
+    std::FILE* archivo;               ///< Indice en construccion
+    int intervalo;                    ///< Tramas validas entre puntos
+    int desdeUltimo;                  ///< Tramas validas desde el ultimo punto
+    long long tramas;                 ///< Tramas validas en total
+    long long puntos;                 ///< Puntos escritos
+    bool error;                       ///< Fallo una escritura
+
+    RegistradorPuntos()
+        : decodificador(nullptr), ensamblador(nullptr), archivo(nullptr), intervalo(1),
+          desdeUltimo(0), tramas(0), puntos(0), error(false) {}
+
+    /**
+     * @brief Escribe un punto al final del indice
+     */
+    void anotar(long long entrada, long long caracteres, int rotor) {
+        unsigned char registro[IndiceCaptura::TAM_PUNTO];
+        escribirEntero(registro, (unsigned long long)entrada, 8);
+        escribirEntero(registro + 8, (unsigned long long)caracteres, 8);
+        escribirEntero(registro + 16, (unsigned long long)rotor, 4);
+        escribirEntero(registro + 20, 0, 4);
+        if (std::fwrite(registro, sizeof(registro), 1, archivo) != 1) error = true;
+        puntos++;
+    }
+
+    void lineaCompleta(const char* linea, int longitud) override {
+        if (!decodificador->procesarLinea(linea, longitud)) return;
+        tramas++;
+        if (++desdeUltimo == intervalo) {
+            desdeUltimo = 0;
+            anotar(ensamblador->getFinLinea(), decodificador->getTotalCaracteres(),
+                   decodificador->getDesplazamiento());
+        }
+    }
+};
+
+IndiceCaptura::IndiceCaptura()
+    : archivo(nullptr), intervalo(0), tamanioCaptura(0), tramas(0), puntos(0) {
+}
+
+IndiceCaptura::~IndiceCaptura() {
+    cerrar();
+}
+
+bool IndiceCaptura::construir(const char* rutaCaptura, const char* rutaIndice,
+                              int intervaloTramas, VerificadorIntegridad* integridad) {
+    cerrar();
+    if (intervaloTramas <= 0) return false;
+
+    LectorEntrada lector;
+    if (!lector.abrir(rutaCaptura)) return false;
+    std::FILE* salida = std::fopen(rutaIndice, "wb");
+    if (salida == nullptr) return false;
+
+    // Cabecera provisional: tramas y puntos se completan al final
+    unsigned char cabecera[TAM_CABECERA];
+    std::memset(cabecera, 0, sizeof(cabecera));
+    std::fwrite(cabecera, sizeof(cabecera), 1, salida);
+
+    SalidaDescartada descartada;
+    DecodificadorPRT7 decodificador;
+    decodificador.configurarVerboso(false);
+    decodificador.inicializar();
+    decodificador.configurarVentana(&descartada, 4096, 4096);
+    decodificador.configurarIntegridad(integridad);
+
+    EnsambladorLineas ensamblador;
+    RegistradorPuntos registrador;
+    registrador.decodificador = &decodificador;
+    registrador.ensamblador = &ensamblador;
+    registrador.archivo = salida;
+    registrador.intervalo = intervaloTramas;
+    registrador.anotar(0, 0, 0);
+
+    long long bytes = 0;
+    const char* bloque = nullptr;
+    int longitud = 0;
+    while (lector.siguienteBloque(bloque, longitud)) {
+        ensamblador.alimentar(bloque, longitud, &registrador);
+        bytes += longitud;
+    }
+    ensamblador.terminar(&registrador);
+    lector.cerrar();
+
+    std::memcpy(cabecera, MAGICO, sizeof(MAGICO));
+    escribirEntero(cabecera + 8, (unsigned long long)intervaloTramas, 4);
+    escribirEntero(cabecera + 16, (unsigned long long)bytes, 8);
+    escribirEntero(cabecera + 24, (unsigned long long)registrador.tramas, 8);
+    escribirEntero(cabecera + 32, (unsigned long long)registrador.puntos, 8);
+    bool correcto = !registrador.error && std::fseek(salida, 0, SEEK_SET) == 0 &&
+                    std::fwrite(cabecera, sizeof(cabecera), 1, salida) == 1;
+    if (std::fclose(salida) != 0) correcto = false;
+    if (!correcto) return false;
+
+    return abrir(rutaIndice);
+}
+
+bool IndiceCaptura::abrir(const char* rutaIndice) {
+    cerrar();
+    archivo = std::fopen(rutaIndice, "rb");
+    if (archivo == nullptr) return false;
+
+    unsigned char cabecera[TAM_CABECERA];
+    if (std::fread(cabecera, sizeof(cabecera), 1, archivo) != 1 ||
+        std::memcmp(cabecera, MAGICO, sizeof(MAGICO)) != 0) {
+        cerrar();
+        return false;
+    }
+    intervalo = (int)leerEntero(cabecera + 8, 4);
+    tamanioCaptura = (long long)leerEntero(cabecera + 16, 8);
+    tramas = (long long)leerEntero(cabecera + 24, 8);
+    puntos = (long long)leerEntero(cabecera + 32, 8);
+    if (intervalo <= 0 || puntos <= 0) {
+        cerrar();
+        return false;
+    }
+    return true;
+}
+
+bool IndiceCaptura::leerPunto(long long numero, PuntoIndice& punto) {
+    if (archivo == nullptr || numero < 0 || numero >= puntos) return false;
+
+    unsigned char registro[TAM_PUNTO];
+    long long posicion = TAM_CABECERA + numero * TAM_PUNTO;
+    if (std::fseek(archivo, (long)posicion, SEEK_SET) != 0 ||
+        std::fread(registro, sizeof(registro), 1, archivo) != 1) {
+        return false;
+    }
+    punto.entrada = (long long)leerEntero(registro, 8);
+    punto.caracteres = (long long)leerEntero(registro + 8, 8);
+    punto.rotor = (int)leerEntero(registro + 16, 4);
+    return true;
+}
+
+long long IndiceCaptura::buscarTrama(long long trama) const {
+    if (puntos == 0 || trama <= 0) return 0;
+    // El punto k queda justo despues de k * intervalo tramas
+    long long numero = trama / intervalo;
+    return (numero < puntos) ? numero : puntos - 1;
+}
+
+long long IndiceCaptura::buscarCaracter(long long posicion) {
+    // Los caracteres de cada punto no decrecen: busqueda binaria
+    long long bajo = 0;
+    long long alto = puntos - 1;
+    PuntoIndice punto;
+    while (bajo < alto) {
+        long long medio = bajo + (alto - bajo + 1) / 2;
+        if (!leerPunto(medio, punto)) return -1;
+        if (punto.caracteres <= posicion) {
+            bajo = medio;
+        } else {
+            alto = medio - 1;
+        }
+    }
+    return (puntos > 0) ? bajo : -1;
+}
+
+int IndiceCaptura::getIntervalo() const {
+    return intervalo;
+}
+
+bool IndiceCaptura::coincideCaptura(const char* rutaCaptura) const {
+#ifdef _WIN32
+    struct _stat64 info;
+    if (_stat64(rutaCaptura, &info) != 0) return false;
+#else
+    struct stat info;
+    if (stat(rutaCaptura, &info) != 0 || !S_ISREG(info.st_mode)) return false;
+#endif
+    return (long long)info.st_size == tamanioCaptura;
+}
+
+long long IndiceCaptura::getTamanioCaptura() const {
+    return tamanioCaptura;
+}
+
+long long IndiceCaptura::getTramas() const {
+    return tramas;
+}
+
+long long IndiceCaptura::getPuntos() const {
+    return puntos;
+}
+
+void IndiceCaptura::cerrar() {
+    if (archivo != nullptr) {
+        std::fclose(archivo);
+        archivo = nullptr;
+    }
+    intervalo = 0;
+    tamanioCaptura = 0;
+    tramas = 0;
+    puntos = 0;
+}
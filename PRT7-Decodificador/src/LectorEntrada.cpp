@@ -0,0 +1,383 @@
+/**
+ * @file LectorEntrada.cpp
+ * @brief Implementacion de la clase LectorEntrada (io_uring con respaldo en read())
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/LectorEntrada.h"
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#else
+#include <cstdio>
+#endif
+
+// Estados de cada bloque
+static const int BLOQUE_LIBRE = 0;
+static const int BLOQUE_EN_VUELO = 1;
+static const int BLOQUE_COMPLETO = 2;
+static const int BLOQUE_ENTREGADO = 3;
+
+#ifdef __linux__
+/**
+ * @struct AnilloUring
+ * @brief Colas de envio y de completado de io_uring mapeadas en memoria
+ */
+struct AnilloUring {
+    int fd;                     ///< Descriptor de la instancia io_uring
+    void* mapeoSq;              ///< Mapeo de la cola de envio
+    unsigned long tamanioSq;    ///< Bytes del mapeo de la cola de envio
+    void* mapeoCq;              ///< Mapeo de la cola de completado
+    unsigned long tamanioCq;    ///< Bytes del mapeo de la cola de completado
+    io_uring_sqe* sqes;         ///< Entradas de envio
+    unsigned long tamanioSqes;  ///< Bytes del mapeo de entradas
+    unsigned* sqCola;           ///< Cola (tail) de envio
+    unsigned* sqMascara;        ///< Mascara de la cola de envio
+    unsigned* sqArreglo;        ///< Indices de entradas de envio
+    unsigned* cqCabeza;         ///< Cabeza (head) de completado
+    unsigned* cqCola;           ///< Cola (tail) de completado
+    unsigned* cqMascara;        ///< Mascara de la cola de completado
+    io_uring_cqe* cqes;         ///< Entradas de completado
+};
+#else
+struct AnilloUring {
+    int fd;
+};
+#endif
+
+LectorEntrada::LectorEntrada()
+    : fd(-1), propio(false), esArchivo(false), tamanioArchivo(0), inicio(0), memoria(nullptr),
+      numBloques(0), siguienteEnvio(0), siguienteEntrega(0), entregado(-1), enVuelo(0),
+      finEnvio(false), uring(nullptr) {
+    for (int i = 0; i < MAX_BLOQUES; i++) {
+        estado[i] = BLOQUE_LIBRE;
+        resultado[i] = 0;
+        secuencia[i] = 0;
+    }
+}
+
+LectorEntrada::~LectorEntrada() {
+    cerrar();
+}
+
+bool LectorEntrada::abrir(const char* ruta, bool permitirUring) {
+    cerrar();
+#ifdef __linux__
+    if (ruta[0] == '-' && ruta[1] == '\0') {
+        fd = 0;
+        propio = false;
+    } else {
+        fd = open(ruta, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        propio = true;
+    }
+    
+    struct stat info;
+    esArchivo = (fstat(fd, &info) == 0 && S_ISREG(info.st_mode));
+    tamanioArchivo = esArchivo ? (long long)info.st_size : 0;
+    
+    // En archivos varios bloques leen por delante; en flujos basta doble buffer
+    numBloques = esArchivo ? MAX_BLOQUES : 2;
+    if (!permitirUring || !iniciarUring()) {
+        numBloques = 1;
+    }
+    memoria = new char[(long long)numBloques * TAM_BLOQUE];
+    
+    inicio = 0;
+    siguienteEnvio = 0;
+    siguienteEntrega = 0;
+    entregado = -1;
+    enVuelo = 0;
+    finEnvio = false;
+    return true;
+#else
+    (void)ruta; (void)permitirUring;
+    return false;
+#endif
+}
+
+bool LectorEntrada::iniciarUring() {
+#ifdef __linux__
+    io_uring_params parametros;
+    unsigned char* p = (unsigned char*)&parametros;
+    for (unsigned i = 0; i < sizeof(parametros); i++) p[i] = 0;
+    
+    int ringFd = (int)syscall(__NR_io_uring_setup, MAX_BLOQUES, &parametros);
+    if (ringFd < 0) return false;
+    
+    // IORING_OP_READ y el desplazamiento -1 (posicion actual) llegaron juntos (5.6)
+    if (!(parametros.features & IORING_FEAT_RW_CUR_POS)) {
+        close(ringFd);
+        return false;
+    }
+    
+    AnilloUring* u = new AnilloUring();
+    u->fd = ringFd;
+    u->tamanioSq = parametros.sq_off.array + parametros.sq_entries * sizeof(unsigned);
+    u->tamanioCq = parametros.cq_off.cqes + parametros.cq_entries * sizeof(io_uring_cqe);
+    u->tamanioSqes = parametros.sq_entries * sizeof(io_uring_sqe);
+    
+    u->mapeoSq = mmap(nullptr, u->tamanioSq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_SQ_RING);
+    u->mapeoCq = mmap(nullptr, u->tamanioCq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_CQ_RING);
+    void* mapeoSqes = mmap(nullptr, u->tamanioSqes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           ringFd, IORING_OFF_SQES);
+    if (u->mapeoSq == MAP_FAILED || u->mapeoCq == MAP_FAILED || mapeoSqes == MAP_FAILED) {
+        if (u->mapeoSq != MAP_FAILED) munmap(u->mapeoSq, u->tamanioSq);
+        if (u->mapeoCq != MAP_FAILED) munmap(u->mapeoCq, u->tamanioCq);
+        if (mapeoSqes != MAP_FAILED) munmap(mapeoSqes, u->tamanioSqes);
+        close(ringFd);
+        delete u;
+        return false;
+    }
+    
+    char* sq = (char*)u->mapeoSq;
+    char* cq = (char*)u->mapeoCq;
+    u->sqes = (io_uring_sqe*)mapeoSqes;
+    u->sqCola = (unsigned*)(sq + parametros.sq_off.tail);
+    u->sqMascara = (unsigned*)(sq + parametros.sq_off.ring_mask);
+    u->sqArreglo = (unsigned*)(sq + parametros.sq_off.array);
+    u->cqCabeza = (unsigned*)(cq + parametros.cq_off.head);
+    u->cqCola = (unsigned*)(cq + parametros.cq_off.tail);
+    u->cqMascara = (unsigned*)(cq + parametros.cq_off.ring_mask);
+    u->cqes = (io_uring_cqe*)(cq + parametros.cq_off.cqes);
+    
+    uring = u;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void LectorEntrada::enviarLecturas() {
+#ifdef __linux__
+    int nuevas = 0;
+    int bloques[MAX_BLOQUES];
+    unsigned cola = *uring->sqCola;
+    
+    for (int i = 0; i < numBloques && !finEnvio; i++) {
+        if (estado[i] != BLOQUE_LIBRE) continue;
+        // Sin desplazamiento el orden de varias lecturas no esta garantizado
+        if (!esArchivo && enVuelo + nuevas > 0) break;
+        
+        long long desplazamiento = inicio + siguienteEnvio * (long long)TAM_BLOQUE;
+        if (esArchivo && desplazamiento >= tamanioArchivo) {
+            finEnvio = true;
+            break;
+        }
+        
+        unsigned indice = cola & *uring->sqMascara;
+        io_uring_sqe* sqe = &uring->sqes[indice];
+        unsigned char* p = (unsigned char*)sqe;
+        for (unsigned k = 0; k < sizeof(*sqe); k++) p[k] = 0;
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fd;
+        sqe->addr = (unsigned long long)(memoria + (long long)i * TAM_BLOQUE);
+        sqe->len = TAM_BLOQUE;
+        sqe->off = esArchivo ? (unsigned long long)desplazamiento : (unsigned long long)-1;
+        sqe->user_data = (unsigned long long)i;
+        uring->sqArreglo[indice] = indice;
+        cola++;
+        
+        estado[i] = BLOQUE_EN_VUELO;
+        secuencia[i] = siguienteEnvio++;
+        bloques[nuevas++] = i;
+    }
+    
+    if (nuevas > 0) {
+        __atomic_store_n(uring->sqCola, cola, __ATOMIC_RELEASE);
+        int enviadas;
+        do {
+            enviadas = (int)syscall(__NR_io_uring_enter, uring->fd, nuevas, 0, 0, nullptr, 0);
+        } while (enviadas < 0 && errno == EINTR);
+        if (enviadas < 0) enviadas = 0;
+        if (enviadas < nuevas) {
+            // El kernel no tomo las ultimas entradas: se retiran de la cola
+            // (sin SQPOLL nadie mas la lee) y sus bloques se piden despues
+            int retiradas = nuevas - enviadas;
+            __atomic_store_n(uring->sqCola, cola - (unsigned)retiradas, __ATOMIC_RELEASE);
+            for (int k = enviadas; k < nuevas; k++) estado[bloques[k]] = BLOQUE_LIBRE;
+            siguienteEnvio -= retiradas;
+            finEnvio = false;
+        }
+        enVuelo += enviadas;
+    }
+#endif
+}
+
+bool LectorEntrada::pasarARead() {
+#ifdef __linux__
+    // Sin lecturas en vuelo ni bloques por entregar, read() sigue desde el
+    // primer byte no entregado; en un flujo la posicion ya es esa
+    if (esArchivo && lseek(fd, (off_t)(inicio + siguienteEntrega * (long long)TAM_BLOQUE), SEEK_SET) < 0) {
+        return false;
+    }
+    liberarUring();
+    numBloques = 1;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void LectorEntrada::liberarUring() {
+#ifdef __linux__
+    if (uring == nullptr) return;
+    munmap(uring->sqes, uring->tamanioSqes);
+    munmap(uring->mapeoSq, uring->tamanioSq);
+    munmap(uring->mapeoCq, uring->tamanioCq);
+    close(uring->fd);
+    delete uring;
+    uring = nullptr;
+#endif
+}
+
+bool LectorEntrada::recogerCompletadas() {
+#ifdef __linux__
+    unsigned cabeza = *uring->cqCabeza;
+    if (cabeza == __atomic_load_n(uring->cqCola, __ATOMIC_ACQUIRE)) {
+        int r;
+        do {
+            r = (int)syscall(__NR_io_uring_enter, uring->fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        } while (r < 0 && errno == EINTR);
+        if (r < 0) return false;
+    }
+    
+    unsigned cola = __atomic_load_n(uring->cqCola, __ATOMIC_ACQUIRE);
+    while (cabeza != cola) {
+        io_uring_cqe* cqe = &uring->cqes[cabeza & *uring->cqMascara];
+        int i = (int)cqe->user_data;
+        int res = cqe->res;
+        cabeza++;
+        enVuelo--;
+        
+        if (res == -EAGAIN || res == -EINTR) {
+            // Repetir la misma lectura con el mismo numero de orden
+            estado[i] = BLOQUE_LIBRE;
+            long long guardado = siguienteEnvio;
+            bool finGuardado = finEnvio;
+            siguienteEnvio = secuencia[i];
+            finEnvio = false;
+            __atomic_store_n(uring->cqCabeza, cabeza, __ATOMIC_RELEASE);
+            enviarLecturas();
+            siguienteEnvio = guardado;
+            finEnvio = finGuardado;
+            continue;
+        }
+        
+        estado[i] = BLOQUE_COMPLETO;
+        resultado[i] = res;
+        if (res <= 0) {
+            finEnvio = true; // fin de archivo o error: no pedir mas
+        }
+    }
+    __atomic_store_n(uring->cqCabeza, cabeza, __ATOMIC_RELEASE);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool LectorEntrada::posicionar(long long desplazamiento) {
+#ifdef __linux__
+    if (fd < 0 || !esArchivo || siguienteEnvio > 0 || desplazamiento < 0) return false;
+    if (uring == nullptr && lseek(fd, (off_t)desplazamiento, SEEK_SET) < 0) return false;
+    inicio = desplazamiento;
+    return true;
+#else
+    (void)desplazamiento;
+    return false;
+#endif
+}
+
+bool LectorEntrada::siguienteBloque(const char*& datos, int& longitud) {
+    if (fd < 0) return false;
+    
+    // Reciclar el bloque entregado en la llamada anterior
+    if (entregado >= 0) {
+        estado[entregado] = BLOQUE_LIBRE;
+        entregado = -1;
+    }
+    
+#ifdef __linux__
+    if (uring == nullptr) {
+        ssize_t n;
+        do {
+            n = read(fd, memoria, TAM_BLOQUE);
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) return false;
+        datos = memoria;
+        longitud = (int)n;
+        return true;
+    }
+    
+    while (true) {
+        enviarLecturas();
+        
+        for (int i = 0; i < numBloques; i++) {
+            if (estado[i] != BLOQUE_COMPLETO || secuencia[i] != siguienteEntrega) continue;
+            
+            if (resultado[i] <= 0) {
+                estado[i] = BLOQUE_LIBRE;
+                return false;
+            }
+            
+            estado[i] = BLOQUE_ENTREGADO;
+            entregado = i;
+            siguienteEntrega++;
+            datos = memoria + (long long)i * TAM_BLOQUE;
+            longitud = resultado[i];
+            
+            // Dejar la siguiente lectura en vuelo mientras se procesa este bloque
+            enviarLecturas();
+            return true;
+        }
+        
+        if (enVuelo == 0) {
+            // Nada en vuelo sin haber llegado al final: io_uring_enter
+            // rechazo las lecturas, y se sigue con read()
+            if (finEnvio || !pasarARead()) return false;
+            return siguienteBloque(datos, longitud);
+        }
+        if (!recogerCompletadas()) return false;
+    }
+#else
+    (void)datos; (void)longitud;
+    return false;
+#endif
+}
+
+bool LectorEntrada::usaUring() const {
+    return uring != nullptr;
+}
+
+void LectorEntrada::cerrar() {
+#ifdef __linux__
+    if (uring != nullptr) {
+        // Esperar las lecturas en vuelo antes de liberar sus buffers
+        while (enVuelo > 0 && recogerCompletadas()) {
+        }
+        liberarUring();
+    }
+    if (propio && fd >= 0) {
+        close(fd);
+    }
+#endif
+    delete[] memoria;
+    memoria = nullptr;
+    fd = -1;
+    propio = false;
+    numBloques = 0;
+    enVuelo = 0;
+    for (int i = 0; i < MAX_BLOQUES; i++) {
+        estado[i] = BLOQUE_LIBRE;
+    }
+}
@@ -6,17 +6,94 @@
  */
 
 #include "../include/ListaDeCarga.h"
+#include "../include/SalidaCarga.h"
+#include "../include/VigilantePatrones.h"
+#include "../include/EspejoCarga.h"
+#include "../include/CacheTramos.h"
+#include "../include/SondasPRT7.h"
+#include "../include/PerfilMemoria.h"
 #include <iostream>
 
-ListaDeCarga::ListaDeCarga() : cabeza(nullptr), cola(nullptr), tamanio(0) {
+ListaDeCarga::ListaDeCarga()
+    : cabeza(nullptr), cola(nullptr), tamanio(0),
+      salida(nullptr), capacidadVentana(0), tamanioLote(0), totalVolcados(0),
+      delimitador('\0'), totalMensajes(0), mensajeAbierto(false), vigilante(nullptr),
+      espejo(nullptr), grabador(nullptr), politica(VOLCAR_ANTIGUOS), totalDescartados(0),
+#ifdef PRT7_SIN_HEAP
+      libres(nullptr), indiceInicio(0), indiceCantidad(0), indiceCapacidad(CAPACIDAD_INDICE),
+#else
+      indice(nullptr), indiceInicio(0), indiceCantidad(0), indiceCapacidad(0),
+#endif
+      bloqueBase(0), baseAbsoluta(0) {
+#ifdef PRT7_SIN_HEAP
+    // Todos los nodos empiezan en la lista de libres
+    for (int i = PRT7_CAPACIDAD_CARGA - 1; i >= 0; i--) {
+        nodos[i].siguiente = libres;
+        libres = &nodos[i];
+    }
+#endif
 }
 
 ListaDeCarga::~ListaDeCarga() {
     limpiar();
+#ifndef PRT7_SIN_HEAP
+    delete[] indice;
+#endif
+}
+
+NodoCarga* ListaDeCarga::crearNodo(char c) {
+#ifdef PRT7_SIN_HEAP
+    NodoCarga* nodo = libres;
+    if (nodo == nullptr) return nullptr;
+    libres = nodo->siguiente;
+    nodo->dato = c;
+    nodo->siguiente = nullptr;
+    nodo->anterior = nullptr;
+    return nodo;
+#else
+    PRT7_PERFIL_FASE(ALMACEN);
+    return new NodoCarga(c);
+#endif
+}
+
+void ListaDeCarga::liberarNodo(NodoCarga* nodo) {
+#ifdef PRT7_SIN_HEAP
+    nodo->siguiente = libres;
+    libres = nodo;
+#else
+    PRT7_PERFIL_FASE(ALMACEN);
+    delete nodo;
+#endif
+}
+
+bool ListaDeCarga::resolverDesborde() {
+    if (politica == DESCARTAR_NUEVO || cabeza == nullptr) {
+        totalDescartados++;
+        return false;
+    }
+    
+    // Se libera un lote completo para no repetir esto en cada caracter
+    int cantidad = (tamanioLote > 0 && tamanioLote < tamanio) ? tamanioLote : tamanio;
+    bool entregar = (politica == VOLCAR_ANTIGUOS && salida != nullptr);
+    if (!entregar) totalDescartados += cantidad;
+    volcarInicio(cantidad, entregar);
+    return true;
 }
 
 void ListaDeCarga::insertarAlFinal(char caracter) {
-    NodoCarga* nuevo = new NodoCarga(caracter);
+    if (grabador != nullptr) {
+        grabador->grabarCaracter(caracter);
+    }
+    if (delimitador != '\0' && caracter == delimitador) {
+        terminarMensaje(true);
+        return;
+    }
+    
+    NodoCarga* nuevo = crearNodo(caracter);
+    if (nuevo == nullptr) {
+        if (!resolverDesborde()) return;
+        nuevo = crearNodo(caracter);
+    }
     
     if (estaVacia()) {
         // Primer elemento
@@ -29,7 +106,133 @@ void ListaDeCarga::insertarAlFinal(char caracter) {
         cola = nuevo;
     }
     
+    if ((baseAbsoluta + tamanio) % SALTO_INDICE == 0) {
+        indexarNodo(nuevo);
+    }
+    
     tamanio++;
+    mensajeAbierto = true;
+    PRT7_SONDA_CARACTER_AGREGADO(caracter, baseAbsoluta + tamanio);
+    
+    if (vigilante != nullptr) {
+        vigilante->avanzar(caracter);
+    }
+    if (espejo != nullptr) {
+        espejo->anotar(baseAbsoluta + tamanio - 1, caracter);
+    }
+    
+    // En modo ventana, volcar el lote mas antiguo en cuanto se completa
+    if (salida != nullptr && capacidadVentana > 0 && tamanio >= capacidadVentana + tamanioLote) {
+        volcarInicio(tamanioLote);
+    }
+}
+
+void ListaDeCarga::volcarInicio(int cantidad, bool entregar) {
+    char bloque[4096];
+    int usados = 0;
+    
+    while (cantidad > 0 && cabeza != nullptr) {
+        NodoCarga* siguiente = cabeza->siguiente;
+        bloque[usados++] = cabeza->dato;
+        liberarNodo(cabeza);
+        cabeza = siguiente;
+        tamanio--;
+        cantidad--;
+        totalVolcados++;
+        baseAbsoluta++;
+        
+        if (usados == (int)sizeof(bloque)) {
+            if (salida != nullptr && entregar) salida->escribir(bloque, usados);
+            usados = 0;
+        }
+    }
+    
+    if (usados > 0 && salida != nullptr && entregar) {
+        salida->escribir(bloque, usados);
+    }
+    
+    if (cabeza == nullptr) {
+        cola = nullptr;
+    } else {
+        cabeza->anterior = nullptr;
+    }
+    
+    recortarIndice();
+}
+
+void ListaDeCarga::indexarNodo(NodoCarga* nodo) {
+    if (indiceCantidad == 0) {
+        indiceInicio = 0;
+        bloqueBase = (baseAbsoluta + tamanio) / SALTO_INDICE;
+    }
+    
+    if (indiceInicio + indiceCantidad == indiceCapacidad) {
+#ifdef PRT7_SIN_HEAP
+        // Arreglo fijo: la lista nunca abarca mas bloques que CAPACIDAD_INDICE - 1,
+        // asi que basta con mover las entradas validas al frente
+        for (int i = 0; i < indiceCantidad; i++) {
+            indice[i] = indice[indiceInicio + i];
+        }
+#else
+        // Reutilizar el espacio liberado al frente o crecer al doble
+        PRT7_PERFIL_FASE(ALMACEN);
+        NodoCarga** destino = indice;
+        if (indiceInicio <= indiceCantidad) {
+            indiceCapacidad = (indiceCapacidad == 0) ? 64 : indiceCapacidad * 2;
+            destino = new NodoCarga*[indiceCapacidad];
+        }
+        for (int i = 0; i < indiceCantidad; i++) {
+            destino[i] = indice[indiceInicio + i];
+        }
+        if (destino != indice) {
+            delete[] indice;
+            indice = destino;
+        }
+#endif
+        indiceInicio = 0;
+    }
+    
+    indice[indiceInicio + indiceCantidad] = nodo;
+    indiceCantidad++;
+}
+
+void ListaDeCarga::recortarIndice() {
+    // Bloques que quedaron antes de la cabeza
+    while (indiceCantidad > 0 && bloqueBase * SALTO_INDICE < baseAbsoluta) {
+        indiceInicio++;
+        indiceCantidad--;
+        bloqueBase++;
+    }
+    
+    // Bloques que quedaron despues de la cola
+    long long finAbsoluto = baseAbsoluta + tamanio;
+    while (indiceCantidad > 0 && (bloqueBase + indiceCantidad - 1) * SALTO_INDICE >= finAbsoluto) {
+        indiceCantidad--;
+    }
+    
+    if (indiceCantidad == 0) {
+        indiceInicio = 0;
+    }
+}
+
+void ListaDeCarga::configurarVentana(SalidaCarga* destino, int ventana, int lote) {
+    salida = destino;
+    capacidadVentana = (ventana > 0) ? ventana : 0;
+    tamanioLote = (lote > 0) ? lote : 1;
+}
+
+void ListaDeCarga::vaciarVentana() {
+    if (salida != nullptr) {
+        volcarInicio(tamanio);
+    }
+}
+
+bool ListaDeCarga::enModoVentana() const {
+    return salida != nullptr;
+}
+
+long long ListaDeCarga::getTotalVolcados() const {
+    return totalVolcados;
 }
 
 void ListaDeCarga::imprimirMensaje() {
@@ -75,11 +278,124 @@ void ListaDeCarga::limpiar() {
     NodoCarga* actual = cabeza;
     while (actual != nullptr) {
         NodoCarga* siguiente = actual->siguiente;
-        delete actual;
+        liberarNodo(actual);
         actual = siguiente;
     }
     
+    baseAbsoluta += tamanio;
     cabeza = nullptr;
     cola = nullptr;
     tamanio = 0;
-}
\ No newline at end of file
+    indiceInicio = 0;
+    indiceCantidad = 0;
+    mensajeAbierto = false;
+}
+
+void ListaDeCarga::configurarDelimitador(char c) {
+    delimitador = c;
+}
+
+void ListaDeCarga::cerrarMensaje(bool aunqueVacio) {
+    if (grabador != nullptr) {
+        grabador->grabarCierre(aunqueVacio);
+    }
+    terminarMensaje(aunqueVacio);
+}
+
+void ListaDeCarga::terminarMensaje(bool aunqueVacio) {
+    // Aunque la ventana ya haya entregado todo, el mensaje sigue abierto
+    if (!mensajeAbierto && !aunqueVacio) return;
+    
+    if (salida != nullptr) {
+        volcarInicio(tamanio);
+        salida->finMensaje();
+    } else {
+        imprimirMensaje();
+        limpiar();
+    }
+    
+    mensajeAbierto = false;
+    totalMensajes++;
+    
+    if (vigilante != nullptr) {
+        vigilante->reiniciar();
+    }
+}
+
+void ListaDeCarga::configurarVigilante(VigilantePatrones* v) {
+    vigilante = v;
+}
+
+void ListaDeCarga::configurarEspejo(EspejoCarga* e) {
+    espejo = e;
+}
+
+void ListaDeCarga::configurarGrabador(CacheTramos* c) {
+    grabador = c;
+}
+
+long long ListaDeCarga::getTotalMensajes() const {
+    return totalMensajes;
+}
+
+char ListaDeCarga::obtenerEn(int posicion) const {
+    if (posicion < 0 || posicion >= tamanio) return '\0';
+    
+    long long absoluta = baseAbsoluta + posicion;
+    long long bloque = absoluta / SALTO_INDICE;
+    
+    // Saltar al inicio del bloque con el indice y avanzar dentro de el
+    NodoCarga* actual = cabeza;
+    long long pasos = posicion;
+    if (indiceCantidad > 0 && bloque >= bloqueBase) {
+        actual = indice[indiceInicio + (int)(bloque - bloqueBase)];
+        pasos = absoluta - bloque * SALTO_INDICE;
+    }
+    
+    while (pasos > 0) {
+        actual = actual->siguiente;
+        pasos--;
+    }
+    return actual->dato;
+}
+
+bool ListaDeCarga::quitarDelFinal() {
+    if (cola == nullptr) return false;
+    
+    NodoCarga* anterior = cola->anterior;
+    liberarNodo(cola);
+    cola = anterior;
+    
+    if (cola == nullptr) {
+        cabeza = nullptr;
+    } else {
+        cola->siguiente = nullptr;
+    }
+    
+    tamanio--;
+    recortarIndice();
+    if (espejo != nullptr) {
+        espejo->retroceder();
+    }
+    return true;
+}
+
+long long ListaDeCarga::getTotalInsertados() const {
+    return baseAbsoluta + tamanio;
+}
+
+void ListaDeCarga::configurarDesborde(PoliticaDesborde p) {
+    politica = p;
+}
+
+long long ListaDeCarga::getTotalDescartados() const {
+    return totalDescartados;
+}
+
+int ListaDeCarga::getCapacidad() {
+#ifdef PRT7_SIN_HEAP
+    return PRT7_CAPACIDAD_CARGA;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,278 @@
+/**
+ * @file MezcladorCapturas.cpp
+ * @brief Implementacion de la clase MezcladorCapturas
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/MezcladorCapturas.h"
+#include "../include/AutomataTramas.h"
+#include "../include/DecodificadorPRT7.h"
+#include "../include/EnsambladorLineas.h"
+#include "../include/SalidaCarga.h"
+#include "../include/TramaBase.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @struct FlujoCaptura
+ * @brief Una captura: su archivo, la linea actual con su marca y su propio decodificador
+ *
+ * Tambien es la SalidaCarga de su decodificador: sella cada volcado con
+ * la marca de la trama que lo produjo y lo pasa a la SalidaLineaTiempo.
+ */
+struct FlujoCaptura : public SalidaCarga {
+    std::FILE* archivo;              ///< Archivo de la captura
+    int numero;                      ///< Numero de la captura en el mezclador
+    char* bloque;                    ///< Bytes leidos y aun no consumidos
+    int inicio;                      ///< Primer byte sin consumir del bloque
+    int fin;                         ///< Fin de los bytes validos del bloque
+    bool agotado;                    ///< El archivo ya no tiene mas bytes
+    bool descartando;                ///< Se salta una linea demasiado larga
+    const char* linea;               ///< Linea actual (vista dentro del bloque)
+    int longitud;                    ///< Caracteres de la linea actual
+    long long marca;                 ///< Marca de la linea actual (heredada si no trae)
+    bool retrocedio;                 ///< La marca de la linea actual es menor que la anterior
+    bool conTexto;                   ///< El mensaje en curso ya entrego caracteres
+    DecodificadorPRT7 decodificador; ///< Lista de carga y rotor de esta captura
+    SalidaLineaTiempo* destino;      ///< Destino comun de todas las capturas
+
+    FlujoCaptura()
+        : archivo(nullptr), numero(0), bloque(new char[MezcladorCapturas::TAM_BLOQUE]), inicio(0),
+          fin(0), agotado(false), descartando(false), linea(nullptr), longitud(0),
+          marca(TramaBase::SIN_MARCA), retrocedio(false), conTexto(false), destino(nullptr) {}
+
+    ~FlujoCaptura() {
+        cerrar();
+        delete[] bloque;
+    }
+
+    void cerrar() {
+        if (archivo != nullptr) {
+            std::fclose(archivo);
+            archivo = nullptr;
+        }
+    }
+
+    /**
+     * @brief Toma la linea encontrada, quita el '\r' final y lee su marca (tambien tras "TX:" o '[')
+     */
+    void tomarLinea(const char* datos, int tam) {
+        if (tam > 0 && datos[tam - 1] == '\r') tam--;
+        linea = datos;
+        longitud = tam;
+        long long nueva = 0;
+        retrocedio = false;
+        int hasta = 0;
+        int desde = AutomataTramas::recortar(datos, tam, hasta);
+        if (AutomataTramas::leerMarcaTiempo(datos + desde, hasta - desde, nueva) > 0) {
+            retrocedio = (nueva < marca);
+            marca = nueva;
+        }
+    }
+
+    /**
+     * @brief Avanza a la siguiente linea, leyendo del archivo si hace falta
+     * @return false si la captura se agoto
+     */
+    bool avanzar() {
+        for (;;) {
+            if (inicio < fin) {
+                const char* salto = static_cast<const char*>(std::memchr(bloque + inicio, '\n', fin - inicio));
+                if (salto != nullptr) {
+                    const char* datos = bloque + inicio;
+                    int tam = (int)(salto - datos);
+                    inicio += tam + 1;
+                    if (descartando) {
+                        descartando = false;
+                        continue;
+                    }
+                    if (tam > EnsambladorLineas::CAPACIDAD) continue;
+                    tomarLinea(datos, tam);
+                    return true;
+                }
+            }
+
+            if (agotado) {
+                // Ultima linea sin '\n'
+                if (inicio < fin && !descartando && fin - inicio <= EnsambladorLineas::CAPACIDAD) {
+                    tomarLinea(bloque + inicio, fin - inicio);
+                    inicio = fin;
+                    return true;
+                }
+                return false;
+            }
+
+            // Mover el trozo de linea al frente y completar el bloque
+            int resto = fin - inicio;
+            if (descartando) {
+                resto = 0;
+            } else if (resto > EnsambladorLineas::CAPACIDAD) {
+                descartando = true;
+                resto = 0;
+            }
+            std::memmove(bloque, bloque + inicio, resto);
+            inicio = 0;
+            fin = resto;
+            size_t leidos = std::fread(bloque + fin, 1, (size_t)(MezcladorCapturas::TAM_BLOQUE - fin), archivo);
+            if (leidos == 0) agotado = true;
+            fin += (int)leidos;
+        }
+    }
+
+    void escribir(const char* datos, int tam) override {
+        destino->escribir(numero, decodificador.getMarcaTiempo(), datos, tam);
+        conTexto = true;
+    }
+
+    void finMensaje() override {
+        destino->finMensaje(numero, decodificador.getMarcaTiempo(), !conTexto);
+        conTexto = false;
+    }
+};
+
+void SalidaLineaTiempoConsola::escribir(int flujo, long long marca, const char* datos, int longitud) {
+    std::cout << '@' << marca << " [" << (flujo + 1) << "] ";
+    std::cout.write(datos, longitud);
+    std::cout << '\n';
+}
+
+void SalidaLineaTiempoConsola::finMensaje(int flujo, long long marca, bool vacio) {
+    if (vacio) {
+        std::cout << '@' << marca << " [" << (flujo + 1) << "] \n";
+    }
+}
+
+MezcladorCapturas::MezcladorCapturas()
+    : flujos(nullptr), cantidad(0), capacidad(0), monticulo(nullptr), enMonticulo(0),
+      ventana(4096), lote(4096), delimitador('\0'), salida(nullptr), lineas(0), tramas(0),
+      desordenadas(0) {
+}
+
+MezcladorCapturas::~MezcladorCapturas() {
+    for (int i = 0; i < cantidad; i++) {
+        delete flujos[i];
+    }
+    delete[] flujos;
+    delete[] monticulo;
+}
+
+void MezcladorCapturas::configurarSesiones(int ventanaN, int loteN, char delim) {
+    ventana = (ventanaN > 0) ? ventanaN : 4096;
+    lote = (loteN > 0) ? loteN : 4096;
+    delimitador = delim;
+}
+
+void MezcladorCapturas::configurarSalida(SalidaLineaTiempo* destino) {
+    salida = destino;
+}
+
+int MezcladorCapturas::agregar(const char* ruta) {
+    std::FILE* archivo = std::fopen(ruta, "rb");
+    if (archivo == nullptr) return -1;
+    // Se lee en bloques propios: el buffer de stdio solo duplicaria la copia
+    std::setvbuf(archivo, nullptr, _IONBF, 0);
+
+    if (cantidad == capacidad) {
+        int nuevaCapacidad = (capacidad == 0) ? 16 : capacidad * 2;
+        FlujoCaptura** nuevos = new FlujoCaptura*[nuevaCapacidad];
+        for (int i = 0; i < cantidad; i++) nuevos[i] = flujos[i];
+        delete[] flujos;
+        delete[] monticulo;
+        flujos = nuevos;
+        monticulo = new EntradaMonticulo[nuevaCapacidad];
+        capacidad = nuevaCapacidad;
+    }
+
+    FlujoCaptura* flujo = new FlujoCaptura();
+    flujo->archivo = archivo;
+    flujo->numero = cantidad;
+    flujo->destino = salida;
+    flujo->decodificador.inicializar();
+    flujo->decodificador.configurarVentana(flujo, ventana, lote);
+    flujo->decodificador.configurarSegmentacion(delimitador, 0);
+    flujos[cantidad] = flujo;
+    return cantidad++;
+}
+
+bool MezcladorCapturas::precede(const EntradaMonticulo& a, const EntradaMonticulo& b) {
+    return a.marca < b.marca || (a.marca == b.marca && a.captura < b.captura);
+}
+
+void MezcladorCapturas::hundir(int posicion) {
+    EntradaMonticulo entrada = monticulo[posicion];
+    for (;;) {
+        int hija = 2 * posicion + 1;
+        if (hija >= enMonticulo) break;
+        if (hija + 1 < enMonticulo && precede(monticulo[hija + 1], monticulo[hija])) hija++;
+        if (!precede(monticulo[hija], entrada)) break;
+        monticulo[posicion] = monticulo[hija];
+        posicion = hija;
+    }
+    monticulo[posicion] = entrada;
+}
+
+void MezcladorCapturas::ejecutar() {
+    if (salida == nullptr) return;
+
+    enMonticulo = 0;
+    for (int i = 0; i < cantidad; i++) {
+        flujos[i]->destino = salida;
+        if (flujos[i]->avanzar()) {
+            if (flujos[i]->retrocedio) desordenadas++;
+            monticulo[enMonticulo].marca = flujos[i]->marca;
+            monticulo[enMonticulo].captura = i;
+            enMonticulo++;
+        } else {
+            flujos[i]->decodificador.finalizar();
+            flujos[i]->cerrar();
+        }
+    }
+    for (int p = enMonticulo / 2 - 1; p >= 0; p--) {
+        hundir(p);
+    }
+
+    while (enMonticulo > 0) {
+        EntradaMonticulo& cima = monticulo[0];
+        FlujoCaptura* flujo = flujos[cima.captura];
+
+        // La menor de las hijas: hasta ella se procesa sin tocar el monticulo
+        EntradaMonticulo rival = {0, -1};
+        if (enMonticulo > 1) rival = monticulo[1];
+        if (enMonticulo > 2 && precede(monticulo[2], monticulo[1])) rival = monticulo[2];
+
+        bool quedan;
+        do {
+            lineas++;
+            if (flujo->decodificador.procesarLinea(flujo->linea, flujo->longitud)) tramas++;
+            quedan = flujo->avanzar();
+            if (quedan && flujo->retrocedio) desordenadas++;
+            cima.marca = flujo->marca;
+        } while (quedan && (rival.captura < 0 || precede(cima, rival)));
+
+        if (!quedan) {
+            // Su ultimo mensaje sale ahora, en su lugar de la linea de tiempo
+            flujo->decodificador.finalizar();
+            flujo->cerrar();
+            monticulo[0] = monticulo[--enMonticulo];
+        }
+        if (enMonticulo > 0) hundir(0);
+    }
+}
+
+int MezcladorCapturas::getCapturas() const {
+    return cantidad;
+}
+
+long long MezcladorCapturas::getLineas() const {
+    return lineas;
+}
+
+long long MezcladorCapturas::getTramas() const {
+    return tramas;
+}
+
+long long MezcladorCapturas::getDesordenadas() const {
+    return desordenadas;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file PerfilMemoria.cpp
+ * @brief Implementacion de los contadores de PerfilMemoria
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/PerfilMemoria.h"
+
+#ifdef PRT7_PERFIL_MEMORIA
+
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+
+/**
+ * @struct CeldaPerfil
+ * @brief Contadores de una clase de trama en una fase
+ */
+struct CeldaPerfil {
+    std::atomic<long long> asignaciones;
+    std::atomic<long long> liberaciones;
+    std::atomic<long long> bytes;
+};
+
+/**
+ * @struct AcumuladoTrama
+ * @brief Contadores de la trama abierta en una fase (solo los toca su hilo)
+ */
+struct AcumuladoTrama {
+    long long asignaciones;
+    long long liberaciones;
+    long long bytes;
+};
+
+// Estado global: inicializado a cero antes de cualquier new
+static CeldaPerfil tabla[PerfilMemoria::NUM_CLASES][PerfilMemoria::NUM_FASES];
+static std::atomic<long long> tramas[PerfilMemoria::NUM_CLASES];
+static std::atomic<long long> totalAsignaciones;
+static std::atomic<long long> bytesVivos;
+static std::atomic<long long> picoBytes;
+static std::atomic<long long> tramasReportadas(0);
+
+// Estado de cada hilo
+static thread_local PerfilMemoria::Fase faseActual = PerfilMemoria::FUERA;
+static thread_local bool tramaAbierta = false;
+static thread_local PerfilMemoria::Clase claseAbierta = PerfilMemoria::RECHAZADA;
+static thread_local AcumuladoTrama acumulado[PerfilMemoria::NUM_FASES];
+
+static const char* NOMBRES_CLASE[PerfilMemoria::NUM_CLASES] = {
+    "L", "L*n", "M", "F", "rechazada", "sin trama"
+};
+static const char* NOMBRES_FASE[PerfilMemoria::NUM_FASES] = {
+    "fuera", "parseo", "proceso", "almacen", "reinicio"
+};
+
+void PerfilMemoria::registrarAsignacion(std::size_t bytes) {
+    totalAsignaciones.fetch_add(1, std::memory_order_relaxed);
+    long long vivos = bytesVivos.fetch_add((long long)bytes, std::memory_order_relaxed) + (long long)bytes;
+    long long pico = picoBytes.load(std::memory_order_relaxed);
+    while (vivos > pico && !picoBytes.compare_exchange_weak(pico, vivos, std::memory_order_relaxed)) {
+    }
+
+    if (tramaAbierta) {
+        acumulado[faseActual].asignaciones++;
+        acumulado[faseActual].bytes += (long long)bytes;
+    } else {
+        CeldaPerfil& celda = tabla[SIN_TRAMA][faseActual];
+        celda.asignaciones.fetch_add(1, std::memory_order_relaxed);
+        celda.bytes.fetch_add((long long)bytes, std::memory_order_relaxed);
+    }
+}
+
+void PerfilMemoria::registrarLiberacion(std::size_t bytes) {
+    bytesVivos.fetch_sub((long long)bytes, std::memory_order_relaxed);
+    if (tramaAbierta) {
+        acumulado[faseActual].liberaciones++;
+    } else {
+        tabla[SIN_TRAMA][faseActual].liberaciones.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+PerfilMemoria::Fase PerfilMemoria::entrarFase(Fase fase) {
+    Fase anterior = faseActual;
+    // Lo que se libera al reiniciar cuenta como reinicio aunque pase por la lista
+    if (anterior != REINICIO) faseActual = fase;
+    return anterior;
+}
+
+void PerfilMemoria::salirFase(Fase anterior) {
+    faseActual = anterior;
+}
+
+void PerfilMemoria::abrirTrama() {
+    if (tramaAbierta) cerrarTrama();
+    tramaAbierta = true;
+    claseAbierta = RECHAZADA;
+}
+
+void PerfilMemoria::tipoTrama(char tipo) {
+    switch (tipo) {
+        case 'L': claseAbierta = CARGA; break;
+        case 'B': claseAbierta = LOTE; break;
+        case 'M': claseAbierta = MAPEO; break;
+        case 'F': claseAbierta = FIN; break;
+        default: claseAbierta = RECHAZADA; break;
+    }
+}
+
+void PerfilMemoria::cerrarTrama() {
+    if (!tramaAbierta) return;
+    tramaAbierta = false;
+    for (int f = 0; f < NUM_FASES; f++) {
+        if (acumulado[f].asignaciones != 0 || acumulado[f].liberaciones != 0) {
+            CeldaPerfil& celda = tabla[claseAbierta][f];
+            celda.asignaciones.fetch_add(acumulado[f].asignaciones, std::memory_order_relaxed);
+            celda.liberaciones.fetch_add(acumulado[f].liberaciones, std::memory_order_relaxed);
+            celda.bytes.fetch_add(acumulado[f].bytes, std::memory_order_relaxed);
+            acumulado[f].asignaciones = 0;
+            acumulado[f].liberaciones = 0;
+            acumulado[f].bytes = 0;
+        }
+    }
+    tramas[claseAbierta].fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerfilMemoria::reportar() {
+    long long totalTramas = 0;
+    for (int c = 0; c < SIN_TRAMA; c++) totalTramas += tramas[c].load(std::memory_order_relaxed);
+    // Varios decodificadores que terminan juntos imprimen un solo desglose:
+    // solo el hilo que cambia el valor anotado lo imprime
+    long long anotadas = tramasReportadas.load(std::memory_order_relaxed);
+    do {
+        if (anotadas == totalTramas) return;
+    } while (!tramasReportadas.compare_exchange_weak(anotadas, totalTramas, std::memory_order_relaxed));
+
+    char linea[160];
+    std::snprintf(linea, sizeof(linea),
+                  "Perfil de memoria: %lld asignaciones, %lld bytes vivos, pico %lld bytes, %lld tramas\n",
+                  totalAsignaciones.load(std::memory_order_relaxed), bytesVivos.load(std::memory_order_relaxed),
+                  picoBytes.load(std::memory_order_relaxed), totalTramas);
+    std::cerr << linea;
+    std::snprintf(linea, sizeof(linea), "  %-10s %10s  %-8s %12s %12s %12s\n",
+                  "trama", "cantidad", "fase", "asig/trama", "lib/trama", "bytes/trama");
+    std::cerr << linea;
+
+    for (int c = 0; c < NUM_CLASES; c++) {
+        long long n = tramas[c].load(std::memory_order_relaxed);
+        bool impresa = false;
+        for (int f = 0; f < NUM_FASES; f++) {
+            long long asignaciones = tabla[c][f].asignaciones.load(std::memory_order_relaxed);
+            long long liberaciones = tabla[c][f].liberaciones.load(std::memory_order_relaxed);
+            long long bytes = tabla[c][f].bytes.load(std::memory_order_relaxed);
+            if (asignaciones == 0 && liberaciones == 0) continue;
+            if (c == SIN_TRAMA) {
+                // Sin trama no hay por que dividir: se muestran los totales
+                std::snprintf(linea, sizeof(linea), "  %-10s %10s  %-8s %12lld %12lld %12lld\n",
+                              NOMBRES_CLASE[c], "-", NOMBRES_FASE[f], asignaciones, liberaciones, bytes);
+            } else {
+                std::snprintf(linea, sizeof(linea), "  %-10s %10lld  %-8s %12.3f %12.3f %12.1f\n",
+                              NOMBRES_CLASE[c], n, NOMBRES_FASE[f], (double)asignaciones / (double)n,
+                              (double)liberaciones / (double)n, (double)bytes / (double)n);
+            }
+            std::cerr << linea;
+            impresa = true;
+        }
+        if (!impresa && n > 0) {
+            std::snprintf(linea, sizeof(linea), "  %-10s %10lld  %-8s %12.3f %12.3f %12.1f\n",
+                          NOMBRES_CLASE[c], n, "-", 0.0, 0.0, 0.0);
+            std::cerr << linea;
+        }
+    }
+}
+
+long long PerfilMemoria::getAsignaciones() {
+    return totalAsignaciones.load(std::memory_order_relaxed);
+}
+
+long long PerfilMemoria::getPicoBytes() {
+    return picoBytes.load(std::memory_order_relaxed);
+}
+
+#endif // PRT7_PERFIL_MEMORIA
@@ -0,0 +1,65 @@
+/**
+ * @file PerfilMemoriaOperadores.cpp
+ * @brief Reemplazo global de operator new/delete que alimenta PerfilMemoria
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ *
+ * Va aparte de PerfilMemoria.cpp porque solo se enlaza en la biblioteca
+ * estatica: en la compartida cambiaria el asignador de todo el proceso
+ * que la cargue.
+ */
+
+#include "../include/PerfilMemoria.h"
+
+#ifdef PRT7_PERFIL_MEMORIA
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/*
+ * Reemplazo global de operator new/delete. Cada bloque lleva delante su
+ * tamanio para poder descontarlo al liberarlo; la cabecera ocupa un
+ * alineamiento completo para no cambiar el de los datos.
+ */
+
+static const std::size_t CABECERA = alignof(std::max_align_t);
+
+static void* asignar(std::size_t tam) {
+    void* bloque = std::malloc(tam + CABECERA);
+    if (bloque == nullptr) return nullptr;
+    *(std::size_t*)bloque = tam;
+    PerfilMemoria::registrarAsignacion(tam);
+    return (char*)bloque + CABECERA;
+}
+
+static void liberar(void* p) {
+    if (p == nullptr) return;
+    void* bloque = (char*)p - CABECERA;
+    PerfilMemoria::registrarLiberacion(*(std::size_t*)bloque);
+    std::free(bloque);
+}
+
+void* operator new(std::size_t tam) {
+    void* p = asignar(tam);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t tam) {
+    void* p = asignar(tam);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t tam, const std::nothrow_t&) noexcept { return asignar(tam); }
+void* operator new[](std::size_t tam, const std::nothrow_t&) noexcept { return asignar(tam); }
+
+void operator delete(void* p) noexcept { liberar(p); }
+void operator delete[](void* p) noexcept { liberar(p); }
+void operator delete(void* p, std::size_t) noexcept { liberar(p); }
+void operator delete[](void* p, std::size_t) noexcept { liberar(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { liberar(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { liberar(p); }
+
+#endif // PRT7_PERFIL_MEMORIA
@@ -6,6 +6,7 @@
  */
 
 #include "../include/RotorDeMapeo.h"
+#include "../include/SondasPRT7.h"
 #include <iostream>
 
 RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(26) {
@@ -15,7 +16,12 @@ RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(26) {
     
     for (int i = 0; i < 26; i++) {
         char caracter = 'A' + i;
+#ifdef PRT7_SIN_HEAP
+        NodoRotor* nuevo = &nodos[i];
+        nuevo->dato = caracter;
+#else
         NodoRotor* nuevo = new NodoRotor(caracter);
+#endif
         
         if (primero == nullptr) {
             // Primer nodo
@@ -38,6 +44,7 @@ RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(26) {
 }
 
 RotorDeMapeo::~RotorDeMapeo() {
+#ifndef PRT7_SIN_HEAP
     if (cabeza == nullptr) return;
     
     // Romper el circulo temporalmente
@@ -51,10 +58,12 @@ RotorDeMapeo::~RotorDeMapeo() {
         delete actual;
         actual = siguiente;
     }
+#endif
 }
 
 void RotorDeMapeo::rotar(int posiciones) {
     if (cabeza == nullptr || posiciones == 0) return;
+    int pedidas = posiciones;
     
     // Normalizar las posiciones al rango [0, 25]
     posiciones = posiciones % tamanio;
@@ -66,6 +75,8 @@ void RotorDeMapeo::rotar(int posiciones) {
     for (int i = 0; i < posiciones; i++) {
         cabeza = cabeza->siguiente;
     }
+    PRT7_SONDA_ROTOR_ROTADO(pedidas, getDesplazamiento());
+    (void)pedidas;
 }
 
 NodoRotor* RotorDeMapeo::buscarNodo(char c) {
@@ -101,6 +112,21 @@ char RotorDeMapeo::getMapeo(char caracterEntrada) {
     return (actual != nullptr) ? actual->dato : caracterEntrada;
 }
 
+void RotorDeMapeo::mapearBloque(const char* origen, int longitud, char* destino) {
+    // Tabla de la rotacion actual: posicion original -> caracter en el rotor
+    char tabla[26];
+    NodoRotor* actual = cabeza;
+    for (int i = 0; i < 26; i++) {
+        tabla[i] = (actual != nullptr) ? actual->dato : (char)('A' + i);
+        if (actual != nullptr) actual = actual->siguiente;
+    }
+    
+    for (int i = 0; i < longitud; i++) {
+        char c = origen[i];
+        destino[i] = (c >= 'A' && c <= 'Z') ? tabla[c - 'A'] : c;
+    }
+}
+
 void RotorDeMapeo::mostrarEstado() {
     if (cabeza == nullptr) {
         std::cout << "Rotor vacio" << std::endl;
@@ -120,4 +146,8 @@ void RotorDeMapeo::mostrarEstado() {
 
 char RotorDeMapeo::getCabeza() {
     return (cabeza != nullptr) ? cabeza->dato : '\0';
-}
\ No newline at end of file
+}
+
+int RotorDeMapeo::getDesplazamiento() const {
+    return (cabeza != nullptr) ? cabeza->dato - 'A' : 0;
+}
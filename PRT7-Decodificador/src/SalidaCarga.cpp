@@ -0,0 +1,23 @@
+/**
+ * @file SalidaCarga.cpp
+ * @brief Implementacion de las salidas de carga
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/SalidaCarga.h"
+#include "../include/TrazadorPRT7.h"
+#include <iostream>
+
+void SalidaConsola::escribir(const char* datos, int longitud) {
+    if (datos == nullptr || longitud <= 0) return;
+    TramoTraza tramo("salida");
+    std::cout.write(datos, longitud);
+    std::cout.flush();
+}
+
+void SalidaConsola::finMensaje() {
+    TramoTraza tramo("salida");
+    std::cout << '\n';
+    std::cout.flush();
+}
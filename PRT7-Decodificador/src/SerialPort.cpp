@@ -3,19 +3,137 @@
  */
 
 #include "../include/SerialPort.h"
+#include "../include/TrazadorPRT7.h"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstring>
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+#endif
+
+/**
+ * @struct ColaRecepcion
+ * @brief Bytes que el hilo lector ya saco del puerto y leer() aun no entrega
+ */
+struct ColaRecepcion {
+    char* datos;                     ///< Buffer circular
+    int capacidad;                   ///< Tamanio del buffer
+    int inicio;                      ///< Primer byte pendiente
+    int ocupados;                    ///< Bytes pendientes
+    std::atomic<int> disponibles;    ///< Copia de ocupados para sondear sin el candado
+    int ocupacionMaxima;             ///< Mayor valor de ocupados
+    bool pausado;                    ///< Se pidio al emisor que pare
+    bool terminar;                   ///< El hilo debe salir
+    bool error;                      ///< El puerto fallo
+    long long pausas;                ///< Veces que se pauso al emisor
+    long long perdidos;              ///< Bytes descartados con la cola llena
+    std::mutex candado;              ///< Protege todos los campos
+    std::condition_variable hayDatos; ///< Avisa a leer() que llegaron bytes
+    std::thread hilo;                ///< Hilo que ejecuta SerialPort::recibir
+
+    explicit ColaRecepcion(int cap)
+        : datos(new char[cap]), capacidad(cap), inicio(0), ocupados(0), disponibles(0), ocupacionMaxima(0),
+          pausado(false), terminar(false), error(false), pausas(0), perdidos(0) {}
+
+    ~ColaRecepcion() { delete[] datos; }
+};
+
+/**
+ * @brief Vueltas de sondeo sin datos antes de empezar a ceder el procesador
+ *
+ * Unos microsegundos girando con la instruccion de pausa; despues cada
+ * vuelta hace yield, que en un nucleo dedicado vuelve enseguida y en uno
+ * compartido deja avanzar al otro hilo (emisor, lector o decodificador).
+ */
+static const int VUELTAS_SIN_CEDER = 256;
+
+/**
+ * @brief Pausa de un hilo de tiempo real que agoto sus vueltas de giro
+ *
+ * Con SCHED_FIFO, yield solo cede a hilos de tiempo real de igual
+ * prioridad: los SCHED_OTHER del mismo nucleo (el emisor, el otro hilo
+ * del decodificador, los del kernel) no avanzarian nunca. Dormir un poco
+ * si los deja correr, a costa de esta latencia extra cuando el puerto
+ * estuvo callado.
+ */
+static const int PAUSA_TIEMPO_REAL_US = 50;
+
+/// El hilo actual corre con SCHED_FIFO (o TIME_CRITICAL) por fijarHiloActual
+static thread_local bool hiloTiempoReal = false;
+
+/**
+ * @brief Una vuelta de espera activa
+ * @param vueltas Vueltas seguidas sin datos (se incrementa)
+ */
+static inline void esperaActiva(int& vueltas) {
+    if (++vueltas < VUELTAS_SIN_CEDER) {
+#if defined(_WIN32)
+        YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    } else if (hiloTiempoReal) {
+        std::this_thread::sleep_for(std::chrono::microseconds(PAUSA_TIEMPO_REAL_US));
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+#ifndef _WIN32
+/**
+ * @brief Convierte baudios a la constante de termios (B9600 si no se conoce)
+ */
+static speed_t velocidadTermios(unsigned long baud) {
+    switch (baud) {
+        case 1200: return B1200;
+        case 2400: return B2400;
+        case 4800: return B4800;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+#ifdef B460800
+        case 460800: return B460800;
+#endif
+#ifdef B921600
+        case 921600: return B921600;
+#endif
+        default: return B9600;
+    }
+}
+#endif
 
 SerialPort::SerialPort()
 #ifdef _WIN32
-    : handle(INVALID_HANDLE_VALUE)
+    : handle(INVALID_HANDLE_VALUE), abierto(false), control(SIN_CONTROL), cola(nullptr),
+      bajaLatencia(false), nucleoLector(-1), tiempoReal(false) {}
+#else
+    : fd(-1), abierto(false), control(SIN_CONTROL), cola(nullptr),
+      bajaLatencia(false), nucleoLector(-1), tiempoReal(false) {}
 #endif
-    , abierto(false) {}
 
 SerialPort::~SerialPort() { cerrar(); }
 
-bool SerialPort::abrir(const char* puerto, unsigned long baud) {
-#ifdef _WIN32
+bool SerialPort::abrir(const char* puerto, unsigned long baud, ControlFlujo controlFlujo) {
     if (abierto) cerrar();
-
+    control = controlFlujo;
+    bajaLatencia = false;
+#ifdef _WIN32
     // Construir ruta estilo \\.\COM3
     char ruta[64];
     int i = 0;
@@ -59,10 +177,16 @@ bool SerialPort::abrir(const char* puerto, unsigned long baud) {
     dcb.Parity   = NOPARITY;
     dcb.StopBits = ONESTOPBIT;
     dcb.fParity = FALSE;
-    dcb.fOutxCtsFlow = FALSE;
     dcb.fOutxDsrFlow = FALSE;
     dcb.fDtrControl = DTR_CONTROL_ENABLE;
+    // RTS y XOFF se manejan a mano segun la cola (pausarEmisor); el
+    // controlador solo respeta el control de flujo del otro extremo
     dcb.fRtsControl = RTS_CONTROL_ENABLE;
+    dcb.fOutxCtsFlow = (control == RTS_CTS) ? TRUE : FALSE;
+    dcb.fOutX = (control == XON_XOFF) ? TRUE : FALSE;
+    dcb.fInX = FALSE;
+    dcb.XonChar = 0x11;
+    dcb.XoffChar = 0x13;
 
     if (!SetCommState(handle, &dcb)) { cerrar(); return false; }
 
@@ -72,69 +196,388 @@ bool SerialPort::abrir(const char* puerto, unsigned long baud) {
     abierto = true;
     return true;
 #else
-    (void)puerto; (void)baud;
-    return false;
+    fd = ::open(puerto, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        return false;
+    }
+
+    termios opciones;
+    if (tcgetattr(fd, &opciones) != 0) { ::close(fd); fd = -1; return false; }
+    cfmakeraw(&opciones);
+    cfsetispeed(&opciones, velocidadTermios(baud));
+    cfsetospeed(&opciones, velocidadTermios(baud));
+    opciones.c_cflag |= CLOCAL | CREAD;
+    // Timeout de lectura de 100 ms, como en Windows
+    opciones.c_cc[VMIN] = 0;
+    opciones.c_cc[VTIME] = 1;
+    // IXOFF no se activa: el XOFF lo decide la cola, no el buffer del kernel
+    opciones.c_iflag &= ~(IXON | IXOFF | IXANY);
+    if (control == XON_XOFF) opciones.c_iflag |= IXON;
+#ifdef CRTSCTS
+    if (control == RTS_CTS) {
+        opciones.c_cflag |= CRTSCTS;
+    } else {
+        opciones.c_cflag &= ~CRTSCTS;
+    }
+#endif
+    if (tcsetattr(fd, TCSANOW, &opciones) != 0) { ::close(fd); fd = -1; return false; }
+
+    // Purga inicial
+    tcflush(fd, TCIOFLUSH);
+
+    abierto = true;
+    if (control == RTS_CTS) reanudarEmisor();
+    return true;
 #endif
 }
 
-int SerialPort::leerLinea(char* buffer, int maxLen) {
+bool SerialPort::configurarBajaLatencia(int nucleo, bool tiempoRealLector) {
+    if (!abierto || cola != nullptr) return false;
 #ifdef _WIN32
-    if (!abierto || buffer == 0 || maxLen <= 1) return -1;
+    // MAXDWORD/0/0: ReadFile devuelve lo que haya en el buffer, aunque sea nada
+    COMMTIMEOUTS timeouts;
+    timeouts.ReadIntervalTimeout = MAXDWORD;
+    timeouts.ReadTotalTimeoutMultiplier = 0;
+    timeouts.ReadTotalTimeoutConstant = 0;
+    timeouts.WriteTotalTimeoutMultiplier = 10;
+    timeouts.WriteTotalTimeoutConstant = 100;
+    if (!SetCommTimeouts(handle, &timeouts)) return false;
+#else
+    termios opciones;
+    if (tcgetattr(fd, &opciones) != 0) return false;
+    opciones.c_cc[VMIN] = 0;
+    opciones.c_cc[VTIME] = 0;
+    if (tcsetattr(fd, TCSANOW, &opciones) != 0) return false;
+    int banderas = fcntl(fd, F_GETFL);
+    if (banderas < 0 || fcntl(fd, F_SETFL, banderas | O_NONBLOCK) != 0) return false;
+#if defined(__linux__) && defined(ASYNC_LOW_LATENCY)
+    // Solo lo entienden algunos controladores (8250, ftdi_sio); un pty no
+    serial_struct serie;
+    if (ioctl(fd, TIOCGSERIAL, &serie) == 0) {
+        serie.flags |= ASYNC_LOW_LATENCY;
+        ioctl(fd, TIOCSSERIAL, &serie);
+    }
+#endif
+#endif
+    bajaLatencia = true;
+    nucleoLector = nucleo;
+    tiempoReal = tiempoRealLector;
+    return true;
+}
 
-    int count = 0;
-    char ch;
-    DWORD bytes = 0;
+bool SerialPort::fijarHiloActual(int nucleo, bool tiempoReal, EstadoHilo* anterior) {
+    bool ok = true;
+    if (anterior != nullptr) {
+        std::memset(anterior, 0, sizeof(*anterior));
+        anterior->guardado = true;
+    }
+#ifdef _WIN32
+    if (anterior != nullptr) {
+        anterior->prioridad = GetThreadPriority(GetCurrentThread());
+        if (anterior->prioridad == THREAD_PRIORITY_ERROR_RETURN) anterior->guardado = false;
+    }
+    if (nucleo >= 0) {
+        DWORD_PTR previa = 0;
+        if (nucleo >= (int)(sizeof(DWORD_PTR) * 8) ||
+            (previa = SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << nucleo)) == 0) ok = false;
+        if (anterior != nullptr) anterior->nucleos[0] = (unsigned long long)previa;
+    }
+    if (tiempoReal) {
+        if (SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+            hiloTiempoReal = true;
+        } else {
+            ok = false;
+        }
+    }
+#else
+#ifdef __linux__
+    static_assert(sizeof(cpu_set_t) <= sizeof(EstadoHilo::nucleos), "EstadoHilo::nucleos no aloja cpu_set_t");
+    if (anterior != nullptr) {
+        cpu_set_t actuales;
+        if (pthread_getaffinity_np(pthread_self(), sizeof(actuales), &actuales) == 0) {
+            std::memcpy(anterior->nucleos, &actuales, sizeof(actuales));
+        } else {
+            anterior->guardado = false;
+        }
+    }
+    if (nucleo >= 0) {
+        if (nucleo >= CPU_SETSIZE) return false;
+        cpu_set_t nucleos;
+        CPU_ZERO(&nucleos);
+        CPU_SET(nucleo, &nucleos);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(nucleos), &nucleos) != 0) ok = false;
+    }
+#else
+    // Sin afinidad portable fuera de Linux: solo se aplica la prioridad
+    if (nucleo >= 0) ok = false;
+#endif
+    if (anterior != nullptr) {
+        sched_param parametro;
+        if (pthread_getschedparam(pthread_self(), &anterior->politica, &parametro) == 0) {
+            anterior->prioridad = parametro.sched_priority;
+        } else {
+            anterior->guardado = false;
+        }
+    }
+    if (tiempoReal) {
+        // Prioridad intermedia: por encima de todo SCHED_OTHER, por debajo
+        // de los hilos de interrupcion del kernel (50 en PREEMPT_RT)
+        sched_param parametro;
+        parametro.sched_priority = 40;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &parametro) == 0) {
+            hiloTiempoReal = true;
+        } else {
+            ok = false;
+        }
+    }
+#endif
+    return ok;
+}
+
+void SerialPort::restaurarHiloActual(const EstadoHilo& anterior) {
+    if (!anterior.guardado) return;
+#ifdef _WIN32
+    if (anterior.nucleos[0] != 0) SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)anterior.nucleos[0]);
+    SetThreadPriority(GetCurrentThread(), anterior.prioridad);
+    hiloTiempoReal = (anterior.prioridad == THREAD_PRIORITY_TIME_CRITICAL);
+#else
+#ifdef __linux__
+    cpu_set_t nucleos;
+    std::memcpy(&nucleos, anterior.nucleos, sizeof(nucleos));
+    pthread_setaffinity_np(pthread_self(), sizeof(nucleos), &nucleos);
+#endif
+    sched_param parametro;
+    parametro.sched_priority = anterior.prioridad;
+    pthread_setschedparam(pthread_self(), anterior.politica, &parametro);
+    hiloTiempoReal = (anterior.politica == SCHED_FIFO || anterior.politica == SCHED_RR);
+#endif
+}
+
+bool SerialPort::iniciarRecepcion(int capacidad) {
+    if (!abierto || cola != nullptr || capacidad < 16) return false;
+    cola = new ColaRecepcion(capacidad);
+    cola->hilo = std::thread(&SerialPort::recibir, this);
+    return true;
+}
 
-    while (count < maxLen - 1) {
-        if (!ReadFile(handle, &ch, 1, &bytes, 0)) {
-            return -1; // error
+void SerialPort::recibir() {
+    char bloque[4096];
+    int alto = cola->capacidad - cola->capacidad / 4;
+    // Un fallo aqui no es fatal: el hilo sigue, solo que sin fijar
+    if (bajaLatencia) fijarHiloActual(nucleoLector, tiempoReal);
+    int vueltas = 0;
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> g(cola->candado);
+            if (cola->terminar) return;
         }
-        if (bytes == 0) {
-            // timeout sin datos
-            return 0;
+        int n = leerPuerto(bloque, sizeof(bloque));
+        if (n == 0 && bajaLatencia) {
+            esperaActiva(vueltas);
+            continue;
         }
-        if (ch == '\n') {
-            break;
+        vueltas = 0;
+
+        std::lock_guard<std::mutex> g(cola->candado);
+        if (n < 0) {
+            cola->error = true;
+            cola->hayDatos.notify_one();
+            return;
         }
-        if (ch != '\r') {
-            buffer[count++] = ch;
+        if (n == 0) continue;
+
+        // Copiar al buffer circular; lo que no cabe se descarta
+        int libres = cola->capacidad - cola->ocupados;
+        int copiar = (n < libres) ? n : libres;
+        cola->perdidos += n - copiar;
+        int fin = (cola->inicio + cola->ocupados) % cola->capacidad;
+        for (int i = 0; i < copiar; i++) {
+            cola->datos[fin] = bloque[i];
+            if (++fin == cola->capacidad) fin = 0;
         }
+        cola->ocupados += copiar;
+        cola->disponibles.store(cola->ocupados, std::memory_order_release);
+        if (cola->ocupados > cola->ocupacionMaxima) cola->ocupacionMaxima = cola->ocupados;
+
+        if (!cola->pausado && cola->ocupados >= alto && control != SIN_CONTROL) {
+            cola->pausado = true;
+            cola->pausas++;
+            pausarEmisor();
+        }
+        if (!bajaLatencia) cola->hayDatos.notify_one();
+    }
+}
+
+int SerialPort::leer(char* buffer, int maxLen) {
+    TramoTraza tramo("SerialPort::leer");
+    if (cola == nullptr) {
+        return leerPuerto(buffer, maxLen);
     }
-    buffer[count] = '\0';
-    return count;
+    if (!abierto || buffer == 0 || maxLen <= 0) return -1;
+
+    if (bajaLatencia) {
+        // Sondear el contador sin tomar el candado; el reloj se consulta
+        // cada 1024 vueltas para devolver 0 tras 1 ms sin datos
+        std::chrono::steady_clock::time_point limite =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+        int vueltas = 0;
+        for (int i = 1; cola->disponibles.load(std::memory_order_acquire) == 0; i++) {
+            if ((i & 1023) == 0) {
+                std::lock_guard<std::mutex> g(cola->candado);
+                if (cola->error) return -1;
+                if (std::chrono::steady_clock::now() >= limite) return 0;
+            }
+            esperaActiva(vueltas);
+        }
+    }
+
+    std::unique_lock<std::mutex> g(cola->candado);
+    if (cola->ocupados == 0 && !cola->error && !bajaLatencia) {
+        cola->hayDatos.wait_for(g, std::chrono::milliseconds(100));
+    }
+    if (cola->ocupados == 0) {
+        return cola->error ? -1 : 0;
+    }
+
+    int n = (maxLen < cola->ocupados) ? maxLen : cola->ocupados;
+    for (int i = 0; i < n; i++) {
+        buffer[i] = cola->datos[cola->inicio];
+        if (++cola->inicio == cola->capacidad) cola->inicio = 0;
+    }
+    cola->ocupados -= n;
+    cola->disponibles.store(cola->ocupados, std::memory_order_release);
+
+    if (cola->pausado && cola->ocupados <= cola->capacidad / 4) {
+        cola->pausado = false;
+        reanudarEmisor();
+    }
+    return n;
+}
+
+int SerialPort::leerPuerto(char* buffer, int maxLen) {
+    if (!abierto || buffer == 0 || maxLen <= 0) return -1;
+#ifdef _WIN32
+    // ReadFile vuelve al llenar el buffer o tras ReadIntervalTimeout sin
+    // bytes; en baja latencia, inmediatamente
+    DWORD bytes = 0;
+    if (!ReadFile(handle, buffer, (DWORD)maxLen, &bytes, 0)) {
+        return -1; // error
+    }
+    return (int)bytes;
 #else
-    (void)buffer; (void)maxLen;
-    return -1;
+    ssize_t n = ::read(fd, buffer, (size_t)maxLen);
+    if (n < 0) {
+        // Descriptor no bloqueante (baja latencia) sin bytes
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return 0;
+        return -1;
+    }
+    return (int)n;
 #endif
 }
 
+bool SerialPort::pausarEmisor() {
+    if (!abierto) return false;
+#ifdef _WIN32
+    if (control == XON_XOFF) return TransmitCommChar(handle, 0x13) != 0;
+    if (control == RTS_CTS) return EscapeCommFunction(handle, CLRRTS) != 0;
+    return false;
+#else
+    if (control == XON_XOFF) return tcflow(fd, TCIOFF) == 0;
+    if (control == RTS_CTS) {
+        int lineas = TIOCM_RTS;
+        return ioctl(fd, TIOCMBIC, &lineas) == 0;
+    }
+    return false;
+#endif
+}
+
+bool SerialPort::reanudarEmisor() {
+    if (!abierto) return false;
+#ifdef _WIN32
+    if (control == XON_XOFF) return TransmitCommChar(handle, 0x11) != 0;
+    if (control == RTS_CTS) return EscapeCommFunction(handle, SETRTS) != 0;
+    return false;
+#else
+    if (control == XON_XOFF) return tcflow(fd, TCION) == 0;
+    if (control == RTS_CTS) {
+        int lineas = TIOCM_RTS;
+        return ioctl(fd, TIOCMBIS, &lineas) == 0;
+    }
+    return false;
+#endif
+}
+
+long long SerialPort::getPausas() const {
+    if (cola == nullptr) return 0;
+    std::lock_guard<std::mutex> g(cola->candado);
+    return cola->pausas;
+}
+
+long long SerialPort::getPerdidos() const {
+    if (cola == nullptr) return 0;
+    std::lock_guard<std::mutex> g(cola->candado);
+    return cola->perdidos;
+}
+
+int SerialPort::getOcupacionMaxima() const {
+    if (cola == nullptr) return 0;
+    std::lock_guard<std::mutex> g(cola->candado);
+    return cola->ocupacionMaxima;
+}
+
 void SerialPort::cerrar() {
+    if (cola != nullptr) {
+        {
+            std::lock_guard<std::mutex> g(cola->candado);
+            cola->terminar = true;
+        }
+        // El hilo sale como mucho tras el timeout de lectura (100 ms, o
+        // enseguida en baja latencia)
+        if (cola->hilo.joinable()) cola->hilo.join();
+        delete cola;
+        cola = nullptr;
+    }
 #ifdef _WIN32
-    if (abierto) {
+    if (handle != INVALID_HANDLE_VALUE) {
         CloseHandle(handle);
         handle = INVALID_HANDLE_VALUE;
-        abierto = false;
+    }
+#else
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
     }
 #endif
+    abierto = false;
 }
 
 bool SerialPort::estaAbierto() const { return abierto; }
 
 bool SerialPort::escribir(const char* data, int len) {
-#ifdef _WIN32
     if (!abierto || data == 0 || len <= 0) return false;
+#ifdef _WIN32
     DWORD escritos = 0;
     if (!WriteFile(handle, data, (DWORD)len, &escritos, 0)) {
         return false;
     }
     return escritos == (DWORD)len;
 #else
-    (void)data; (void)len; return false;
+    int total = 0;
+    while (total < len) {
+        ssize_t n = ::write(fd, data + total, (size_t)(len - total));
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            // Descriptor no bloqueante con el buffer de salida lleno
+            std::this_thread::yield();
+            continue;
+        }
+        if (n <= 0) return false;
+        total += (int)n;
+    }
+    return true;
 #endif
 }
 
 bool SerialPort::escribirLinea(const char* str) {
-#ifdef _WIN32
     if (!abierto || str == 0) return false;
     // Enviar la cadena
     int len = 0; while (str[len] != '\0') len++;
@@ -142,7 +585,4 @@ bool SerialPort::escribirLinea(const char* str) {
     // Enviar salto de linea \n
     const char nl = '\n';
     return escribir(&nl, 1);
-#else
-    (void)str; return false;
-#endif
 }
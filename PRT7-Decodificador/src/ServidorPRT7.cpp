@@ -0,0 +1,306 @@
+/**
+ * @file ServidorPRT7.cpp
+ * @brief Implementacion de la clase ServidorPRT7
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/ServidorPRT7.h"
+#include "../include/DecodificadorPRT7.h"
+#include "../include/EnsambladorLineas.h"
+#include "../include/SalidaCarga.h"
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#endif
+
+/**
+ * @brief Salida que antepone el identificador de la conexion a cada renglon
+ *
+ * Un mensaje largo se entrega en varios lotes y entre ellos pueden
+ * escribir otras sesiones. Si la linea abierta en la salida estandar es de
+ * otra sesion, se termina y el lote empieza un renglon nuevo: "[id] " si
+ * abre el mensaje, "[id]+ " si continua uno ya empezado.
+ */
+class SalidaSesion : public SalidaCarga {
+public:
+    int id;               ///< Identificador de la conexion
+    bool inicioMensaje;   ///< El proximo bloque abre un mensaje nuevo
+    int* lineaAbierta;    ///< Sesion duena del renglon sin terminar (del servidor)
+    
+    SalidaSesion() : id(0), inicioMensaje(true), lineaAbierta(nullptr) {}
+    
+    /**
+     * @brief Empieza un renglon de esta sesion si el abierto es de otra
+     */
+    void tomarRenglon() {
+        if (*lineaAbierta == id) return;
+        if (*lineaAbierta != 0) std::cout << '\n';
+        std::cout << "[" << id << (inicioMensaje ? "] " : "]+ ");
+        *lineaAbierta = id;
+    }
+    
+    void escribir(const char* datos, int longitud) override {
+        tomarRenglon();
+        inicioMensaje = false;
+        std::cout.write(datos, longitud);
+    }
+    
+    void finMensaje() override {
+        tomarRenglon();
+        std::cout << '\n';
+        std::cout.flush();
+        *lineaAbierta = 0;
+        inicioMensaje = true;
+    }
+};
+
+/**
+ * @struct SesionPRT7
+ * @brief Estado de una conexion: descriptor, buffer de linea y decodificador propio
+ */
+struct SesionPRT7 : public ReceptorLineas {
+    int fd;                          ///< Socket de la conexion
+    int id;                          ///< Identificador secuencial de la conexion
+    EnsambladorLineas ensamblador;   ///< Linea parcial entre lecturas
+    DecodificadorPRT7 decodificador; ///< Lista de carga y rotor de esta conexion
+    SalidaSesion salida;             ///< Destino de sus mensajes
+    
+    void lineaCompleta(const char* linea, int longitud) override {
+        // Por el decodificador: muestrea la trama si hay traza
+        decodificador.lineaCompleta(linea, longitud);
+    }
+};
+
+#ifdef __linux__
+static volatile sig_atomic_t paradaSolicitada = 0;
+
+static void manejarSenal(int) {
+    paradaSolicitada = 1;
+}
+#endif
+
+ServidorPRT7::ServidorPRT7()
+    : fdEscucha(-1), fdEpoll(-1), sesiones(nullptr), capacidadSesiones(0),
+      activas(0), totalConexiones(0), ventana(4096), lote(4096), delimitador('\0'), lineaAbierta(0) {
+    rutaUnix[0] = '\0';
+}
+
+ServidorPRT7::~ServidorPRT7() {
+    for (int i = 0; i < capacidadSesiones; i++) {
+        if (sesiones[i] != nullptr) {
+            cerrarSesion(sesiones[i]);
+        }
+    }
+    delete[] sesiones;
+#ifdef __linux__
+    if (fdEscucha >= 0) close(fdEscucha);
+    if (fdEpoll >= 0) close(fdEpoll);
+    if (rutaUnix[0] != '\0') unlink(rutaUnix);
+#endif
+}
+
+void ServidorPRT7::configurarSesiones(int ventanaN, int loteN, char delim) {
+    ventana = ventanaN;
+    lote = loteN;
+    delimitador = delim;
+}
+
+bool ServidorPRT7::escucharUnix(const char* ruta) {
+#ifdef __linux__
+    sockaddr_un direccion;
+    int longitud = 0;
+    while (ruta[longitud] != '\0') longitud++;
+    if (longitud >= (int)sizeof(direccion.sun_path)) return false;
+    
+    fdEscucha = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fdEscucha < 0) return false;
+    
+    direccion.sun_family = AF_UNIX;
+    for (int i = 0; i <= longitud; i++) {
+        direccion.sun_path[i] = ruta[i];
+        rutaUnix[i] = ruta[i];
+    }
+    unlink(ruta);
+    
+    if (bind(fdEscucha, (sockaddr*)&direccion, sizeof(direccion)) < 0) {
+        rutaUnix[0] = '\0';
+        return false;
+    }
+    return prepararEscucha();
+#else
+    (void)ruta;
+    return false;
+#endif
+}
+
+bool ServidorPRT7::escucharTcp(int puerto) {
+#ifdef __linux__
+    fdEscucha = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fdEscucha < 0) return false;
+    
+    int uno = 1;
+    setsockopt(fdEscucha, SOL_SOCKET, SO_REUSEADDR, &uno, sizeof(uno));
+    
+    // Solo loopback: el puente corre en la misma maquina
+    sockaddr_in direccion;
+    direccion.sin_family = AF_INET;
+    direccion.sin_port = htons((unsigned short)puerto);
+    direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    
+    if (bind(fdEscucha, (sockaddr*)&direccion, sizeof(direccion)) < 0) {
+        return false;
+    }
+    return prepararEscucha();
+#else
+    (void)puerto;
+    return false;
+#endif
+}
+
+bool ServidorPRT7::prepararEscucha() {
+#ifdef __linux__
+    if (listen(fdEscucha, SOMAXCONN) < 0) return false;
+    
+    fdEpoll = epoll_create1(EPOLL_CLOEXEC);
+    if (fdEpoll < 0) return false;
+    
+    epoll_event evento;
+    evento.events = EPOLLIN;
+    evento.data.ptr = nullptr; // nullptr identifica al socket de escucha
+    return epoll_ctl(fdEpoll, EPOLL_CTL_ADD, fdEscucha, &evento) == 0;
+#else
+    return false;
+#endif
+}
+
+void ServidorPRT7::ejecutar() {
+#ifdef __linux__
+    if (fdEpoll < 0) return;
+    
+    paradaSolicitada = 0;
+    signal(SIGINT, manejarSenal);
+    signal(SIGTERM, manejarSenal);
+    signal(SIGPIPE, SIG_IGN);
+    
+    const int MAX_EVENTOS = 256;
+    epoll_event eventos[MAX_EVENTOS];
+    
+    while (!paradaSolicitada) {
+        int listos = epoll_wait(fdEpoll, eventos, MAX_EVENTOS, 200);
+        if (listos < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error en epoll_wait." << std::endl;
+            break;
+        }
+        
+        for (int i = 0; i < listos; i++) {
+            SesionPRT7* sesion = (SesionPRT7*)eventos[i].data.ptr;
+            if (sesion == nullptr) {
+                aceptarConexiones();
+            } else {
+                leerSesion(sesion);
+            }
+        }
+    }
+#endif
+}
+
+void ServidorPRT7::aceptarConexiones() {
+#ifdef __linux__
+    while (true) {
+        int fd = accept4(fdEscucha, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "Error al aceptar conexion (errno " << errno << ")." << std::endl;
+            }
+            return;
+        }
+        
+        // Crecer el arreglo de sesiones para que el descriptor sea un indice valido
+        if (fd >= capacidadSesiones) {
+            int nuevaCapacidad = (capacidadSesiones == 0) ? 1024 : capacidadSesiones;
+            while (nuevaCapacidad <= fd) nuevaCapacidad *= 2;
+            SesionPRT7** nuevas = new SesionPRT7*[nuevaCapacidad];
+            for (int i = 0; i < nuevaCapacidad; i++) {
+                nuevas[i] = (i < capacidadSesiones) ? sesiones[i] : nullptr;
+            }
+            delete[] sesiones;
+            sesiones = nuevas;
+            capacidadSesiones = nuevaCapacidad;
+        }
+        
+        SesionPRT7* sesion = new SesionPRT7();
+        sesion->fd = fd;
+        sesion->id = (int)(++totalConexiones);
+        sesion->salida.id = sesion->id;
+        sesion->salida.lineaAbierta = &lineaAbierta;
+        sesion->decodificador.inicializar();
+        sesion->decodificador.configurarVentana(&sesion->salida, ventana, lote);
+        sesion->decodificador.configurarSegmentacion(delimitador, 0);
+        
+        epoll_event evento;
+        evento.events = EPOLLIN | EPOLLRDHUP;
+        evento.data.ptr = sesion;
+        if (epoll_ctl(fdEpoll, EPOLL_CTL_ADD, fd, &evento) < 0) {
+            close(fd);
+            delete sesion;
+            continue;
+        }
+        
+        sesiones[fd] = sesion;
+        activas++;
+    }
+#endif
+}
+
+void ServidorPRT7::leerSesion(SesionPRT7* sesion) {
+#ifdef __linux__
+    char bloque[16384];
+    while (true) {
+        ssize_t leidos = read(sesion->fd, bloque, sizeof(bloque));
+        if (leidos > 0) {
+            sesion->ensamblador.alimentar(bloque, (int)leidos, sesion);
+            continue;
+        }
+        if (leidos < 0 && errno == EINTR) continue;
+        if (leidos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        
+        // Fin de la conexion (0) o error
+        cerrarSesion(sesion);
+        return;
+    }
+#else
+    (void)sesion;
+#endif
+}
+
+void ServidorPRT7::cerrarSesion(SesionPRT7* sesion) {
+#ifdef __linux__
+    sesion->ensamblador.terminar(sesion);
+    sesion->decodificador.finalizar();
+    
+    epoll_ctl(fdEpoll, EPOLL_CTL_DEL, sesion->fd, nullptr);
+    close(sesion->fd);
+    sesiones[sesion->fd] = nullptr;
+    activas--;
+#endif
+    delete sesion;
+}
+
+int ServidorPRT7::getSesionesActivas() const {
+    return activas;
+}
+
+long long ServidorPRT7::getTotalConexiones() const {
+    return totalConexiones;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file SesionAsincrona.cpp
+ * @brief Implementacion de SesionAsincrona y EjecutorCola
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/SesionAsincrona.h"
+
+#if defined(__cpp_impl_coroutine)
+
+// Caracteres que la lista de carga conserva antes de volcarlos a la sesion
+static const int VENTANA_SESION = 256;
+
+EjecutorCola::EjecutorCola() : cola(nullptr), capacidad(0), inicio(0), cantidad(0) {
+}
+
+EjecutorCola::~EjecutorCola() {
+    delete[] cola;
+}
+
+void EjecutorCola::programar(std::coroutine_handle<> h) {
+    // Crecer al doble cuando se llena, conservando el orden
+    if (cantidad == capacidad) {
+        int nuevaCapacidad = (capacidad == 0) ? 64 : capacidad * 2;
+        std::coroutine_handle<>* nueva = new std::coroutine_handle<>[nuevaCapacidad];
+        for (int i = 0; i < cantidad; i++) {
+            nueva[i] = cola[(inicio + i) % capacidad];
+        }
+        delete[] cola;
+        cola = nueva;
+        capacidad = nuevaCapacidad;
+        inicio = 0;
+    }
+    cola[(inicio + cantidad) % capacidad] = h;
+    cantidad++;
+}
+
+long long EjecutorCola::ejecutarPendientes() {
+    long long reanudadas = 0;
+    while (cantidad > 0) {
+        std::coroutine_handle<> h = cola[inicio];
+        inicio = (inicio + 1) % capacidad;
+        cantidad--;
+        h.resume();
+        reanudadas++;
+    }
+    return reanudadas;
+}
+
+int EjecutorCola::getPendientes() const {
+    return cantidad;
+}
+
+SesionAsincrona::SesionAsincrona(EjecutorPRT7* ejecutor, int limitePendientes, char delimitador)
+    : ejecutor(ejecutor), actual(nullptr), longitudActual(0), capacidadActual(0),
+      mensajes(nullptr), longitudes(nullptr), capacidadCola(0), inicioCola(0), cantidadCola(0),
+      limitePendientes(limitePendientes > 0 ? limitePendientes : 1), entregado(nullptr),
+      cerrada(false) {
+    // Una API asincrona no escribe en la consola: ni el arranque ni cada trama
+    decodificador.configurarVerboso(false);
+    decodificador.inicializar();
+    decodificador.configurarVentana(this, VENTANA_SESION, VENTANA_SESION);
+    decodificador.configurarSegmentacion(delimitador, 0);
+}
+
+SesionAsincrona::~SesionAsincrona() {
+    for (int i = 0; i < cantidadCola; i++) {
+        delete[] mensajes[(inicioCola + i) % capacidadCola];
+    }
+    delete[] mensajes;
+    delete[] longitudes;
+    delete[] actual;
+    delete[] entregado;
+}
+
+void SesionAsincrona::reanudar(std::coroutine_handle<>& h) {
+    if (!h) return;
+    // Limpiar antes de reanudar: la corrutina puede volver a suspenderse aqui
+    std::coroutine_handle<> pendiente = h;
+    h = nullptr;
+    if (ejecutor != nullptr) {
+        ejecutor->programar(pendiente);
+    } else {
+        pendiente.resume();
+    }
+}
+
+void SesionAsincrona::procesarBloque(const char* datos, int longitud) {
+    if (!cerrada && datos != nullptr && longitud > 0) {
+        ensamblador.alimentar(datos, longitud, &decodificador);
+    }
+    if (cantidadCola > 0) {
+        reanudar(esperaMensaje);
+    }
+}
+
+SesionAsincrona::EsperaAlimentar SesionAsincrona::alimentar(const char* datos, int longitud) {
+    return EsperaAlimentar{this, datos, longitud};
+}
+
+SesionAsincrona::EsperaMensaje SesionAsincrona::siguienteMensaje() {
+    return EsperaMensaje{this};
+}
+
+MensajeDecodificado SesionAsincrona::tomarMensaje() {
+    delete[] entregado;
+    entregado = nullptr;
+
+    if (cantidadCola == 0) {
+        return MensajeDecodificado{nullptr, 0};
+    }
+
+    entregado = mensajes[inicioCola];
+    MensajeDecodificado m{entregado, longitudes[inicioCola]};
+    inicioCola = (inicioCola + 1) % capacidadCola;
+    cantidadCola--;
+
+    if (cantidadCola < limitePendientes) {
+        reanudar(esperaEspacio);
+    }
+    return m;
+}
+
+void SesionAsincrona::cerrar() {
+    if (cerrada) return;
+    ensamblador.terminar(&decodificador);
+    decodificador.finalizar();
+    cerrada = true;
+    reanudar(esperaMensaje);
+}
+
+void SesionAsincrona::escribir(const char* datos, int longitud) {
+    if (datos == nullptr || longitud <= 0) return;
+
+    if (longitudActual + longitud > capacidadActual) {
+        int nuevaCapacidad = (capacidadActual == 0) ? 64 : capacidadActual * 2;
+        while (nuevaCapacidad < longitudActual + longitud) nuevaCapacidad *= 2;
+        char* nuevo = new char[nuevaCapacidad];
+        for (int i = 0; i < longitudActual; i++) {
+            nuevo[i] = actual[i];
+        }
+        delete[] actual;
+        actual = nuevo;
+        capacidadActual = nuevaCapacidad;
+    }
+    for (int i = 0; i < longitud; i++) {
+        actual[longitudActual++] = datos[i];
+    }
+}
+
+void SesionAsincrona::finMensaje() {
+    // La cola puede superar el limite dentro de un mismo bloque
+    if (cantidadCola == capacidadCola) {
+        int nuevaCapacidad = (capacidadCola == 0) ? 16 : capacidadCola * 2;
+        char** nuevos = new char*[nuevaCapacidad];
+        int* nuevasLongitudes = new int[nuevaCapacidad];
+        for (int i = 0; i < cantidadCola; i++) {
+            nuevos[i] = mensajes[(inicioCola + i) % capacidadCola];
+            nuevasLongitudes[i] = longitudes[(inicioCola + i) % capacidadCola];
+        }
+        delete[] mensajes;
+        delete[] longitudes;
+        mensajes = nuevos;
+        longitudes = nuevasLongitudes;
+        capacidadCola = nuevaCapacidad;
+        inicioCola = 0;
+    }
+
+    // El mensaje se entrega con su propio arreglo ajustado a su longitud
+    char* mensaje = new char[longitudActual > 0 ? longitudActual : 1];
+    for (int i = 0; i < longitudActual; i++) {
+        mensaje[i] = actual[i];
+    }
+    int fin = (inicioCola + cantidadCola) % capacidadCola;
+    mensajes[fin] = mensaje;
+    longitudes[fin] = longitudActual;
+    cantidadCola++;
+    longitudActual = 0;
+}
+
+int SesionAsincrona::getPendientes() const {
+    return cantidadCola;
+}
+
+#endif // __cpp_impl_coroutine
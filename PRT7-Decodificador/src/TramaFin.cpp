@@ -0,0 +1,30 @@
+/**
+ * @file TramaFin.cpp
+ * @brief Implementacion de la clase TramaFin
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/TramaFin.h"
+#include "../include/ListaDeCarga.h"
+#include <iostream>
+
+TramaFin::TramaFin() {
+}
+
+TramaFin::TramaFin(const DatoTrama& dato) {
+    (void)dato;
+}
+
+TramaFin::~TramaFin() {
+}
+
+void TramaFin::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    (void)rotor;
+    
+    if (verboso) {
+        std::cout << "FIN DE MENSAJE." << std::endl;
+    }
+    
+    carga->cerrarMensaje(true);
+}
@@ -10,13 +10,40 @@
 #include "../include/RotorDeMapeo.h"
 #include <iostream>
 
-TramaLoad::TramaLoad(char c) : caracter(c) {
+TramaLoad::TramaLoad(char c) : caracter(c), lote(nullptr), longitudLote(1) {
+}
+
+TramaLoad::TramaLoad(const char* datos, int longitud)
+    : caracter(datos[0]), lote(datos), longitudLote(longitud) {
+}
+
+TramaLoad::TramaLoad(const DatoTrama& dato)
+    : caracter(dato.lote != nullptr ? dato.lote[0] : dato.caracter), lote(dato.lote),
+      longitudLote(dato.lote != nullptr ? dato.longitud : 1) {
 }
 
 TramaLoad::~TramaLoad() {
 }
 
 void TramaLoad::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    if (lote != nullptr) {
+        // Todo el lote se decodifica con el mismo estado del rotor
+        char decodificados[MAX_LOTE];
+        rotor->mapearBloque(lote, longitudLote, decodificados);
+        for (int i = 0; i < longitudLote; i++) {
+            carga->insertarAlFinal(decodificados[i]);
+        }
+        
+        if (verboso) {
+            std::cout << "Lote '";
+            std::cout.write(lote, longitudLote);
+            std::cout << "' decodificado como '";
+            std::cout.write(decodificados, longitudLote);
+            std::cout << "'." << std::endl;
+        }
+        return;
+    }
+    
     // Decodificar el caracter usando el estado actual del rotor
     char caracterDecodificado = rotor->getMapeo(caracter);
     
@@ -24,10 +51,16 @@ void TramaLoad::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
     carga->insertarAlFinal(caracterDecodificado);
     
     // Mostrar informacion de procesamiento
-    std::cout << "Fragmento '" << caracter << "' decodificado como '" 
-              << caracterDecodificado << "'." << std::endl;
+    if (verboso) {
+        std::cout << "Fragmento '" << caracter << "' decodificado como '" 
+                  << caracterDecodificado << "'." << std::endl;
+    }
 }
 
 char TramaLoad::getCaracter() const {
     return caracter;
+}
+
+int TramaLoad::getLongitud() const {
+    return longitudLote;
 }
\ No newline at end of file
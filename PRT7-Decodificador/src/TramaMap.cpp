@@ -12,6 +12,9 @@
 TramaMap::TramaMap(int rot) : rotacion(rot) {
 }
 
+TramaMap::TramaMap(const DatoTrama& dato) : rotacion(dato.entero) {
+}
+
 TramaMap::~TramaMap() {
 }
 
@@ -20,6 +23,7 @@ void TramaMap::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
     rotor->rotar(rotacion);
     
     // Mostrar informacion de procesamiento
+    if (!verboso) return;
     std::cout << "ROTANDO ROTOR ";
     if (rotacion >= 0) {
         std::cout << "+" << rotacion;
@@ -0,0 +1,172 @@
+/**
+ * @file TrazadorPRT7.cpp
+ * @brief Implementacion del trazador de tramos en formato Chrome Trace
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/TrazadorPRT7.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+/**
+ * @struct EventoTraza
+ * @brief Un tramo terminado
+ */
+struct EventoTraza {
+    const char* nombre; ///< Nombre del tramo
+    long long inicio;   ///< Inicio en ns
+    long long fin;      ///< Fin en ns
+};
+
+/**
+ * @struct BufferTraza
+ * @brief Anillo de tramos de un hilo: escribe el hilo, lee volcar()
+ */
+struct BufferTraza {
+    EventoTraza eventos[TrazadorPRT7::EVENTOS_POR_HILO]; ///< Tramos
+    std::atomic<long long> escritos;    ///< Tramos publicados por el hilo
+    std::atomic<long long> leidos;      ///< Tramos ya volcados
+    std::atomic<long long> descartados; ///< Tramos perdidos con el anillo lleno
+    int hilo;                           ///< Identificador para el archivo
+    BufferTraza* siguiente;             ///< Siguiente anillo registrado
+};
+
+static std::atomic<BufferTraza*> listaBuffers(nullptr);
+static std::atomic<int> siguienteHilo(1);
+static std::mutex candadoVolcado;
+static std::ofstream archivoTraza;
+static bool primerEvento = true;
+static long long baseNs = 0;
+
+static std::thread hiloVolcado;
+static std::mutex candadoHilo;
+static std::condition_variable avisoParada;
+static bool pararHilo = false;
+
+/* Al salir del programa: detener el hilo y volcar antes de destruir el archivo */
+static struct ParadaTraza {
+    ~ParadaTraza() { TrazadorPRT7::detener(); }
+} paradaTraza;
+
+/* Hilo de volcado: agrega los tramos pendientes cada PERIODO_VOLCADO_MS */
+static void volcarPeriodicamente() {
+    std::unique_lock<std::mutex> candado(candadoHilo);
+    while (!pararHilo) {
+        avisoParada.wait_for(candado, std::chrono::milliseconds(TrazadorPRT7::PERIODO_VOLCADO_MS));
+        candado.unlock();
+        TrazadorPRT7::volcar();
+        candado.lock();
+    }
+}
+
+long long TrazadorPRT7::ahoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool TrazadorPRT7::activar(const char* ruta, int muestreo) {
+    detener();
+    {
+        std::lock_guard<std::mutex> candado(candadoVolcado);
+        archivoTraza.open(ruta, std::ios::out | std::ios::trunc);
+        if (!archivoTraza.is_open()) return false;
+        
+        // Formato de arreglo: el corchete final es opcional
+        archivoTraza << "[\n";
+        primerEvento = true;
+        baseNs = ahoraNs();
+        periodo = (muestreo > 0) ? muestreo : 1;
+        activo = true;
+    }
+    pararHilo = false;
+    hiloVolcado = std::thread(volcarPeriodicamente);
+    return true;
+}
+
+void TrazadorPRT7::detener() {
+    if (!activo) return;
+    {
+        std::lock_guard<std::mutex> candado(candadoHilo);
+        pararHilo = true;
+    }
+    avisoParada.notify_one();
+    if (hiloVolcado.joinable()) hiloVolcado.join();
+    
+    volcar();
+    std::lock_guard<std::mutex> candado(candadoVolcado);
+    activo = false;
+    archivoTraza.close();
+}
+
+BufferTraza* TrazadorPRT7::bufferDelHilo() {
+    BufferTraza* b = new BufferTraza();
+    b->escritos.store(0, std::memory_order_relaxed);
+    b->leidos.store(0, std::memory_order_relaxed);
+    b->descartados.store(0, std::memory_order_relaxed);
+    b->hilo = siguienteHilo.fetch_add(1, std::memory_order_relaxed);
+    
+    // Publicar al frente de la lista sin candado
+    BufferTraza* cabeza = listaBuffers.load(std::memory_order_relaxed);
+    do {
+        b->siguiente = cabeza;
+    } while (!listaBuffers.compare_exchange_weak(cabeza, b, std::memory_order_release,
+                                                 std::memory_order_relaxed));
+    buffer = b;
+    return b;
+}
+
+void TrazadorPRT7::registrar(const char* nombre, long long inicioNs, long long finNs) {
+    BufferTraza* b = (buffer != nullptr) ? buffer : bufferDelHilo();
+    long long e = b->escritos.load(std::memory_order_relaxed);
+    if (e - b->leidos.load(std::memory_order_acquire) >= EVENTOS_POR_HILO) {
+        b->descartados.store(b->descartados.load(std::memory_order_relaxed) + 1,
+                             std::memory_order_relaxed);
+        return;
+    }
+    EventoTraza& ev = b->eventos[e % EVENTOS_POR_HILO];
+    ev.nombre = nombre;
+    ev.inicio = inicioNs;
+    ev.fin = finNs;
+    b->escritos.store(e + 1, std::memory_order_release);
+}
+
+long long TrazadorPRT7::volcar() {
+    if (!activo) return 0;
+    std::lock_guard<std::mutex> candado(candadoVolcado);
+    if (!archivoTraza.is_open()) return 0;
+    
+    long long total = 0;
+    char linea[256];
+    for (BufferTraza* b = listaBuffers.load(std::memory_order_acquire); b != nullptr; b = b->siguiente) {
+        long long l = b->leidos.load(std::memory_order_relaxed);
+        long long e = b->escritos.load(std::memory_order_acquire);
+        for (; l < e; l++) {
+            const EventoTraza& ev = b->eventos[l % EVENTOS_POR_HILO];
+            // Chrome Trace usa microsegundos; se conservan los nanosegundos como decimales
+            int n = std::snprintf(linea, sizeof(linea),
+                "%s{\"name\":\"%s\",\"cat\":\"prt7\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                primerEvento ? "" : ",\n", ev.nombre,
+                (ev.inicio - baseNs) / 1000.0, (ev.fin - ev.inicio) / 1000.0, b->hilo);
+            archivoTraza.write(linea, n);
+            primerEvento = false;
+            total++;
+        }
+        b->leidos.store(e, std::memory_order_release);
+    }
+    archivoTraza.flush();
+    return total;
+}
+
+long long TrazadorPRT7::getDescartados() {
+    long long total = 0;
+    for (BufferTraza* b = listaBuffers.load(std::memory_order_acquire); b != nullptr; b = b->siguiente) {
+        total += b->descartados.load(std::memory_order_relaxed);
+    }
+    return total;
+}
@@ -0,0 +1,363 @@
+/**
+ * @file VerificadorIntegridad.cpp
+ * @brief Implementacion de VerificadorIntegridad y del CRC32C
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/VerificadorIntegridad.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define PRT7_CRC_X86 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define PRT7_CRC_ARM 1
+#endif
+
+// Polinomio de Castagnoli en forma reflejada
+static const unsigned int POLINOMIO_CRC32C = 0x82F63B78u;
+
+// Tablas para procesar 8 bytes por iteracion sin instrucciones especiales
+static unsigned int tablaCrc[8][256];
+
+static bool prepararTablas() {
+    for (unsigned int i = 0; i < 256; i++) {
+        unsigned int c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? (c >> 1) ^ POLINOMIO_CRC32C : c >> 1;
+        }
+        tablaCrc[0][i] = c;
+    }
+    for (unsigned int i = 0; i < 256; i++) {
+        for (int t = 1; t < 8; t++) {
+            unsigned int previo = tablaCrc[t - 1][i];
+            tablaCrc[t][i] = (previo >> 8) ^ tablaCrc[0][previo & 0xFF];
+        }
+    }
+    return true;
+}
+
+static unsigned int crcTabla(const unsigned char* p, int n, unsigned int c) {
+    while (n >= 8) {
+        unsigned int bajo = c ^ ((unsigned int)p[0] | ((unsigned int)p[1] << 8) |
+                                 ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24));
+        c = tablaCrc[7][bajo & 0xFF] ^ tablaCrc[6][(bajo >> 8) & 0xFF] ^
+            tablaCrc[5][(bajo >> 16) & 0xFF] ^ tablaCrc[4][bajo >> 24] ^
+            tablaCrc[3][p[4]] ^ tablaCrc[2][p[5]] ^ tablaCrc[1][p[6]] ^ tablaCrc[0][p[7]];
+        p += 8;
+        n -= 8;
+    }
+    while (n-- > 0) {
+        c = (c >> 8) ^ tablaCrc[0][(c ^ *p++) & 0xFF];
+    }
+    return c;
+}
+
+#if defined(PRT7_CRC_X86)
+__attribute__((target("sse4.2")))
+static unsigned int crcHardware(const unsigned char* p, int n, unsigned int c) {
+#if defined(__x86_64__)
+    unsigned long long c64 = c;
+    while (n >= 8) {
+        unsigned long long v;
+        std::memcpy(&v, p, 8);
+        c64 = _mm_crc32_u64(c64, v);
+        p += 8;
+        n -= 8;
+    }
+    c = (unsigned int)c64;
+#endif
+    // Cola de 0 a 7 bytes en a lo sumo tres instrucciones
+    if (n >= 4) {
+        unsigned int v;
+        std::memcpy(&v, p, 4);
+        c = _mm_crc32_u32(c, v);
+        p += 4;
+        n -= 4;
+    }
+    if (n >= 2) {
+        unsigned short v;
+        std::memcpy(&v, p, 2);
+        c = _mm_crc32_u16(c, v);
+        p += 2;
+        n -= 2;
+    }
+    if (n > 0) {
+        c = _mm_crc32_u8(c, *p);
+    }
+    return c;
+}
+#elif defined(PRT7_CRC_ARM)
+static unsigned int crcHardware(const unsigned char* p, int n, unsigned int c) {
+    while (n >= 8) {
+        unsigned long long v;
+        std::memcpy(&v, p, 8);
+        c = __crc32cd(c, v);
+        p += 8;
+        n -= 8;
+    }
+    if (n >= 4) {
+        unsigned int v;
+        std::memcpy(&v, p, 4);
+        c = __crc32cw(c, v);
+        p += 4;
+        n -= 4;
+    }
+    if (n >= 2) {
+        unsigned short v;
+        std::memcpy(&v, p, 2);
+        c = __crc32ch(c, v);
+        p += 2;
+        n -= 2;
+    }
+    if (n > 0) {
+        c = __crc32cb(c, *p);
+    }
+    return c;
+}
+#endif
+
+typedef unsigned int (*FuncionCrc)(const unsigned char*, int, unsigned int);
+
+static FuncionCrc elegirFuncionCrc() {
+    prepararTablas();
+#if defined(PRT7_CRC_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) return crcHardware;
+#elif defined(PRT7_CRC_ARM)
+    return crcHardware;
+#endif
+    return crcTabla;
+}
+
+static const FuncionCrc funcionCrc = elegirFuncionCrc();
+
+unsigned int VerificadorIntegridad::crc32c(const char* datos, int longitud, unsigned int crc) {
+    return ~funcionCrc((const unsigned char*)datos, longitud, ~crc);
+}
+
+bool VerificadorIntegridad::usaHardware() {
+    return funcionCrc != crcTabla;
+}
+
+VerificadorIntegridad::VerificadorIntegridad()
+    : exigir(false), primera(true), ultima(0), validas(0), corruptas(0),
+      duplicadas(0), sinSufijo(0), huecos(0), perdidas(0),
+      textoEsperado(0), mascaraEsperada(0), digitosEsperados(0) {
+}
+
+void VerificadorIntegridad::setExigir(bool exigirSufijo) {
+    exigir = exigirSufijo;
+}
+
+bool VerificadorIntegridad::getExigir() const {
+    return exigir;
+}
+
+// Valor de cada digito hexadecimal; -1 para cualquier otro byte
+static signed char tablaHex[256];
+
+static bool prepararTablaHex() {
+    for (int i = 0; i < 256; i++) tablaHex[i] = -1;
+    for (int i = 0; i < 10; i++) tablaHex['0' + i] = (signed char)i;
+    for (int i = 0; i < 6; i++) {
+        tablaHex['a' + i] = (signed char)(10 + i);
+        tablaHex['A' + i] = (signed char)(10 + i);
+    }
+    return true;
+}
+
+static const bool tablaHexLista = prepararTablaHex();
+
+/**
+ * Los 8 digitos hexadecimales en minuscula de un CRC, en el orden en que
+ * quedan en memoria al leer el sufijo como un entero de 64 bits
+ */
+static unsigned long long hexMinuscula(unsigned int crc) {
+    // Un nibble por byte, el menos significativo en el byte 0
+    unsigned long long x = crc;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+    // '0' + v, mas 39 para llegar a 'a' cuando v > 9
+    unsigned long long letras = ((x + 0x0606060606060606ull) >> 4) & 0x0101010101010101ull;
+    x += 0x3030303030303030ull + letras * 39;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return x;
+#elif defined(__GNUC__) || defined(__clang__)
+    // El digito mas significativo va primero en el texto
+    return __builtin_bswap64(x);
+#else
+    unsigned long long texto = 0;
+    for (int i = 0; i < 8; i++) texto |= ((x >> (8 * i)) & 0xFF) << (8 * (7 - i));
+    return texto;
+#endif
+}
+
+void VerificadorIntegridad::prepararEsperada(unsigned int siguiente) {
+    mascaraEsperada = 0;
+    textoEsperado = 0;
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__
+    if (siguiente == 0 || siguiente > 9999999u) return;
+    // Los digitos ocupan los bytes altos, el ultimo en el byte 7, y el '*'
+    // queda justo antes
+    int byte = 7;
+    do {
+        textoEsperado |= (unsigned long long)('0' + siguiente % 10) << (8 * byte);
+        siguiente /= 10;
+        byte--;
+    } while (siguiente > 0);
+    textoEsperado |= (unsigned long long)'*' << (8 * byte);
+    digitosEsperados = 7 - byte;
+    mascaraEsperada = ~0ull << (8 * byte);
+#else
+    (void)siguiente;
+#endif
+}
+
+VerificadorIntegridad::Resultado VerificadorIntegridad::verificar(const char* linea, int longitud,
+                                                                  int& longitudCuerpo) {
+    longitudCuerpo = longitud;
+    (void)tablaHexLista;
+    
+    // Ignorar espacios finales
+    int fin = longitud;
+    while (fin > 0 && (linea[fin - 1] == ' ' || linea[fin - 1] == '\t' || linea[fin - 1] == '\r')) fin--;
+    
+    // Solo hay sufijo si la linea termina exactamente en
+    // "*<digitos>*<8 hex>": un '*' en otra posicion es parte de la carga
+    // ("L,*", "L*3,A*B") y la trama pasa como SIN_SUFIJO
+    int k2 = fin - 9;
+    if (k2 < 2 || linea[k2] != '*') {
+        sinSufijo++;
+        return SIN_SUFIJO;
+    }
+    
+    // Secuencia: lo normal es que sea la siguiente a la ultima, y eso se
+    // compara con los 8 bytes anteriores al CRC de una vez; si no, se
+    // leen los digitos decimales hacia atras hasta el '*' que la abre
+    unsigned long long secuencia = 0;
+    int k1 = k2 - 1;
+    bool siguiente = false;
+    if (mascaraEsperada != 0 && k2 >= 8) {
+        unsigned long long w;
+        std::memcpy(&w, linea + k2 - 8, 8);
+        siguiente = (w & mascaraEsperada) == textoEsperado;
+    }
+    if (siguiente) {
+        k1 = k2 - digitosEsperados - 1;
+    } else {
+        unsigned long long peso = 1;
+        while (k1 >= 0 && linea[k1] >= '0' && linea[k1] <= '9' && k2 - k1 <= 10) {
+            secuencia += (unsigned long long)(linea[k1] - '0') * peso;
+            peso *= 10;
+            k1--;
+        }
+        if (k1 < 0 || linea[k1] != '*' || k2 - k1 == 1) {
+            sinSufijo++;
+            return SIN_SUFIJO;
+        }
+        if (secuencia > 0xFFFFFFFFull) {
+            corruptas++;
+            return CORRUPTA;
+        }
+    }
+    
+    // CRC: lo normal es que coincida con el calculado escrito en minuscula,
+    // y eso tambien se compara de una vez; si no, se decodifican los 8
+    // digitos (mayusculas o CRC distinto), donde cualquier byte que no sea
+    // hexadecimal deja un bit de signo y la linea no tiene sufijo
+    unsigned int calculado = crc32c(linea, k2);
+    unsigned long long texto;
+    std::memcpy(&texto, linea + k2 + 1, 8);
+    if (texto != hexMinuscula(calculado)) {
+        const unsigned char* hex = (const unsigned char*)linea + k2 + 1;
+        int invalidos = 0;
+        unsigned int recibido = 0;
+        for (int i = 0; i < 8; i++) {
+            int v = tablaHex[hex[i]];
+            invalidos |= v;
+            recibido = (recibido << 4) | (unsigned int)(v & 0xF);
+        }
+        if (invalidos < 0) {
+            sinSufijo++;
+            return SIN_SUFIJO;
+        }
+        if (calculado != recibido) {
+            corruptas++;
+            return CORRUPTA;
+        }
+    }
+    
+    if (siguiente) {
+        // Incrementar el texto esperado; solo un 9 final obliga a rehacerlo
+        ultima++;
+        if ((textoEsperado >> 56) != '9') {
+            textoEsperado += 1ull << 56;
+        } else {
+            prepararEsperada(ultima + 1);
+        }
+        validas++;
+        longitudCuerpo = k1;
+        return VALIDA;
+    }
+    
+    // Secuencia: 0 reinicia la cuenta (emisor reiniciado)
+    unsigned int s = (unsigned int)secuencia;
+    if (!primera && s != 0) {
+        unsigned int esperada = ultima + 1;
+        if (s < esperada) {
+            duplicadas++;
+            return DUPLICADA;
+        }
+        if (s > esperada) {
+            huecos++;
+            perdidas += (long long)(s - esperada);
+        }
+    }
+    primera = false;
+    ultima = s;
+    prepararEsperada(s + 1);
+    validas++;
+    longitudCuerpo = k1;
+    return VALIDA;
+}
+
+bool VerificadorIntegridad::aceptar(Resultado r) const {
+    return r == VALIDA || (r == SIN_SUFIJO && !exigir);
+}
+
+int VerificadorIntegridad::escribirSufijo(const char* cuerpo, int longitud, unsigned int secuencia, char* destino) {
+    // "*<secuencia>"
+    char digitos[10];
+    int n = 0;
+    do {
+        digitos[n++] = (char)('0' + secuencia % 10);
+        secuencia /= 10;
+    } while (secuencia > 0);
+    
+    int escritos = 0;
+    destino[escritos++] = '*';
+    while (n > 0) {
+        destino[escritos++] = digitos[--n];
+    }
+    
+    // El CRC cubre el cuerpo y la secuencia
+    unsigned int crc = crc32c(destino, escritos, crc32c(cuerpo, longitud));
+    
+    static const char HEX[] = "0123456789abcdef";
+    destino[escritos++] = '*';
+    for (int desplazamiento = 28; desplazamiento >= 0; desplazamiento -= 4) {
+        destino[escritos++] = HEX[(crc >> desplazamiento) & 0xF];
+    }
+    return escritos;
+}
+
+long long VerificadorIntegridad::getValidas() const { return validas; }
+long long VerificadorIntegridad::getCorruptas() const { return corruptas; }
+long long VerificadorIntegridad::getDuplicadas() const { return duplicadas; }
+long long VerificadorIntegridad::getSinSufijo() const { return sinSufijo; }
+long long VerificadorIntegridad::getHuecos() const { return huecos; }
+long long VerificadorIntegridad::getPerdidas() const { return perdidas; }
@@ -0,0 +1,210 @@
+/**
+ * @file VigilantePatrones.cpp
+ * @brief Implementacion del automata Aho-Corasick VigilantePatrones
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/VigilantePatrones.h"
+#include <iostream>
+#include <fstream>
+#include <limits>
+
+void AlertaConsola::patronEncontrado(int id, const char* patron, long long posicionFinal) {
+    std::cerr << "ALERTA: patron #" << id << " '" << patron
+              << "' detectado en la posicion " << posicionFinal << std::endl;
+}
+
+VigilantePatrones::VigilantePatrones()
+    : patrones(nullptr), numPatrones(0), capacidadPatrones(0), numClases(1),
+      transiciones(nullptr), salida(nullptr), enlaceSalida(nullptr), numEstados(0),
+      estado(0), posicion(0), observador(nullptr) {
+    for (int i = 0; i < 256; i++) {
+        clase[i] = 0;
+    }
+}
+
+VigilantePatrones::~VigilantePatrones() {
+    liberarAutomata();
+    for (int i = 0; i < numPatrones; i++) {
+        delete[] patrones[i];
+    }
+    delete[] patrones;
+}
+
+void VigilantePatrones::liberarAutomata() {
+    delete[] transiciones;
+    delete[] salida;
+    delete[] enlaceSalida;
+    transiciones = nullptr;
+    salida = nullptr;
+    enlaceSalida = nullptr;
+    numEstados = 0;
+}
+
+int VigilantePatrones::agregarPatron(const char* patron) {
+    if (patron == nullptr || patron[0] == '\0') return -1;
+
+    // Crecer el arreglo de patrones al doble cuando se llena
+    if (numPatrones == capacidadPatrones) {
+        int nuevaCapacidad = (capacidadPatrones == 0) ? 16 : capacidadPatrones * 2;
+        char** nuevos = new char*[nuevaCapacidad];
+        for (int i = 0; i < numPatrones; i++) {
+            nuevos[i] = patrones[i];
+        }
+        delete[] patrones;
+        patrones = nuevos;
+        capacidadPatrones = nuevaCapacidad;
+    }
+
+    int longitud = 0;
+    while (patron[longitud] != '\0') longitud++;
+
+    char* copia = new char[longitud + 1];
+    for (int i = 0; i <= longitud; i++) {
+        copia[i] = patron[i];
+    }
+    patrones[numPatrones] = copia;
+    return numPatrones++;
+}
+
+int VigilantePatrones::cargarArchivo(const char* ruta) {
+    std::ifstream archivo(ruta);
+    if (!archivo.is_open()) return -1;
+
+    int cargados = 0;
+    char linea[256];
+    while (true) {
+        archivo.getline(linea, sizeof(linea));
+        if (archivo.fail()) {
+            if (archivo.eof()) break;
+            // Linea mas larga que el buffer: se descarta completa
+            archivo.clear();
+            archivo.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            continue;
+        }
+        int fin = 0;
+        while (linea[fin] != '\0') fin++;
+        if (fin > 0 && linea[fin - 1] == '\r') linea[fin - 1] = '\0';
+
+        if (agregarPatron(linea) >= 0) cargados++;
+        if (archivo.eof()) break;
+    }
+    return cargados;
+}
+
+bool VigilantePatrones::construir() {
+    liberarAutomata();
+    if (numPatrones == 0) return false;
+
+    // Asignar una clase a cada byte que aparece en algun patron
+    for (int i = 0; i < 256; i++) {
+        clase[i] = 0;
+    }
+    numClases = 1;
+    int totalCaracteres = 0;
+    for (int p = 0; p < numPatrones; p++) {
+        for (int i = 0; patrones[p][i] != '\0'; i++) {
+            unsigned char b = (unsigned char)patrones[p][i];
+            if (clase[b] == 0) {
+                clase[b] = numClases++;
+            }
+            totalCaracteres++;
+        }
+    }
+
+    int maxEstados = totalCaracteres + 1;
+    transiciones = new int[maxEstados * numClases];
+    salida = new int[maxEstados];
+    enlaceSalida = new int[maxEstados];
+    for (int i = 0; i < maxEstados * numClases; i++) transiciones[i] = -1;
+    for (int i = 0; i < maxEstados; i++) {
+        salida[i] = -1;
+        enlaceSalida[i] = -1;
+    }
+    numEstados = 1;
+
+    // Insertar cada patron en el trie
+    for (int p = 0; p < numPatrones; p++) {
+        int actual = 0;
+        for (int i = 0; patrones[p][i] != '\0'; i++) {
+            int k = clase[(unsigned char)patrones[p][i]];
+            int& destino = transiciones[actual * numClases + k];
+            if (destino == -1) {
+                destino = numEstados++;
+            }
+            actual = destino;
+        }
+        // Un patron repetido conserva el primer identificador
+        if (salida[actual] == -1) {
+            salida[actual] = p;
+        }
+    }
+
+    // Recorrido por niveles para calcular enlaces de fallo y completar la tabla
+    int* fallo = new int[numEstados];
+    int* cola = new int[numEstados];
+    int inicio = 0, fin = 0;
+
+    for (int k = 0; k < numClases; k++) {
+        int& t = transiciones[k];
+        if (t == -1) {
+            t = 0;
+        } else {
+            fallo[t] = 0;
+            cola[fin++] = t;
+        }
+    }
+
+    while (inicio < fin) {
+        int s = cola[inicio++];
+        for (int k = 0; k < numClases; k++) {
+            int& t = transiciones[s * numClases + k];
+            int porFallo = transiciones[fallo[s] * numClases + k];
+            if (t == -1) {
+                t = porFallo;
+            } else {
+                fallo[t] = porFallo;
+                enlaceSalida[t] = (salida[porFallo] != -1) ? porFallo : enlaceSalida[porFallo];
+                cola[fin++] = t;
+            }
+        }
+    }
+
+    delete[] fallo;
+    delete[] cola;
+
+    estado = 0;
+    return true;
+}
+
+void VigilantePatrones::avanzar(char c) {
+    if (transiciones != nullptr) {
+        estado = transiciones[estado * numClases + clase[(unsigned char)c]];
+
+        if (observador != nullptr) {
+            int s = (salida[estado] != -1) ? estado : enlaceSalida[estado];
+            while (s != -1) {
+                observador->patronEncontrado(salida[s], patrones[salida[s]], posicion);
+                s = enlaceSalida[s];
+            }
+        }
+    }
+    posicion++;
+}
+
+void VigilantePatrones::reiniciar() {
+    estado = 0;
+}
+
+void VigilantePatrones::setObservador(ObservadorPatrones* obs) {
+    observador = obs;
+}
+
+int VigilantePatrones::getNumPatrones() const {
+    return numPatrones;
+}
+
+int VigilantePatrones::getNumEstados() const {
+    return numEstados;
+}
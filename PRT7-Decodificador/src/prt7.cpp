@@ -0,0 +1,135 @@
+/**
+ * @file prt7.cpp
+ * @brief Implementacion de la API en C de libprt7 sobre DecodificadorPRT7
+ * @author Sistema de Decodificacion PRT-7
+ * @date 2025-11-06
+ */
+
+#include "../include/prt7.h"
+#include "../include/DecodificadorPRT7.h"
+#include "../include/EnsambladorLineas.h"
+#include "../include/SalidaCarga.h"
+
+#ifndef PROJECT_VERSION
+#define PROJECT_VERSION "1.0.0"
+#endif
+
+// Ventana y lote por defecto de cada decodificador
+static const int VENTANA_PREDETERMINADA = 256;
+
+/**
+ * @struct prt7_decodificador
+ * @brief Decodificador con su ensamblador de lineas y la funcion de salida del anfitrion
+ */
+struct prt7_decodificador : public SalidaCarga, public ReceptorLineas {
+    DecodificadorPRT7 decodificador;   ///< Decodificador interno
+    EnsambladorLineas ensamblador;     ///< Lineas de los bytes alimentados
+    prt7_funcion_salida funcion;       ///< Funcion de salida del anfitrion
+    void* contexto;                    ///< Contexto de la funcion de salida
+    int validas;                       ///< Tramas validas en la llamada actual
+
+    prt7_decodificador() : funcion(nullptr), contexto(nullptr), validas(0) {}
+
+    void escribir(const char* datos, int longitud) override {
+        if (funcion != nullptr) funcion(contexto, datos, longitud, 0);
+    }
+
+    void finMensaje() override {
+        if (funcion != nullptr) funcion(contexto, nullptr, 0, 1);
+    }
+
+    void lineaCompleta(const char* linea, int longitud) override {
+        if (decodificador.procesarLinea(linea, longitud)) validas++;
+    }
+};
+
+const char* prt7_version(void) {
+    return PROJECT_VERSION;
+}
+
+prt7_decodificador* prt7_crear(void) {
+    try {
+        prt7_decodificador* d = new prt7_decodificador();
+        // La biblioteca nunca escribe en la consola del anfitrion; sin tocar
+        // el modo global, que otros hilos pueden estar leyendo
+        d->decodificador.configurarVerboso(false);
+        if (!d->decodificador.inicializar()) {
+            delete d;
+            return nullptr;
+        }
+        d->decodificador.configurarVentana(d, VENTANA_PREDETERMINADA, VENTANA_PREDETERMINADA);
+        return d;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void prt7_destruir(prt7_decodificador* d) {
+    delete d;
+}
+
+int prt7_configurar_salida(prt7_decodificador* d, prt7_funcion_salida funcion, void* contexto) {
+    if (d == nullptr) return PRT7_ERROR_ARGUMENTO;
+    d->funcion = funcion;
+    d->contexto = contexto;
+    return PRT7_OK;
+}
+
+int prt7_configurar(prt7_decodificador* d, int ventana, int lote, char delimitador) {
+    if (d == nullptr) return PRT7_ERROR_ARGUMENTO;
+    d->decodificador.configurarVentana(d, ventana > 0 ? ventana : 1, lote > 0 ? lote : 1);
+    d->decodificador.configurarSegmentacion(delimitador, 0);
+    return PRT7_OK;
+}
+
+int prt7_alimentar(prt7_decodificador* d, const char* datos, int longitud) {
+    if (d == nullptr || (datos == nullptr && longitud > 0) || longitud < 0) return PRT7_ERROR_ARGUMENTO;
+    try {
+        d->validas = 0;
+        d->ensamblador.alimentar(datos, longitud, d);
+        return d->validas;
+    } catch (...) {
+        return PRT7_ERROR_INTERNO;
+    }
+}
+
+int prt7_procesar_trama(prt7_decodificador* d, const char* trama, int longitud) {
+    if (d == nullptr || trama == nullptr || longitud < 0) return PRT7_ERROR_ARGUMENTO;
+
+    // Las tramas validas son cortas; una mas larga que la linea se ignora
+    if (longitud > EnsambladorLineas::CAPACIDAD) return 0;
+
+    try {
+        return d->decodificador.procesarLinea(trama, longitud) ? 1 : 0;
+    } catch (...) {
+        return PRT7_ERROR_INTERNO;
+    }
+}
+
+char prt7_decodificar_caracter(prt7_decodificador* d, char c) {
+    if (d == nullptr) return c;
+    return d->decodificador.mapearCaracter(c);
+}
+
+int prt7_desplazamiento(const prt7_decodificador* d) {
+    if (d == nullptr) return PRT7_ERROR_ARGUMENTO;
+    return d->decodificador.getDesplazamiento();
+}
+
+int prt7_reiniciar(prt7_decodificador* d) {
+    if (d == nullptr) return PRT7_ERROR_ARGUMENTO;
+    d->ensamblador = EnsambladorLineas();
+    d->decodificador.reiniciar();
+    return PRT7_OK;
+}
+
+int prt7_cerrar(prt7_decodificador* d) {
+    if (d == nullptr) return PRT7_ERROR_ARGUMENTO;
+    try {
+        d->ensamblador.terminar(d);
+        d->decodificador.cerrarMensaje();
+        return PRT7_OK;
+    } catch (...) {
+        return PRT7_ERROR_INTERNO;
+    }
+}